@@ -0,0 +1,976 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : BoardSim (host)                                Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Virtual board for deadline and jitter analysis on a PC.     */
+/*                                                                           */
+/*               Time runs in core cycles. TIM2 (TIM2_Config()) triggers     */
+/*               every sample: the DAC outputs its holding register and its  */
+/*               DMA stream loads the next sample, AdcCycles later the ADC   */
+/*               DMA streams write the converted samples. Each stream        */
+/*               counts its transfers, the memory target (DMA_TARGET())      */
+/*               toggles every BlockSize transfers. The DAC streams load     */
+/*               one sample at start, so they run one transfer ahead of the  */
+/*               ADC streams (as ProcessBuffer() expects for BLOCK_SIZE 1).  */
+/*                                                                           */
+/*               The core runs one handler at a time: the DMA and TIM2       */
+/*               interrupts share priority 0 and are taken in the order of   */
+/*               their IRQ numbers, PendSV runs when none is pending and is  */
+/*               preempted by them. The four DMA handlers rendezvous as in   */
+/*               stm32f4xx_it.c, the last one calls ProcessBuffer() with     */
+/*               its synchronisation check. The processing is charged the    */
+/*               cycles of the cost model (or measured on target), either    */
+/*               in that interrupt or deferred to PendSV with the deadline   */
+/*               check of ProcessDeferred().                                 */
+/*                                                                           */
+/*               The output of a block is written to its transmit buffers    */
+/*               when its cycles are spent. The DAC reads it two block       */
+/*               periods after the input started, a sample read before is    */
+/*               an underrun (the DAC repeats old output).                   */
+/*                                                                           */
+/*               The sample path is functional: the processing callback      */
+/*               gets the real buffers and the input callback sees the DAC   */
+/*               outputs, so a loopback can be measured end to end.          */
+/*                                                                           */
+/*  Procedures : BoardSim_defaults()                                         */
+/*               BoardSim_run()                                              */
+/*               BoardSim_print()                                            */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : BoardSim.c                                                  */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "BoardSim.h"
+#include "config.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* module constant declaration */
+
+/* DMA streams (transfer counters) */
+#define SIM_ADC1 0
+#define SIM_ADC2 1
+#define SIM_DAC1 2
+#define SIM_DAC2 3
+#define SIM_STREAMS 4
+
+/* Interrupts in the order of their IRQ numbers (DMA1_Stream5 16,   */
+/* DMA1_Stream6 17, TIM2 28, DMA2_Stream0 56, DMA2_Stream2 58), all */
+/* at priority 0                                                    */
+#define SIM_IRQ_DAC1 0
+#define SIM_IRQ_DAC2 1
+#define SIM_IRQ_TIM2 2
+#define SIM_IRQ_ADC1 3
+#define SIM_IRQ_ADC2 4
+#define SIM_IRQS 5
+
+/* module type declaration */
+
+/* Block selected by ProcessBuffer() */
+typedef struct
+{
+	uint8_t Target;           /* DMA_TARGET() of ADC1 at selection        */
+	uint8_t Parity;           /* Buffers used, 0 = _a, 1 = _b             */
+	int64_t Id;               /* Input block number                       */
+	uint64_t Time;            /* Rendezvous [cycles]                      */
+} SimBlock;
+
+/* State of the board */
+typedef struct
+{
+	const BoardSimConfig *pConfig;
+	BoardSimReport *pReport;
+	uint32_t B;
+	uint64_t TickNum;         /* Cycles of a sample: TickNum / TickDen    */
+	uint64_t TickDen;
+	uint64_t Now;
+	uint64_t Busy;
+	uint64_t Count[SIM_STREAMS];
+	int16_t *pRx[BOARD_SIM_CHANNELS][2];
+	int16_t *pTx[BOARD_SIM_CHANNELS][2];
+	int16_t *pOut[BOARD_SIM_CHANNELS];
+	int64_t TxBlock[2];       /* Block in the transmit buffers            */
+	int64_t UnderrunLast;     /* Last block counted as underrun           */
+	int16_t Dhr[BOARD_SIM_CHANNELS];
+	int16_t Dac[BOARD_SIM_CHANNELS];
+	uint8_t Ready[SIM_STREAMS];
+	uint8_t IrqPending[SIM_IRQS];
+	uint64_t IrqTime[SIM_IRQS];
+	int Isr;                  /* Active interrupt, -1 if none             */
+	uint64_t IsrEnd;
+	uint8_t IsrWrite;         /* Block done at the end of the interrupt   */
+	uint8_t PendSvPending;
+	uint8_t PendSvActive;
+	uint64_t PendSvLeft;
+	uint8_t PendSvWrite;
+	SimBlock Next;            /* NextBlock of DSPMain.c                   */
+	uint8_t BlockPending;
+	uint8_t BlockRunning;
+	SimBlock Work;            /* Block being processed                    */
+	uint32_t Rand;
+	double ResponseSum;
+} BoardSim;
+
+/* module data declaration */
+
+/* module procedure declaration */
+static uint64_t Sim_time(const BoardSim *S, uint64_t Tick);
+static uint8_t Sim_target(const BoardSim *S, uint32_t Stream);
+static uint8_t Sim_near(const BoardSim *S, uint32_t Stream);
+static uint32_t Sim_cost(BoardSim *S);
+static void Sim_raise(BoardSim *S, uint32_t Irq);
+static void Sim_advance(BoardSim *S, uint64_t To);
+static uint64_t Sim_isr(BoardSim *S, uint32_t Irq);
+static uint64_t Sim_buffer(BoardSim *S);
+static uint64_t Sim_deferred(BoardSim *S);
+static void Sim_start(BoardSim *S, const SimBlock *pBlock);
+static void Sim_finish(BoardSim *S);
+static void Sim_dac(BoardSim *S, uint32_t Channel);
+static void Sim_adc(BoardSim *S, uint32_t Channel, uint64_t Tick);
+
+/*****************************************************************************/
+/*  Procedure   : BoardSim_defaults                                          */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Fills a configuration with the settings of config.h and a  */
+/*                cost model of the Q15 canceller                            */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : pConfig    Configuration                                   */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void BoardSim_defaults(BoardSimConfig *pConfig) {
+
+	/* procedure code */
+	memset(pConfig, 0, sizeof(*pConfig));
+	pConfig->Fs = FS;
+	pConfig->BlockSize = BLOCK_SIZE;
+	pConfig->FilterLength = 1700;
+	pConfig->CoreClock = 168000000;
+	pConfig->TimerClock = SYSCLK;
+	pConfig->Deferred = PROCESS_DEFERRED;
+	pConfig->HalfBuffer = DMA_HALF_BUFFER;
+
+	/* Filter and update of arm_lms_q15() from SRAM, per tap and sample */
+	pConfig->CyclesPerTap = 1.25;
+	pConfig->CostFixed = 600;
+	pConfig->CostJitter = 0.02;
+
+	/* ADC: 15 cycles at 21MHz. Interrupt: 12 cycles entry, 10 exit */
+	pConfig->AdcCycles = 120;
+	pConfig->IsrCycles = 60;
+	pConfig->BufferCycles = 120;
+	pConfig->Tim2Cycles = 40;
+	pConfig->PendSvCycles = 80;
+	pConfig->Seconds = 10.0;
+	pConfig->Seed = 1;
+}
+/*****************************************************************************/
+/*  End         : BoardSim_defaults                                          */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : BoardSim_run                                               */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Runs the board for pConfig->Seconds, or until the          */
+/*                synchronisation of the buffers is lost (FatalError())      */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : pConfig    Configuration                                   */
+/*                                                                           */
+/*  Output Para : pReport    Results                                         */
+/*                Return     0, -1 if the configuration is invalid           */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+int BoardSim_run(const BoardSimConfig *pConfig, BoardSimReport *pReport) {
+
+	/* procedure data */
+	BoardSim *S;
+	uint32_t Period;
+	uint64_t Ticks;
+	uint64_t n;
+	uint32_t c;
+	uint32_t p;
+
+	/* procedure code */
+	memset(pReport, 0, sizeof(*pReport));
+	if ((pConfig->Fs == 0) || (pConfig->BlockSize == 0) ||
+			(pConfig->TimerClock == 0) || (pConfig->CoreClock == 0)) {
+		return -1;
+	}
+
+	/* TIM2 divides by TIM_Period + 1 */
+	Period = (pConfig->TimerClock + pConfig->Fs / 2u) / pConfig->Fs;
+	pReport->FsActual = (double) pConfig->TimerClock / (Period + 1u);
+	Ticks = (uint64_t) (pConfig->Seconds * pReport->FsActual);
+
+	S = (BoardSim *) calloc(1, sizeof(BoardSim));
+	if (S == 0) {
+		return -1;
+	}
+	S->pConfig = pConfig;
+	S->pReport = pReport;
+	S->B = pConfig->BlockSize;
+	S->TickNum = (uint64_t) (Period + 1u) * pConfig->CoreClock;
+	S->TickDen = pConfig->TimerClock;
+	if (pConfig->AdcCycles >= Sim_time(S, 1)) {
+		free(S);
+		return -1;
+	}
+	for (c = 0; c < BOARD_SIM_CHANNELS; c++) {
+		for (p = 0; p < 2; p++) {
+			S->pRx[c][p] = (int16_t *) calloc(S->B, sizeof(int16_t));
+			S->pTx[c][p] = (int16_t *) calloc(S->B, sizeof(int16_t));
+		}
+		S->pOut[c] = (int16_t *) calloc(S->B, sizeof(int16_t));
+	}
+	S->TxBlock[0] = -1;
+	S->TxBlock[1] = -1;
+	S->UnderrunLast = -1;
+	S->Isr = -1;
+	S->Rand = pConfig->Seed;
+	pReport->ResponseMin = UINT64_MAX;
+	pReport->SlackMin = INT64_MAX;
+
+	/* The DAC streams load their first sample when enabled */
+	for (c = 0; c < BOARD_SIM_CHANNELS; c++) {
+		Sim_dac(S, c);
+	}
+
+	for (n = 0; (n < Ticks) && !pReport->SyncLost; n++) {
+
+		/* TIM2 update: DAC output and next DAC sample */
+		Sim_advance(S, Sim_time(S, n));
+		for (c = 0; c < BOARD_SIM_CHANNELS; c++) {
+			S->Dac[c] = S->Dhr[c];
+		}
+		if (pConfig->Output != 0) {
+			pConfig->Output(pConfig->pUser, n, S->Dac);
+		}
+		for (c = 0; c < BOARD_SIM_CHANNELS; c++) {
+			Sim_dac(S, c);
+		}
+		if (pConfig->Tim2Cycles != 0) {
+			Sim_raise(S, SIM_IRQ_TIM2);
+		}
+
+		/* End of the conversion: ADC samples to memory */
+		Sim_advance(S, Sim_time(S, n) + pConfig->AdcCycles);
+		for (c = 0; c < BOARD_SIM_CHANNELS; c++) {
+			Sim_adc(S, c, n);
+		}
+	}
+	Sim_advance(S, Sim_time(S, n));
+
+	pReport->Ticks = n;
+	if (pReport->ResponseMin == UINT64_MAX) {
+		pReport->ResponseMin = 0;
+	}
+	if (pReport->SlackMin == INT64_MAX) {
+		pReport->SlackMin = 0;
+	}
+	if (pReport->Processed != 0) {
+		pReport->ResponseMean = S->ResponseSum / pReport->Processed;
+	}
+	if (S->Now != 0) {
+		pReport->Load = (double) S->Busy / S->Now;
+	}
+
+	for (c = 0; c < BOARD_SIM_CHANNELS; c++) {
+		for (p = 0; p < 2; p++) {
+			free(S->pRx[c][p]);
+			free(S->pTx[c][p]);
+		}
+		free(S->pOut[c]);
+	}
+	free(S);
+	return 0;
+}
+/*****************************************************************************/
+/*  End         : BoardSim_run                                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : BoardSim_print                                             */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Prints configuration and results, times in microseconds    */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : pFile      Output file                                     */
+/*                pConfig    Configuration                                   */
+/*                pReport    Results of BoardSim_run()                       */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void BoardSim_print(FILE *pFile, const BoardSimConfig *pConfig,
+		const BoardSimReport *pReport) {
+
+	/* procedure data */
+	double us = pConfig->CoreClock / 1e6;
+	double Period = pConfig->BlockSize * 1e6 / pReport->FsActual;
+
+	/* procedure code */
+	fprintf(pFile, "Fs %u Hz (TIM2 %.1f Hz), block %u, %u taps, %s, %s\n",
+			pConfig->Fs, pReport->FsActual, pConfig->BlockSize,
+			pConfig->FilterLength,
+			pConfig->Deferred ? "deferred (PendSV)" : "in the DMA interrupt",
+			pConfig->HalfBuffer ? "half buffer DMA" : "double buffer DMA");
+	fprintf(pFile, "Simulated       %llu samples, %llu blocks, load %.1f %%\n",
+			(unsigned long long) pReport->Ticks,
+			(unsigned long long) pReport->Blocks, 100.0 * pReport->Load);
+	fprintf(pFile, "Processed       %llu, skipped %llu\n",
+			(unsigned long long) pReport->Processed,
+			(unsigned long long) pReport->Skipped);
+	fprintf(pFile, "Deadline misses %llu\n",
+			(unsigned long long) pReport->DeadlineMisses);
+	fprintf(pFile, "Underruns       %llu blocks, %llu samples\n",
+			(unsigned long long) pReport->UnderrunBlocks,
+			(unsigned long long) pReport->UnderrunSamples);
+	fprintf(pFile, "Response        min %.2f, mean %.2f, max %.2f us "
+			"(block period %.2f us)\n", pReport->ResponseMin / us,
+			pReport->ResponseMean / us, pReport->ResponseMax / us, Period);
+	fprintf(pFile, "Output jitter   %.2f us, minimum slack %.2f us\n",
+			(pReport->ResponseMax - pReport->ResponseMin) / us,
+			pReport->SlackMin / us);
+	fprintf(pFile, "IRQ latency     max %.2f us\n",
+			pReport->IrqLatencyMax / us);
+	if (pReport->SyncLost) {
+		fprintf(pFile, "FatalError: buffers asynchronous, stopped\n");
+	}
+}
+/*****************************************************************************/
+/*  End         : BoardSim_print                                             */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Sim_time                                                   */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Time of a TIM2 update                                      */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Board                                           */
+/*                Tick       Sample number                                   */
+/*                                                                           */
+/*  Output Para : Return     Core cycles since start                         */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint64_t Sim_time(const BoardSim *S, uint64_t Tick) {
+
+	/* procedure code */
+	return Tick * S->TickNum / S->TickDen;
+}
+/*****************************************************************************/
+/*  End         : Sim_time                                                   */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Sim_target                                                 */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : DMA_TARGET() of a stream. For the half buffer mode the     */
+/*                half given by the counter is the same.                     */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Board                                           */
+/*                Stream     SIM_ADC1 ... SIM_DAC2                           */
+/*                                                                           */
+/*  Output Para : Return     Memory target 0 or 1                            */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint8_t Sim_target(const BoardSim *S, uint32_t Stream) {
+
+	/* procedure code */
+	return (uint8_t) ((S->Count[Stream] / S->B) & 1u);
+}
+/*****************************************************************************/
+/*  End         : Sim_target                                                 */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Sim_near                                                   */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : DMA_NEAR() of the half buffer mode: the stream is at most  */
+/*                one sample apart from ADC1 in the circular buffer          */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Board                                           */
+/*                Stream     SIM_ADC1 ... SIM_DAC2                           */
+/*                                                                           */
+/*  Output Para : Return     1 if near, else 0                               */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint8_t Sim_near(const BoardSim *S, uint32_t Stream) {
+
+	/* procedure data */
+	uint64_t Length = 2 * (uint64_t) S->B;
+	uint64_t Position = S->Count[Stream] % Length;
+	uint64_t Adc = S->Count[SIM_ADC1] % Length;
+
+	/* procedure code */
+	return (uint8_t) ((Position + Length + 1 - Adc) % Length <= 2);
+}
+/*****************************************************************************/
+/*  End         : Sim_near                                                   */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Sim_cost                                                   */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Cycles of the next block: callback, measured or model,     */
+/*                with random variation                                      */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Board                                           */
+/*                                                                           */
+/*  Output Para : Return     Cycles                                          */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint32_t Sim_cost(BoardSim *S) {
+
+	/* procedure data */
+	const BoardSimConfig *pConfig = S->pConfig;
+	double Cost;
+	double Random;
+
+	/* procedure code */
+	if (pConfig->Cost != 0) {
+		Cost = pConfig->Cost(pConfig->pUser, S->B);
+	} else if (pConfig->CostMeasured != 0) {
+		Cost = pConfig->CostMeasured;
+	} else {
+		Cost = pConfig->CostFixed +
+				pConfig->CyclesPerTap * pConfig->FilterLength * S->B;
+	}
+
+	/* Uniform in [-1, 1) */
+	S->Rand = S->Rand * 1664525u + 1013904223u;
+	Random = (double) S->Rand / 2147483648.0 - 1.0;
+	Cost *= 1.0 + pConfig->CostJitter * Random;
+	return (Cost > 0.0) ? (uint32_t) Cost : 0;
+}
+/*****************************************************************************/
+/*  End         : Sim_cost                                                   */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Sim_raise                                                  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Sets an interrupt pending, a second request before the     */
+/*                handler runs is lost as in the NVIC                        */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Board                                           */
+/*                Irq        SIM_IRQ_xxx                                     */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Sim_raise(BoardSim *S, uint32_t Irq) {
+
+	/* procedure code */
+	if (!S->IrqPending[Irq]) {
+		S->IrqPending[Irq] = 1;
+		S->IrqTime[Irq] = S->Now;
+	}
+}
+/*****************************************************************************/
+/*  End         : Sim_raise                                                  */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Sim_advance                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Runs the core up to a time: interrupts first, then         */
+/*                PendSV, else idle                                          */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Board                                           */
+/*                To         Time of the next hardware event                 */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Sim_advance(BoardSim *S, uint64_t To) {
+
+	/* procedure data */
+	uint64_t Step;
+	uint64_t Latency;
+	uint32_t Irq;
+
+	/* procedure code */
+	while (S->Now < To) {
+
+		/* Handler running */
+		if (S->Isr >= 0) {
+			Step = (S->IsrEnd < To) ? S->IsrEnd - S->Now : To - S->Now;
+			S->Busy += Step;
+			S->Now += Step;
+			if (S->Now == S->IsrEnd) {
+				if (S->IsrWrite) {
+					S->IsrWrite = 0;
+					Sim_finish(S);
+				}
+				S->Isr = -1;
+			}
+			continue;
+		}
+
+		/* Pending interrupt, lowest number first */
+		for (Irq = 0; (Irq < SIM_IRQS) && !S->IrqPending[Irq]; Irq++) {
+		}
+		if (Irq < SIM_IRQS) {
+			S->IrqPending[Irq] = 0;
+			if (Irq != SIM_IRQ_TIM2) {
+				Latency = S->Now - S->IrqTime[Irq];
+				if (Latency > S->pReport->IrqLatencyMax) {
+					S->pReport->IrqLatencyMax = Latency;
+				}
+			}
+			S->Isr = (int) Irq;
+			S->IsrEnd = S->Now + Sim_isr(S, Irq);
+			continue;
+		}
+
+		/* PendSV, preempted by the next interrupt */
+		if (!S->PendSvActive && S->PendSvPending) {
+			S->PendSvPending = 0;
+			S->PendSvActive = 1;
+			S->PendSvLeft = Sim_deferred(S);
+		}
+		if (S->PendSvActive) {
+			Step = (S->PendSvLeft < To - S->Now) ? S->PendSvLeft : To - S->Now;
+			S->Busy += Step;
+			S->Now += Step;
+			S->PendSvLeft -= Step;
+			if (S->PendSvLeft == 0) {
+				if (S->PendSvWrite) {
+					S->PendSvWrite = 0;
+					Sim_finish(S);
+				}
+				S->BlockRunning = 0;
+				S->PendSvActive = 0;
+			}
+			continue;
+		}
+
+		/* Idle */
+		S->Now = To;
+	}
+}
+/*****************************************************************************/
+/*  End         : Sim_advance                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Sim_isr                                                    */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Enters an interrupt handler: the DMA handlers mark their   */
+/*                stream ready and the last of the four calls                */
+/*                ProcessBuffer()                                            */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Board                                           */
+/*                Irq        SIM_IRQ_xxx                                     */
+/*                                                                           */
+/*  Output Para : Return     Cycles of the handler                           */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint64_t Sim_isr(BoardSim *S, uint32_t Irq) {
+
+	/* procedure data */
+	uint32_t Stream;
+
+	/* procedure code */
+	switch (Irq) {
+	case SIM_IRQ_TIM2:
+		return S->pConfig->Tim2Cycles;
+	case SIM_IRQ_DAC1:
+		Stream = SIM_DAC1;
+		break;
+	case SIM_IRQ_DAC2:
+		Stream = SIM_DAC2;
+		break;
+	case SIM_IRQ_ADC1:
+		Stream = SIM_ADC1;
+		break;
+	default:
+		Stream = SIM_ADC2;
+		break;
+	}
+
+	S->Ready[Stream] = 1;
+	if (S->Ready[SIM_ADC1] && S->Ready[SIM_ADC2] && S->Ready[SIM_DAC1] &&
+			S->Ready[SIM_DAC2]) {
+		memset(S->Ready, 0, sizeof(S->Ready));
+		return S->pConfig->IsrCycles + Sim_buffer(S);
+	}
+	return S->pConfig->IsrCycles;
+}
+/*****************************************************************************/
+/*  End         : Sim_isr                                                    */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Sim_buffer                                                 */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : ProcessBuffer(): synchronisation check, selects the        */
+/*                buffers and processes them or pends PendSV                 */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Board                                           */
+/*                                                                           */
+/*  Output Para : Return     Cycles added to the interrupt                   */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint64_t Sim_buffer(BoardSim *S) {
+
+	/* procedure data */
+	uint8_t Buffer1 = Sim_target(S, SIM_ADC1);
+	uint8_t Buffer2 = Sim_target(S, SIM_ADC2);
+	uint8_t Buffer3 = Sim_target(S, SIM_DAC1);
+	uint8_t Buffer4 = Sim_target(S, SIM_DAC2);
+	SimBlock Block;
+	int64_t Id;
+
+	/* procedure code */
+	if (S->pConfig->HalfBuffer) {
+		S->pReport->SyncLost |= (Buffer1 != Buffer2) ||
+				!Sim_near(S, SIM_DAC1) || !Sim_near(S, SIM_DAC2);
+	} else if (S->B == 1) {
+		S->pReport->SyncLost |= (Buffer1 != Buffer2) || (Buffer1 == Buffer3) ||
+				(Buffer1 == Buffer4);
+	} else {
+		S->pReport->SyncLost |= (Buffer1 != Buffer2) || (Buffer1 != Buffer3) ||
+				(Buffer1 != Buffer4);
+	}
+	if (S->pReport->SyncLost) {
+		return 0;
+	}
+	S->pReport->Blocks++;
+
+	/* The buffers the ADC has left, newest block in them */
+	Block.Target = Buffer1;
+	Block.Parity = (Buffer1 == 1) ? 0 : 1;
+	Id = (int64_t) (S->Count[SIM_ADC1] / S->B) - 1;
+	if ((Id & 1) != Block.Parity) {
+		Id--;
+	}
+	Block.Id = Id;
+	Block.Time = S->Now;
+
+	if (S->pConfig->Deferred) {
+		if (S->BlockPending || S->BlockRunning) {
+			S->pReport->DeadlineMisses++;
+		}
+		S->Next = Block;
+		S->BlockPending = 1;
+		S->PendSvPending = 1;
+		return S->pConfig->BufferCycles;
+	}
+
+	Sim_start(S, &Block);
+	S->IsrWrite = 1;
+	return S->pConfig->BufferCycles + Sim_cost(S);
+}
+/*****************************************************************************/
+/*  End         : Sim_buffer                                                 */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Sim_deferred                                               */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Enters PendSV: ProcessDeferred() takes the block and       */
+/*                skips it if the DMA has already moved on                   */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Board                                           */
+/*                                                                           */
+/*  Output Para : Return     Cycles of the handler                           */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint64_t Sim_deferred(BoardSim *S) {
+
+	/* procedure code */
+	if (!S->BlockPending) {
+		return S->pConfig->PendSvCycles;
+	}
+	S->BlockPending = 0;
+	S->BlockRunning = 1;
+
+	if (Sim_target(S, SIM_ADC1) != S->Next.Target) {
+		S->pReport->DeadlineMisses++;
+		S->pReport->Skipped++;
+		return S->pConfig->PendSvCycles;
+	}
+	Sim_start(S, &S->Next);
+	S->PendSvWrite = 1;
+	return S->pConfig->PendSvCycles + Sim_cost(S);
+}
+/*****************************************************************************/
+/*  End         : Sim_deferred                                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Sim_start                                                  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Processes a block into the output scratch, it becomes      */
+/*                visible to the DAC with Sim_finish()                       */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Board                                           */
+/*                pBlock     Block to process                                */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Sim_start(BoardSim *S, const SimBlock *pBlock) {
+
+	/* procedure data */
+	const BoardSimConfig *pConfig = S->pConfig;
+	uint32_t p = pBlock->Parity;
+
+	/* procedure code */
+	S->Work = *pBlock;
+	if (pConfig->Process != 0) {
+		pConfig->Process(pConfig->pUser, S->pRx[0][p], S->pRx[1][p],
+				S->pOut[0], S->pOut[1], S->B);
+	} else {
+		memcpy(S->pOut[0], S->pRx[0][p], S->B * sizeof(int16_t));
+		memcpy(S->pOut[1], S->pRx[1][p], S->B * sizeof(int16_t));
+	}
+}
+/*****************************************************************************/
+/*  End         : Sim_start                                                  */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Sim_finish                                                 */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Writes the output of the block being processed to its      */
+/*                transmit buffers, response time and slack to the DAC       */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Board                                           */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Sim_finish(BoardSim *S) {
+
+	/* procedure data */
+	BoardSimReport *pReport = S->pReport;
+	uint32_t p = S->Work.Parity;
+	uint64_t Response = S->Now - S->Work.Time;
+	uint64_t Deadline;
+	int64_t Slack;
+
+	/* procedure code */
+	memcpy(S->pTx[0][p], S->pOut[0], S->B * sizeof(int16_t));
+	memcpy(S->pTx[1][p], S->pOut[1], S->B * sizeof(int16_t));
+	S->TxBlock[p] = S->Work.Id;
+	pReport->Processed++;
+
+	/* The DAC loads the first sample at the update before its output */
+	Deadline = Sim_time(S, (uint64_t) (S->Work.Id + 2) * S->B - 1u);
+	Slack = (int64_t) Deadline - (int64_t) S->Now;
+	if (Slack < pReport->SlackMin) {
+		pReport->SlackMin = Slack;
+	}
+	if (Response < pReport->ResponseMin) {
+		pReport->ResponseMin = Response;
+	}
+	if (Response > pReport->ResponseMax) {
+		pReport->ResponseMax = Response;
+	}
+	S->ResponseSum += (double) Response;
+}
+/*****************************************************************************/
+/*  End         : Sim_finish                                                 */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Sim_dac                                                    */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : One transfer of a DAC stream into the holding register,    */
+/*                checks that the block it reads is written                  */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Board                                           */
+/*                Channel    0 or 1                                          */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Sim_dac(BoardSim *S, uint32_t Channel) {
+
+	/* procedure data */
+	uint32_t Stream = SIM_DAC1 + Channel;
+	uint64_t Count = S->Count[Stream];
+	uint32_t p = (uint32_t) ((Count / S->B) & 1u);
+	int64_t Expected = (int64_t) (Count / S->B) - 2;
+
+	/* procedure code */
+	if ((Channel == 0) && (Expected >= 0) && (S->TxBlock[p] != Expected)) {
+		S->pReport->UnderrunSamples++;
+		if (S->UnderrunLast != Expected) {
+			S->UnderrunLast = Expected;
+			S->pReport->UnderrunBlocks++;
+		}
+	}
+	S->Dhr[Channel] = S->pTx[Channel][p][Count % S->B];
+	S->Count[Stream] = ++Count;
+	if ((Count % S->B) == 0) {
+		Sim_raise(S, SIM_IRQ_DAC1 + Channel);
+	}
+}
+/*****************************************************************************/
+/*  End         : Sim_dac                                                    */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Sim_adc                                                    */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : One transfer of an ADC stream, the sample comes from the   */
+/*                input callback                                             */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Board                                           */
+/*                Channel    0 or 1                                          */
+/*                Tick       Sample number                                   */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Sim_adc(BoardSim *S, uint32_t Channel, uint64_t Tick) {
+
+	/* procedure data */
+	const BoardSimConfig *pConfig = S->pConfig;
+	uint32_t Stream = SIM_ADC1 + Channel;
+	uint64_t Count = S->Count[Stream];
+	uint32_t p = (uint32_t) ((Count / S->B) & 1u);
+	int16_t Sample = 0;
+
+	/* procedure code */
+	if (pConfig->Input != 0) {
+		Sample = pConfig->Input(pConfig->pUser, Channel, Tick, S->Dac);
+	}
+	S->pRx[Channel][p][Count % S->B] = Sample;
+	S->Count[Stream] = ++Count;
+	if ((Count % S->B) == 0) {
+		Sim_raise(S, SIM_IRQ_ADC1 + Channel);
+	}
+}
+/*****************************************************************************/
+/*  End         : Sim_adc                                                    */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : BoardSim                                                   */
+/*****************************************************************************/
@@ -0,0 +1,115 @@
+#ifndef BOARDSIM_H
+#define BOARDSIM_H
+/*****************************************************************************/
+/*  Header     : BoardSim (host)                                Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Sample accurate model of the board timing on a PC: TIM2     */
+/*               sample clock, double buffered ADC and DAC DMA streams, the  */
+/*               four DMA interrupts with their rendezvous, ProcessBuffer()  */
+/*               and the deferred processing in PendSV, with a cycle cost    */
+/*               per block                                                   */
+/*                                                                           */
+/*  Procedures : BoardSim_defaults()                                         */
+/*               BoardSim_run()                                              */
+/*               BoardSim_print()                                            */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : BoardSim.h                                                  */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include <stdint.h>
+#include <stdio.h>
+
+/* module constant declaration  */
+
+/* Channels of the board (ADC1/DAC1 and ADC2/DAC2) */
+#define BOARD_SIM_CHANNELS 2
+
+/* module type declaration      */
+
+/* Processing of one block, Q15 samples [blockSize] per channel */
+typedef void (*BoardSimProcess)(void *pUser, int16_t *pIn1, int16_t *pIn2,
+		int16_t *pOut1, int16_t *pOut2, uint32_t blockSize);
+
+/* Cycles of the next block (cost model), 0 = BoardSim default */
+typedef uint32_t (*BoardSimCost)(void *pUser, uint32_t blockSize);
+
+/* ADC sample of a channel at sample Tick, pDac holds the DAC outputs */
+/* of the same tick (for a loopback)                                  */
+typedef int16_t (*BoardSimInput)(void *pUser, uint32_t Channel,
+		uint64_t Tick, const int16_t *pDac);
+
+/* DAC outputs at sample Tick */
+typedef void (*BoardSimOutput)(void *pUser, uint64_t Tick,
+		const int16_t *pDac);
+
+/* Configuration, see BoardSim_defaults() */
+typedef struct
+{
+	uint32_t Fs;              /* Required sampling frequency [Hz]         */
+	uint32_t BlockSize;       /* Samples per block                        */
+	uint32_t FilterLength;    /* Taps for the default cost model          */
+	uint32_t CoreClock;       /* Core clock [Hz]                          */
+	uint32_t TimerClock;      /* Clock of TIM2 [Hz] (SYSCLK of config.h)  */
+	uint8_t Deferred;         /* PROCESS_DEFERRED                         */
+	uint8_t HalfBuffer;       /* DMA_HALF_BUFFER                          */
+	double CyclesPerTap;      /* Cycles per tap and sample                */
+	uint32_t CostFixed;       /* Cycles per block besides the taps        */
+	uint32_t CostMeasured;    /* Cycles per block measured on target      */
+	                          /* (ProcessCycles), replaces the model      */
+	double CostJitter;        /* Random variation of the cost [0 ... 1]   */
+	uint32_t AdcCycles;       /* Trigger to ADC DMA write                 */
+	uint32_t IsrCycles;       /* One DMA interrupt, entry and exit        */
+	uint32_t BufferCycles;    /* ProcessBuffer() in the last interrupt    */
+	uint32_t Tim2Cycles;      /* TIM2 interrupt, 0 if disabled            */
+	uint32_t PendSvCycles;    /* PendSV entry, exit and ProcessDeferred() */
+	double Seconds;           /* Simulated time                           */
+	uint32_t Seed;            /* Seed of the cost jitter                  */
+	BoardSimProcess Process;  /* 0: outputs are the inputs                */
+	BoardSimCost Cost;        /* 0: model above                           */
+	BoardSimInput Input;      /* 0: silence                               */
+	BoardSimOutput Output;    /* 0: none                                  */
+	void *pUser;              /* Passed to the callbacks                  */
+} BoardSimConfig;
+
+/* Results */
+typedef struct
+{
+	double FsActual;          /* Sampling frequency of TIM2 [Hz]          */
+	uint64_t Ticks;           /* Samples simulated                        */
+	uint64_t Blocks;          /* Rendezvous of the four interrupts        */
+	uint64_t Processed;       /* Blocks processed                         */
+	uint64_t Skipped;         /* Blocks skipped by ProcessDeferred()      */
+	uint64_t DeadlineMisses;  /* As DeadlineMisses of DSPMain.c           */
+	uint64_t UnderrunBlocks;  /* Output blocks not ready for the DAC      */
+	uint64_t UnderrunSamples; /* DAC samples of such blocks               */
+	uint8_t SyncLost;         /* FatalError(): buffers asynchronous       */
+	uint64_t ResponseMin;     /* Rendezvous to output written [cycles]    */
+	uint64_t ResponseMax;
+	double ResponseMean;
+	int64_t SlackMin;         /* Output written to its first DAC read     */
+	uint64_t IrqLatencyMax;   /* DMA request to start of its interrupt    */
+	double Load;              /* Busy share of the core                   */
+} BoardSimReport;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+void BoardSim_defaults(BoardSimConfig *pConfig);
+int BoardSim_run(const BoardSimConfig *pConfig, BoardSimReport *pReport);
+void BoardSim_print(FILE *pFile, const BoardSimConfig *pConfig,
+		const BoardSimReport *pReport);
+
+/*****************************************************************************/
+/*  End Header  : BoardSim                                                   */
+/*****************************************************************************/
+#endif
@@ -0,0 +1,233 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : BoardSimMain (host)                            Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Command line of the virtual board (BoardSim.c) for          */
+/*               capacity planning. Runs every combination of the given      */
+/*               sampling frequencies, block sizes and filter lengths, one   */
+/*               report each, or one table line each with -table.            */
+/*                                                                           */
+/*               Build (from this directory):                                */
+/*               gcc -O2 -I../src -o boardsim BoardSim.c BoardSimMain.c      */
+/*                                                                           */
+/*               Example:                                                    */
+/*               ./boardsim -fs 8000,16000 -block 1,8,32 -taps 1700 -cpt 1.3 */
+/*                                                                           */
+/*               Options (defaults from config.h and BoardSim_defaults()):   */
+/*               -fs, -block, -taps  Lists, separated by commas              */
+/*               -deferred 0|1       PROCESS_DEFERRED                        */
+/*               -half 0|1           DMA_HALF_BUFFER                         */
+/*               -cpt c              Cycles per tap and sample (CyclesPerTap */
+/*                                   of the target)                          */
+/*               -fixed c            Cycles per block besides the taps       */
+/*               -cycles c           Cycles per block measured on target     */
+/*                                   (ProcessCycles), replaces the model     */
+/*               -jitter f           Random variation of the cost (0.02)     */
+/*               -tim2 c             Cycles of the TIM2 interrupt, 0 = off   */
+/*               -seconds s          Simulated time                          */
+/*               -seed n             Seed of the variation                   */
+/*               -table              One line per combination                */
+/*                                                                           */
+/*               The exit code is 1 if any combination misses a deadline,    */
+/*               underruns or loses the synchronisation.                     */
+/*                                                                           */
+/*  Procedures : main()                                                      */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : BoardSimMain.c                                              */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "BoardSim.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* module constant declaration */
+
+/* Values of a list option */
+#define SIM_LIST_MAX 16
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+static uint32_t Main_list(const char *pText, uint32_t *pValues);
+
+/*****************************************************************************/
+/*  Procedure   : main                                                       */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Parses the options and runs the board                      */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : argc, argv Options, see module header                      */
+/*                                                                           */
+/*  Output Para : Return     0 if all combinations meet their deadlines      */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+int main(int argc, char *argv[]) {
+
+	/* procedure data */
+	BoardSimConfig Config;
+	BoardSimReport Report;
+	uint32_t Fs[SIM_LIST_MAX];
+	uint32_t Block[SIM_LIST_MAX];
+	uint32_t Taps[SIM_LIST_MAX];
+	uint32_t numFs;
+	uint32_t numBlock;
+	uint32_t numTaps;
+	uint32_t i, j, k;
+	int Table = 0;
+	int Failed = 0;
+	int a;
+
+	/* procedure code */
+	BoardSim_defaults(&Config);
+	Fs[0] = Config.Fs;
+	Block[0] = Config.BlockSize;
+	Taps[0] = Config.FilterLength;
+	numFs = numBlock = numTaps = 1;
+
+	for (a = 1; a < argc; a++) {
+		if (strcmp(argv[a], "-table") == 0) {
+			Table = 1;
+		} else if (a + 1 >= argc) {
+			fprintf(stderr, "Missing value of %s\n", argv[a]);
+			return 2;
+		} else if (strcmp(argv[a], "-fs") == 0) {
+			numFs = Main_list(argv[++a], Fs);
+		} else if (strcmp(argv[a], "-block") == 0) {
+			numBlock = Main_list(argv[++a], Block);
+		} else if (strcmp(argv[a], "-taps") == 0) {
+			numTaps = Main_list(argv[++a], Taps);
+		} else if (strcmp(argv[a], "-deferred") == 0) {
+			Config.Deferred = (uint8_t) atoi(argv[++a]);
+		} else if (strcmp(argv[a], "-half") == 0) {
+			Config.HalfBuffer = (uint8_t) atoi(argv[++a]);
+		} else if (strcmp(argv[a], "-cpt") == 0) {
+			Config.CyclesPerTap = atof(argv[++a]);
+		} else if (strcmp(argv[a], "-fixed") == 0) {
+			Config.CostFixed = (uint32_t) atol(argv[++a]);
+		} else if (strcmp(argv[a], "-cycles") == 0) {
+			Config.CostMeasured = (uint32_t) atol(argv[++a]);
+		} else if (strcmp(argv[a], "-jitter") == 0) {
+			Config.CostJitter = atof(argv[++a]);
+		} else if (strcmp(argv[a], "-tim2") == 0) {
+			Config.Tim2Cycles = (uint32_t) atol(argv[++a]);
+		} else if (strcmp(argv[a], "-seconds") == 0) {
+			Config.Seconds = atof(argv[++a]);
+		} else if (strcmp(argv[a], "-seed") == 0) {
+			Config.Seed = (uint32_t) atol(argv[++a]);
+		} else {
+			fprintf(stderr, "Unknown option %s\n", argv[a]);
+			return 2;
+		}
+	}
+	if ((numFs == 0) || (numBlock == 0) || (numTaps == 0)) {
+		fprintf(stderr, "Empty list\n");
+		return 2;
+	}
+
+	if (Table) {
+		printf("     Fs  Block   Taps  Load%%  Misses  Underruns  "
+				"Resp.max/us  Jitter/us  Slack/us\n");
+	}
+	for (i = 0; i < numFs; i++) {
+		for (j = 0; j < numBlock; j++) {
+			for (k = 0; k < numTaps; k++) {
+				Config.Fs = Fs[i];
+				Config.BlockSize = Block[j];
+				Config.FilterLength = Taps[k];
+				if (BoardSim_run(&Config, &Report) != 0) {
+					fprintf(stderr, "Invalid configuration Fs %u, block %u\n",
+							Fs[i], Block[j]);
+					return 2;
+				}
+				if (Report.DeadlineMisses || Report.UnderrunSamples ||
+						Report.SyncLost) {
+					Failed = 1;
+				}
+				if (Table) {
+					printf("%7u %6u %6u %6.1f %7llu %10llu %12.2f %10.2f "
+							"%9.2f%s\n", Fs[i], Block[j], Taps[k],
+							100.0 * Report.Load,
+							(unsigned long long) Report.DeadlineMisses,
+							(unsigned long long) Report.UnderrunSamples,
+							Report.ResponseMax / (Config.CoreClock / 1e6),
+							(Report.ResponseMax - Report.ResponseMin) /
+									(Config.CoreClock / 1e6),
+							Report.SlackMin / (Config.CoreClock / 1e6),
+							Report.SyncLost ? "  FatalError" : "");
+				} else {
+					BoardSim_print(stdout, &Config, &Report);
+					printf("\n");
+				}
+			}
+		}
+	}
+	return Failed;
+}
+/*****************************************************************************/
+/*  End         : main                                                       */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Main_list                                                  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Parses a list of numbers separated by commas               */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pText      List                                            */
+/*                                                                           */
+/*  Output Para : pValues    Values [SIM_LIST_MAX]                           */
+/*                Return     Number of values                                */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint32_t Main_list(const char *pText, uint32_t *pValues) {
+
+	/* procedure data */
+	uint32_t Count = 0;
+	char *pEnd;
+
+	/* procedure code */
+	while ((*pText != '\0') && (Count < SIM_LIST_MAX)) {
+		pValues[Count] = (uint32_t) strtoul(pText, &pEnd, 10);
+		if ((pEnd == pText) || (pValues[Count] == 0)) {
+			return 0;
+		}
+		Count++;
+		pText = (*pEnd == ',') ? pEnd + 1 : pEnd;
+		if ((*pEnd != ',') && (*pEnd != '\0')) {
+			return 0;
+		}
+	}
+	return Count;
+}
+/*****************************************************************************/
+/*  End         : Main_list                                                  */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : BoardSimMain                                               */
+/*****************************************************************************/
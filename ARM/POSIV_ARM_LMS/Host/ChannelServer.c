@@ -0,0 +1,819 @@
+/* general control */
+#define _GNU_SOURCE
+
+/*****************************************************************************/
+/*  Module     : ChannelServer (host)                           Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Echo canceller of many channels with a pool of pthreads.    */
+/*                                                                           */
+/*               The producer pushes one frame per channel into the input    */
+/*               queues and announces them with ChannelServer_tick(). On a   */
+/*               new tick every worker puts the ready channels of its home   */
+/*               share (channel % workers) into its own deque and works it   */
+/*               from the bottom; an idle worker steals from the top of the  */
+/*               other deques. The Busy flag keeps a channel in at most one  */
+/*               deque, so its canceller runs on one worker at a time and    */
+/*               the queues stay single producer, single consumer. A job     */
+/*               runs all frames queued for its channel.                     */
+/*                                                                           */
+/*               The queues and deques are lock-free (C11 atomics), the      */
+/*               workers nap for SERVER_NAP when idle for SERVER_SPIN loops. */
+/*                                                                           */
+/*  Procedures : ChannelServer_init()                                        */
+/*               ChannelServer_start()                                       */
+/*               ChannelServer_push()                                        */
+/*               ChannelServer_tick()                                        */
+/*               ChannelServer_pop()                                         */
+/*               ChannelServer_stop()                                        */
+/*               ChannelServer_free()                                        */
+/*               ChannelServer_now()                                         */
+/*               Server_worker()                                             */
+/*               Server_schedule()                                           */
+/*               Server_steal()                                              */
+/*               Server_channel()                                            */
+/*               Server_push()                                               */
+/*               Server_take()                                               */
+/*               Server_pull()                                               */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : ChannelServer.c                                             */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "ChannelServer.h"
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* module constant declaration */
+
+/* Idle loops of a worker before it naps */
+#define SERVER_SPIN 256
+
+/* Nap of an idle worker [ns] */
+#define SERVER_NAP 20000
+
+/* Deque empty, or a steal lost against another thief */
+#define SERVER_EMPTY (-1)
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+static void *Server_worker(void *pArg);
+static void Server_schedule(ChannelServer *S, ServerWorker *pWorker);
+static int64_t Server_steal(ChannelServer *S, ServerWorker *pWorker);
+static void Server_channel(ChannelServer *S, ServerWorker *pWorker,
+		uint32_t Channel);
+static void Server_push(ServerDeque *pDeque, uint32_t Channel);
+static int64_t Server_take(ServerDeque *pDeque);
+static int64_t Server_pull(ServerDeque *pDeque);
+
+/*****************************************************************************/
+/*  Procedure   : ChannelServer_init                                         */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Allocates the channels and workers, resets the cancellers  */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Server to initialize                            */
+/*                pConfig    Configuration                                   */
+/*                                                                           */
+/*  Output Para : Return     0, or -1 if the configuration is invalid or     */
+/*                           out of memory (S is freed again)                */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+int ChannelServer_init(ChannelServer *S, const ChannelServerConfig *pConfig) {
+
+	/* procedure data */
+	ServerChannel *pChannel;
+	ServerWorker *pWorker;
+	uint32_t Capacity = 1;
+	uint32_t i;
+
+	/* procedure code */
+	memset(S, 0, sizeof(*S));
+	S->Config = *pConfig;
+	atomic_init(&S->Tick, 0);
+	atomic_init(&S->Stop, 0);
+	if ((pConfig->numChannels == 0) || (pConfig->numWorkers == 0) ||
+			(pConfig->numWorkers > SERVER_WORKERS_MAX) ||
+			(pConfig->numTaps == 0)) {
+		return -1;
+	}
+
+	/* A channel is in one deque at most */
+	while (Capacity < pConfig->numChannels) {
+		Capacity <<= 1;
+	}
+
+	S->pChannels = (ServerChannel *) aligned_alloc(SERVER_CACHE_LINE,
+			pConfig->numChannels * sizeof(ServerChannel));
+	S->pWorkers = (ServerWorker *) aligned_alloc(SERVER_CACHE_LINE,
+			pConfig->numWorkers * sizeof(ServerWorker));
+	if ((S->pChannels == 0) || (S->pWorkers == 0)) {
+		free(S->pChannels);
+		free(S->pWorkers);
+		S->pChannels = 0;
+		S->pWorkers = 0;
+		return -1;
+	}
+	memset(S->pChannels, 0, pConfig->numChannels * sizeof(ServerChannel));
+	memset(S->pWorkers, 0, pConfig->numWorkers * sizeof(ServerWorker));
+
+	for (i = 0; i < pConfig->numWorkers; i++) {
+		pWorker = &S->pWorkers[i];
+		pWorker->pServer = S;
+		pWorker->Index = i;
+		pWorker->Cpu = ~0u;
+		atomic_init(&pWorker->Deque.Top, 0);
+		atomic_init(&pWorker->Deque.Bottom, 0);
+		pWorker->Deque.Mask = Capacity - 1;
+		pWorker->Deque.pItems =
+				(atomic_uint *) calloc(Capacity, sizeof(atomic_uint));
+		if (pWorker->Deque.pItems == 0) {
+			ChannelServer_free(S);
+			return -1;
+		}
+	}
+
+	for (i = 0; i < pConfig->numChannels; i++) {
+		pChannel = &S->pChannels[i];
+		pChannel->Home = i % pConfig->numWorkers;
+		atomic_init(&pChannel->InHead, 0);
+		atomic_init(&pChannel->InTail, 0);
+		atomic_init(&pChannel->OutHead, 0);
+		atomic_init(&pChannel->OutTail, 0);
+		atomic_init(&pChannel->Busy, 0);
+		pChannel->pMemory = (q15_t *) malloc(
+				ECHO_CANCELLER_MEMORY(pConfig->numTaps) * sizeof(q15_t));
+		if (pChannel->pMemory == 0) {
+			ChannelServer_free(S);
+			return -1;
+		}
+		EchoCanceller_init_q15(&pChannel->Canceller, pConfig->numTaps,
+				pConfig->Mu, pChannel->pMemory);
+	}
+	return 0;
+}
+/*****************************************************************************/
+/*  End         : ChannelServer_init                                         */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : ChannelServer_start                                        */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Starts the workers, pinned to the cores if configured      */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Server                                          */
+/*                                                                           */
+/*  Output Para : Return     0, or -1 if a thread can not be created (the    */
+/*                           started ones are stopped again)                 */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+int ChannelServer_start(ChannelServer *S) {
+
+	/* procedure data */
+	ServerWorker *pWorker;
+	cpu_set_t Set;
+	long Cores;
+	uint32_t i;
+
+	/* procedure code */
+	Cores = sysconf(_SC_NPROCESSORS_ONLN);
+	if (Cores < 1) {
+		Cores = 1;
+	}
+	atomic_store(&S->Stop, 0);
+	for (i = 0; i < S->Config.numWorkers; i++) {
+		pWorker = &S->pWorkers[i];
+		if (pthread_create(&pWorker->Thread, 0, Server_worker, pWorker) != 0) {
+			S->Config.numWorkers = i;
+			ChannelServer_stop(S);
+			return -1;
+		}
+		if (S->Config.Affinity) {
+			CPU_ZERO(&Set);
+			CPU_SET(i % (uint32_t) Cores, &Set);
+			if (pthread_setaffinity_np(pWorker->Thread, sizeof(Set),
+					&Set) == 0) {
+				pWorker->Cpu = i % (uint32_t) Cores;
+			}
+		}
+	}
+	return 0;
+}
+/*****************************************************************************/
+/*  End         : ChannelServer_start                                        */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : ChannelServer_push                                         */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Queues an input frame of a channel (producer side)         */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Server                                          */
+/*                Channel    Channel number                                  */
+/*                pFar       Far end (reference) [SERVER_FRAME]              */
+/*                pMic       Microphone [SERVER_FRAME]                       */
+/*                Time       Time stamp [ns], returned with the output       */
+/*                                                                           */
+/*  Output Para : Return     0, or -1 if the queue is full (Dropped)         */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+int ChannelServer_push(ChannelServer *S, uint32_t Channel, const q15_t *pFar,
+		const q15_t *pMic, uint64_t Time) {
+
+	/* procedure data */
+	ServerChannel *pChannel = &S->pChannels[Channel];
+	ServerFrameIn *pFrame;
+	uint32_t Head;
+
+	/* procedure code */
+	Head = atomic_load_explicit(&pChannel->InHead, memory_order_relaxed);
+	if (Head - atomic_load_explicit(&pChannel->InTail,
+			memory_order_acquire) >= SERVER_QUEUE) {
+		pChannel->Dropped++;
+		return -1;
+	}
+	pFrame = &pChannel->In[Head & (SERVER_QUEUE - 1)];
+	memcpy(pFrame->Far, pFar, sizeof(pFrame->Far));
+	memcpy(pFrame->Mic, pMic, sizeof(pFrame->Mic));
+	pFrame->Time = Time;
+	atomic_store_explicit(&pChannel->InHead, Head + 1, memory_order_release);
+	return 0;
+}
+/*****************************************************************************/
+/*  End         : ChannelServer_push                                         */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : ChannelServer_tick                                         */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Announces the frames pushed so far to the workers          */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Server                                          */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void ChannelServer_tick(ChannelServer *S) {
+
+	/* procedure code */
+	atomic_fetch_add_explicit(&S->Tick, 1, memory_order_release);
+}
+/*****************************************************************************/
+/*  End         : ChannelServer_tick                                         */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : ChannelServer_pop                                          */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Takes the oldest output frame of a channel (consumer side) */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Server                                          */
+/*                Channel    Channel number                                  */
+/*                                                                           */
+/*  Output Para : pErr       Error signal [SERVER_FRAME], 0 = not wanted     */
+/*                pTime      Time stamp of the input frame [ns]              */
+/*                pDone      Time the canceller finished the frame [ns]      */
+/*                Return     0, or -1 if no frame is ready                   */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+int ChannelServer_pop(ChannelServer *S, uint32_t Channel, q15_t *pErr,
+		uint64_t *pTime, uint64_t *pDone) {
+
+	/* procedure data */
+	ServerChannel *pChannel = &S->pChannels[Channel];
+	ServerFrameOut *pFrame;
+	uint32_t Tail;
+
+	/* procedure code */
+	Tail = atomic_load_explicit(&pChannel->OutTail, memory_order_relaxed);
+	if (Tail == atomic_load_explicit(&pChannel->OutHead,
+			memory_order_acquire)) {
+		return -1;
+	}
+	pFrame = &pChannel->Out[Tail & (SERVER_QUEUE - 1)];
+	if (pErr != 0) {
+		memcpy(pErr, pFrame->Err, sizeof(pFrame->Err));
+	}
+	*pTime = pFrame->Time;
+	*pDone = pFrame->Done;
+	atomic_store_explicit(&pChannel->OutTail, Tail + 1, memory_order_release);
+	return 0;
+}
+/*****************************************************************************/
+/*  End         : ChannelServer_pop                                          */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : ChannelServer_stop                                         */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Stops and joins the workers, queued frames stay queued     */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Server                                          */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void ChannelServer_stop(ChannelServer *S) {
+
+	/* procedure data */
+	uint32_t i;
+
+	/* procedure code */
+	atomic_store_explicit(&S->Stop, 1, memory_order_release);
+	for (i = 0; i < S->Config.numWorkers; i++) {
+		pthread_join(S->pWorkers[i].Thread, 0);
+	}
+}
+/*****************************************************************************/
+/*  End         : ChannelServer_stop                                         */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : ChannelServer_free                                         */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Frees the memory of a stopped server                       */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Server                                          */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void ChannelServer_free(ChannelServer *S) {
+
+	/* procedure data */
+	uint32_t i;
+
+	/* procedure code */
+	if (S->pChannels != 0) {
+		for (i = 0; i < S->Config.numChannels; i++) {
+			free(S->pChannels[i].pMemory);
+		}
+	}
+	if (S->pWorkers != 0) {
+		for (i = 0; i < S->Config.numWorkers; i++) {
+			free(S->pWorkers[i].Deque.pItems);
+		}
+	}
+	free(S->pChannels);
+	free(S->pWorkers);
+	S->pChannels = 0;
+	S->pWorkers = 0;
+}
+/*****************************************************************************/
+/*  End         : ChannelServer_free                                         */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : ChannelServer_now                                          */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Monotonic time for the time stamps                         */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : Return     Time [ns]                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+uint64_t ChannelServer_now(void) {
+
+	/* procedure data */
+	struct timespec Now;
+
+	/* procedure code */
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	return (uint64_t) Now.tv_sec * 1000000000u + (uint64_t) Now.tv_nsec;
+}
+/*****************************************************************************/
+/*  End         : ChannelServer_now                                          */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Server_worker                                              */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Thread of a worker: schedules its home channels on a new   */
+/*                tick, runs its deque, steals when it is empty              */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pArg       Worker                                          */
+/*                                                                           */
+/*  Output Para : Return     0                                               */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void *Server_worker(void *pArg) {
+
+	/* procedure data */
+	ServerWorker *pWorker = (ServerWorker *) pArg;
+	ChannelServer *S = pWorker->pServer;
+	struct timespec Nap = { 0, SERVER_NAP };
+	uint32_t Idle = 0;
+	uint32_t Tick;
+	int64_t Channel;
+
+	/* procedure code */
+	while (!atomic_load_explicit(&S->Stop, memory_order_acquire)) {
+		Tick = atomic_load_explicit(&S->Tick, memory_order_acquire);
+		if (Tick != pWorker->Tick) {
+			pWorker->Tick = Tick;
+			Server_schedule(S, pWorker);
+		}
+
+		Channel = Server_take(&pWorker->Deque);
+		if (Channel == SERVER_EMPTY) {
+			Channel = Server_steal(S, pWorker);
+		}
+		if (Channel != SERVER_EMPTY) {
+			Server_channel(S, pWorker, (uint32_t) Channel);
+			Idle = 0;
+		} else if (++Idle >= SERVER_SPIN) {
+			nanosleep(&Nap, 0);
+		} else {
+			sched_yield();
+		}
+	}
+	return 0;
+}
+/*****************************************************************************/
+/*  End         : Server_worker                                              */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Server_schedule                                            */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Puts the ready home channels of a worker into its deque    */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Server                                          */
+/*                pWorker    Worker, owner of the deque                      */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Server_schedule(ChannelServer *S, ServerWorker *pWorker) {
+
+	/* procedure data */
+	ServerChannel *pChannel;
+	uint32_t Free;
+	uint32_t i;
+
+	/* procedure code */
+	for (i = pWorker->Index; i < S->Config.numChannels;
+			i += S->Config.numWorkers) {
+		pChannel = &S->pChannels[i];
+		if (atomic_load_explicit(&pChannel->InHead, memory_order_acquire) ==
+				atomic_load_explicit(&pChannel->InTail,
+						memory_order_relaxed)) {
+			continue;
+		}
+		Free = 0;
+		if (atomic_compare_exchange_strong_explicit(&pChannel->Busy, &Free,
+				1, memory_order_acquire, memory_order_relaxed)) {
+			Server_push(&pWorker->Deque, i);
+		}
+	}
+}
+/*****************************************************************************/
+/*  End         : Server_schedule                                            */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Server_steal                                               */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Takes a channel from the top of another deque, the next    */
+/*                worker first                                               */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Server                                          */
+/*                pWorker    Thief                                           */
+/*                                                                           */
+/*  Output Para : Return     Channel, or SERVER_EMPTY                        */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static int64_t Server_steal(ChannelServer *S, ServerWorker *pWorker) {
+
+	/* procedure data */
+	uint32_t Victim = pWorker->Index;
+	int64_t Channel;
+	uint32_t i;
+
+	/* procedure code */
+	for (i = 1; i < S->Config.numWorkers; i++) {
+		if (++Victim >= S->Config.numWorkers) {
+			Victim = 0;
+		}
+		Channel = Server_pull(&S->pWorkers[Victim].Deque);
+		if (Channel != SERVER_EMPTY) {
+			pWorker->Steals++;
+			return Channel;
+		}
+	}
+	return SERVER_EMPTY;
+}
+/*****************************************************************************/
+/*  End         : Server_steal                                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Server_channel                                             */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Runs the canceller of a channel on all its queued frames   */
+/*                and releases the channel                                   */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Server                                          */
+/*                pWorker    Worker running the channel                      */
+/*                Channel    Channel number (Busy)                           */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Server_channel(ChannelServer *S, ServerWorker *pWorker,
+		uint32_t Channel) {
+
+	/* procedure data */
+	ServerChannel *pChannel = &S->pChannels[Channel];
+	ServerFrameIn *pIn;
+	ServerFrameOut *pOut;
+	ServerFrameOut Lost;
+	struct timespec Start;
+	struct timespec End;
+	uint32_t InTail;
+	uint32_t OutHead;
+	uint32_t Free;
+	uint32_t i;
+
+	/* procedure code */
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &Start);
+	InTail = atomic_load_explicit(&pChannel->InTail, memory_order_relaxed);
+	for (;;) {
+		while (InTail != atomic_load_explicit(&pChannel->InHead,
+				memory_order_acquire)) {
+			pIn = &pChannel->In[InTail & (SERVER_QUEUE - 1)];
+			OutHead = atomic_load_explicit(&pChannel->OutHead,
+					memory_order_relaxed);
+			if (OutHead - atomic_load_explicit(&pChannel->OutTail,
+					memory_order_acquire) < SERVER_QUEUE) {
+				pOut = &pChannel->Out[OutHead & (SERVER_QUEUE - 1)];
+			} else {
+				/* The consumer is behind, the canceller still runs */
+				pOut = &Lost;
+			}
+
+			for (i = 0; i < SERVER_FRAME; i += BLOCK_SIZE) {
+				EchoCanceller_q15(&pChannel->Canceller, &pIn->Far[i],
+						&pIn->Mic[i], &pOut->Err[i], BLOCK_SIZE);
+			}
+			pOut->Time = pIn->Time;
+			pOut->Done = ChannelServer_now();
+
+			if (pOut == &Lost) {
+				pChannel->Overrun++;
+			} else {
+				atomic_store_explicit(&pChannel->OutHead, OutHead + 1,
+						memory_order_release);
+			}
+			atomic_store_explicit(&pChannel->InTail, ++InTail,
+					memory_order_release);
+			pWorker->Frames++;
+		}
+		EchoCanceller_idle_q15(&pChannel->Canceller);
+		atomic_store(&pChannel->Busy, 0);
+
+		/* A frame pushed while the channel was busy missed its tick */
+		Free = 0;
+		if ((InTail == atomic_load(&pChannel->InHead)) ||
+				!atomic_compare_exchange_strong(&pChannel->Busy, &Free, 1)) {
+			break;
+		}
+	}
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &End);
+	pWorker->BusyTime += (uint64_t) ((End.tv_sec - Start.tv_sec) *
+			1000000000ll + (End.tv_nsec - Start.tv_nsec));
+}
+/*****************************************************************************/
+/*  End         : Server_channel                                             */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Server_push                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Puts a channel at the bottom of a deque (owner only). The  */
+/*                deque holds every channel, so it can not overflow.         */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pDeque     Deque of the calling worker                     */
+/*                Channel    Channel number                                  */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Server_push(ServerDeque *pDeque, uint32_t Channel) {
+
+	/* procedure data */
+	int64_t Bottom;
+
+	/* procedure code */
+	Bottom = atomic_load_explicit(&pDeque->Bottom, memory_order_relaxed);
+	atomic_store_explicit(&pDeque->pItems[Bottom & pDeque->Mask], Channel,
+			memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	atomic_store_explicit(&pDeque->Bottom, Bottom + 1, memory_order_relaxed);
+}
+/*****************************************************************************/
+/*  End         : Server_push                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Server_take                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Takes the channel at the bottom of a deque (owner only),   */
+/*                the last one against the thieves                           */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pDeque     Deque of the calling worker                     */
+/*                                                                           */
+/*  Output Para : Return     Channel, or SERVER_EMPTY                        */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static int64_t Server_take(ServerDeque *pDeque) {
+
+	/* procedure data */
+	int64_t Bottom;
+	long long Top;
+	int64_t Channel = SERVER_EMPTY;
+
+	/* procedure code */
+	Bottom = atomic_load_explicit(&pDeque->Bottom, memory_order_relaxed) - 1;
+	atomic_store_explicit(&pDeque->Bottom, Bottom, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+	Top = atomic_load_explicit(&pDeque->Top, memory_order_relaxed);
+	if (Top <= Bottom) {
+		Channel = atomic_load_explicit(&pDeque->pItems[Bottom & pDeque->Mask],
+				memory_order_relaxed);
+		if (Top == Bottom) {
+			if (!atomic_compare_exchange_strong_explicit(&pDeque->Top, &Top,
+					Top + 1, memory_order_seq_cst, memory_order_relaxed)) {
+				Channel = SERVER_EMPTY;
+			}
+			atomic_store_explicit(&pDeque->Bottom, Bottom + 1,
+					memory_order_relaxed);
+		}
+	} else {
+		atomic_store_explicit(&pDeque->Bottom, Bottom + 1,
+				memory_order_relaxed);
+	}
+	return Channel;
+}
+/*****************************************************************************/
+/*  End         : Server_take                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Server_pull                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Steals the channel at the top of a deque (any thread)      */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pDeque     Deque of another worker                         */
+/*                                                                           */
+/*  Output Para : Return     Channel, or SERVER_EMPTY if the deque is empty  */
+/*                           or another thief was faster                     */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static int64_t Server_pull(ServerDeque *pDeque) {
+
+	/* procedure data */
+	long long Top;
+	int64_t Bottom;
+	int64_t Channel = SERVER_EMPTY;
+
+	/* procedure code */
+	Top = atomic_load_explicit(&pDeque->Top, memory_order_acquire);
+	atomic_thread_fence(memory_order_seq_cst);
+	Bottom = atomic_load_explicit(&pDeque->Bottom, memory_order_acquire);
+	if (Top < Bottom) {
+		Channel = atomic_load_explicit(&pDeque->pItems[Top & pDeque->Mask],
+				memory_order_relaxed);
+		if (!atomic_compare_exchange_strong_explicit(&pDeque->Top, &Top,
+				Top + 1, memory_order_seq_cst, memory_order_relaxed)) {
+			Channel = SERVER_EMPTY;
+		}
+	}
+	return Channel;
+}
+/*****************************************************************************/
+/*  End         : Server_pull                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : ChannelServer                                              */
+/*****************************************************************************/
@@ -0,0 +1,161 @@
+#ifndef CHANNELSERVER_H
+#define CHANNELSERVER_H
+/*****************************************************************************/
+/*  Header     : ChannelServer (host)                           Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Echo canceller of many independent channels on a PC with    */
+/*               pthreads. Every channel runs the fixed point canceller of   */
+/*               the board (EchoCanceller.c, built with the host intrinsics  */
+/*               of Host/) on frames of SERVER_FRAME samples.                */
+/*                                                                           */
+/*               A channel has a lock-free single producer, single consumer  */
+/*               queue of input frames (far end and microphone) and one of   */
+/*               output frames (error). One worker per core, pinned to it,   */
+/*               runs the channels of its home share; an idle worker steals  */
+/*               ready channels from the others (work stealing deques).      */
+/*                                                                           */
+/*  Procedures : ChannelServer_init()                                        */
+/*               ChannelServer_start()                                       */
+/*               ChannelServer_push()                                        */
+/*               ChannelServer_tick()                                        */
+/*               ChannelServer_pop()                                         */
+/*               ChannelServer_stop()                                        */
+/*               ChannelServer_free()                                        */
+/*               ChannelServer_now()                                         */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : ChannelServer.h                                             */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "EchoCanceller.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+/* module constant declaration  */
+
+/* Samples per frame (10ms at FS, as a packet of a voice channel) */
+#define SERVER_FRAME (FS / 100)
+
+/* Frames per queue, a power of two */
+#define SERVER_QUEUE 8
+
+/* Workers at most */
+#define SERVER_WORKERS_MAX 64
+
+/* Size of a cache line, the shared counters have their own */
+#define SERVER_CACHE_LINE 64
+
+#if SERVER_FRAME % BLOCK_SIZE
+#error "SERVER_FRAME must be a multiple of BLOCK_SIZE"
+#endif
+#if SERVER_QUEUE & (SERVER_QUEUE - 1)
+#error "SERVER_QUEUE must be a power of two"
+#endif
+
+/* module type declaration      */
+
+/* Input frame, Time when it was pushed [ns] */
+typedef struct
+{
+	q15_t Far[SERVER_FRAME];
+	q15_t Mic[SERVER_FRAME];
+	uint64_t Time;
+} ServerFrameIn;
+
+/* Output frame, Done when the canceller finished it [ns] */
+typedef struct
+{
+	q15_t Err[SERVER_FRAME];
+	uint64_t Time;
+	uint64_t Done;
+} ServerFrameOut;
+
+/* Channel, owned by at most one worker at a time (Busy) */
+typedef struct
+{
+	EchoCancellerInstanceQ15 Canceller;
+	q15_t *pMemory;
+	uint32_t Home;                 /* Worker of the channel           */
+	uint64_t Dropped;              /* Input frames lost, queue full   */
+	uint64_t Overrun;              /* Output frames lost, queue full  */
+	ServerFrameIn In[SERVER_QUEUE];
+	ServerFrameOut Out[SERVER_QUEUE];
+	_Alignas(SERVER_CACHE_LINE) atomic_uint InHead;   /* Producer  */
+	_Alignas(SERVER_CACHE_LINE) atomic_uint InTail;   /* Worker    */
+	_Alignas(SERVER_CACHE_LINE) atomic_uint OutHead;  /* Worker    */
+	_Alignas(SERVER_CACHE_LINE) atomic_uint OutTail;  /* Consumer  */
+	_Alignas(SERVER_CACHE_LINE) atomic_uint Busy;
+} ServerChannel;
+
+/* Work stealing deque of channel numbers (Chase-Lev, bounded) */
+typedef struct
+{
+	_Alignas(SERVER_CACHE_LINE) atomic_llong Top;
+	_Alignas(SERVER_CACHE_LINE) atomic_llong Bottom;
+	atomic_uint *pItems;
+	uint32_t Mask;
+} ServerDeque;
+
+struct ChannelServer;
+
+/* Worker thread */
+typedef struct
+{
+	_Alignas(SERVER_CACHE_LINE) ServerDeque Deque;
+	struct ChannelServer *pServer;
+	pthread_t Thread;
+	uint32_t Index;
+	uint32_t Cpu;                  /* Pinned core, or ~0 if not pinned */
+	uint32_t Tick;                 /* Last tick seen                   */
+	uint64_t Frames;               /* Frames processed                 */
+	uint64_t Steals;               /* Channels taken from others       */
+	uint64_t BusyTime;             /* CPU time in the cancellers [ns]  */
+} ServerWorker;
+
+/* Configuration */
+typedef struct
+{
+	uint32_t numChannels;
+	uint32_t numWorkers;
+	uint16_t numTaps;
+	q15_t Mu;
+	uint8_t Affinity;              /* Pin worker i to core i % cores   */
+} ChannelServerConfig;
+
+/* Server */
+typedef struct ChannelServer
+{
+	ChannelServerConfig Config;
+	ServerChannel *pChannels;
+	ServerWorker *pWorkers;
+	_Alignas(SERVER_CACHE_LINE) atomic_uint Tick;
+	atomic_uint Stop;
+} ChannelServer;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+int ChannelServer_init(ChannelServer *S, const ChannelServerConfig *pConfig);
+int ChannelServer_start(ChannelServer *S);
+int ChannelServer_push(ChannelServer *S, uint32_t Channel, const q15_t *pFar,
+		const q15_t *pMic, uint64_t Time);
+void ChannelServer_tick(ChannelServer *S);
+int ChannelServer_pop(ChannelServer *S, uint32_t Channel, q15_t *pErr,
+		uint64_t *pTime, uint64_t *pDone);
+void ChannelServer_stop(ChannelServer *S);
+void ChannelServer_free(ChannelServer *S);
+uint64_t ChannelServer_now(void);
+
+/*****************************************************************************/
+/*  End Header  : ChannelServer                                              */
+/*****************************************************************************/
+#endif
@@ -0,0 +1,529 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : ChannelServerMain (host)                       Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Load generator and scaling measurement of the channel       */
+/*               server (ChannelServer.c). Every channel plays a recorded    */
+/*               scenario of Matlab/ (reference and microphone with echo),   */
+/*               from its own start offset, so no two channels are alike.    */
+/*               The main thread pushes the frames and collects the outputs  */
+/*               of all channels; the latency of a frame is the time from    */
+/*               its push to the end of its canceller run.                   */
+/*                                                                           */
+/*               -paced 0 pushes as fast as the workers take the frames and  */
+/*               reports the real time factor, i.e. how many channels of     */
+/*               this size run in real time per core. -paced 1 pushes one    */
+/*               frame per channel every SERVER_FRAME / FS and reports the   */
+/*               latency percentiles and the frames later than a frame       */
+/*               period (misses).                                            */
+/*                                                                           */
+/*               Build (from this directory):                                */
+/*               gcc -O2 -DARM_MATH_CM4 -I. -I../src                         */
+/*                   -I../Libraries/CMSIS/Include -o channelserver           */
+/*                   ChannelServerMain.c ChannelServer.c Wav.c               */
+/*                   ../src/EchoCanceller.c ../src/LMSMetrics.c              */
+/*                   ../src/LMSDegrade.c                                     */
+/*                   ../Libraries/CMSIS/DSP_Lib/Source/FilteringFunctions/   */
+/*                   arm_lms_q15.c                                           */
+/*                   ../Libraries/CMSIS/DSP_Lib/Source/FilteringFunctions/   */
+/*                   arm_lms_init_q15.c -lpthread -lm                        */
+/*               (plus the modules of the LMS_... switches of                */
+/*               EchoCanceller.h that are enabled)                           */
+/*                                                                           */
+/*               Example (channels per core with 1 to 8 workers):            */
+/*               ./channelserver -workers 1,2,4,8 -channels 64 -taps 512     */
+/*                                                                           */
+/*               Options:                                                    */
+/*               -workers list   Worker threads (cores online)               */
+/*               -channels list  Channels (16)                               */
+/*               -taps n         Filter length (FILTER_LENGTH, 1700)         */
+/*               -mu n           Step in Q15 (MU of the firmware, 1)         */
+/*               -seconds s      Audio per channel (5)                       */
+/*               -paced 0|1      Real time load (0)                          */
+/*               -affinity 0|1   Pin the workers to the cores (1)            */
+/*               -dir path       Directory of the recordings (WAV_DIRECTORY) */
+/*                                                                           */
+/*               The exit code is 1 if a paced run misses a frame period or  */
+/*               drops frames.                                               */
+/*                                                                           */
+/*  Procedures : main()                                                      */
+/*               Main_run()                                                  */
+/*               Main_percentile()                                           */
+/*               Main_list()                                                 */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : ChannelServerMain.c                                         */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "ChannelServer.h"
+#include "Wav.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+/* module constant declaration */
+
+/* Reference and the recorded microphone signals (reference + echo) */
+#define MAIN_REFERENCE "Lorem_ipsum_3500.wav"
+#define MAIN_SCENARIOS 2
+
+/* Values of a list option */
+#define MAIN_LIST_MAX 16
+
+/* Default filter length and step (SignalProcessingLMSFilter.c) */
+#define MAIN_TAPS 1700
+#define MAIN_MU 1
+
+/* Start offset of channel c: c * MAIN_OFFSET samples (a prime) */
+#define MAIN_OFFSET 997
+
+/* Latency histogram: MAIN_BINS bins of MAIN_BIN ns (1s) */
+#define MAIN_BIN 10000
+#define MAIN_BINS 100000
+
+/* Frame period [ns] */
+#define MAIN_PERIOD (1000000000ull * SERVER_FRAME / FS)
+
+/* module type declaration */
+
+/* Recordings */
+typedef struct
+{
+	int16_t *pFar;
+	int16_t *pMic[MAIN_SCENARIOS];
+	uint32_t Length;
+} MainLoad;
+
+/* Result of a run */
+typedef struct
+{
+	uint64_t Frames;          /* Frames returned                      */
+	uint64_t Dropped;         /* Input frames lost (paced)            */
+	uint64_t Overrun;         /* Output frames lost                   */
+	uint64_t Misses;          /* Latency above a frame period         */
+	uint64_t Steals;
+	double Wall;              /* [s]                                  */
+	double Busy;              /* CPU time in the cancellers [s]       */
+	double P50;               /* Latency percentiles [us]             */
+	double P99;
+	double Max;
+	float32_t Erle;           /* Long term ERLE of channel 0 [dB]     */
+} MainResult;
+
+/* module data declaration */
+
+static const char *Scenarios[MAIN_SCENARIOS] =
+{
+	"Lorem_ipsum_delay_3500.wav",
+	"Lorem_ipsum_verb_3500.wav"
+};
+
+static uint32_t Histogram[MAIN_BINS];
+
+/* module procedure declaration */
+static int Main_run(const ChannelServerConfig *pConfig, const MainLoad *pLoad,
+		double Seconds, uint8_t Paced, MainResult *pResult);
+static double Main_percentile(uint64_t Count, double Fraction);
+static uint32_t Main_list(const char *pText, uint32_t *pValues);
+
+/*****************************************************************************/
+/*  Procedure   : main                                                       */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Parses the options, loads the recordings and runs every    */
+/*                combination of workers and channels, one line each         */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : argc, argv Options, see module header                      */
+/*                                                                           */
+/*  Output Para : Return     0 ok, 1 paced run missed frames, 2 error        */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+int main(int argc, char *argv[]) {
+
+	/* procedure data */
+	ChannelServerConfig Config;
+	MainResult Result;
+	MainLoad Load;
+	uint32_t Workers[MAIN_LIST_MAX];
+	uint32_t Channels[MAIN_LIST_MAX];
+	uint32_t numWorkers = 1;
+	uint32_t numChannels = 1;
+	uint32_t Length;
+	const char *pDir = WAV_DIRECTORY;
+	char Name[512];
+	double Seconds = 5.0;
+	double Audio;
+	uint8_t Paced = 0;
+	long Cores;
+	uint32_t Used;
+	uint32_t i, j;
+	int Failed = 0;
+	int a;
+
+	/* procedure code */
+	Cores = sysconf(_SC_NPROCESSORS_ONLN);
+	if (Cores < 1) {
+		Cores = 1;
+	}
+	memset(&Config, 0, sizeof(Config));
+	Config.numTaps = MAIN_TAPS;
+	Config.Mu = MAIN_MU;
+	Config.Affinity = 1;
+	Workers[0] = (uint32_t) Cores;
+	Channels[0] = 16;
+
+	for (a = 1; a < argc; a++) {
+		if (a + 1 >= argc) {
+			fprintf(stderr, "Missing value of %s\n", argv[a]);
+			return 2;
+		} else if (strcmp(argv[a], "-workers") == 0) {
+			numWorkers = Main_list(argv[++a], Workers);
+		} else if (strcmp(argv[a], "-channels") == 0) {
+			numChannels = Main_list(argv[++a], Channels);
+		} else if (strcmp(argv[a], "-taps") == 0) {
+			Config.numTaps = (uint16_t) atoi(argv[++a]);
+		} else if (strcmp(argv[a], "-mu") == 0) {
+			Config.Mu = (q15_t) atoi(argv[++a]);
+		} else if (strcmp(argv[a], "-seconds") == 0) {
+			Seconds = atof(argv[++a]);
+		} else if (strcmp(argv[a], "-paced") == 0) {
+			Paced = (uint8_t) atoi(argv[++a]);
+		} else if (strcmp(argv[a], "-affinity") == 0) {
+			Config.Affinity = (uint8_t) atoi(argv[++a]);
+		} else if (strcmp(argv[a], "-dir") == 0) {
+			pDir = argv[++a];
+		} else {
+			fprintf(stderr, "Unknown option %s\n", argv[a]);
+			return 2;
+		}
+	}
+	if ((numWorkers == 0) || (numChannels == 0) || (Config.numTaps == 0) ||
+			(Seconds <= 0.0)) {
+		fprintf(stderr, "Invalid option value\n");
+		return 2;
+	}
+
+	/* Recordings at the sampling frequency of the board */
+	snprintf(Name, sizeof(Name), "%s/%s", pDir, MAIN_REFERENCE);
+	if (Wav_read(Name, FS, &Load.pFar, &Load.Length) != 0) {
+		fprintf(stderr, "Can not read %s\n", Name);
+		return 2;
+	}
+	for (i = 0; i < MAIN_SCENARIOS; i++) {
+		snprintf(Name, sizeof(Name), "%s/%s", pDir, Scenarios[i]);
+		if (Wav_read(Name, FS, &Load.pMic[i], &Length) != 0) {
+			fprintf(stderr, "Can not read %s\n", Name);
+			return 2;
+		}
+		if (Length < Load.Length) {
+			Load.Length = Length;
+		}
+	}
+	if (Load.Length < SERVER_FRAME) {
+		fprintf(stderr, "Recordings too short\n");
+		return 2;
+	}
+
+	printf("%ld cores, %u taps, frame %u samples, %s\n", Cores,
+			Config.numTaps, SERVER_FRAME, Paced ? "paced" : "free running");
+	printf("Workers Channels    Frames  RT-factor  Ch/core  Busy%%  "
+			"p50/us  p99/us  max/us  Misses  Dropped  Steals  ERLE/dB\n");
+	for (i = 0; i < numWorkers; i++) {
+		for (j = 0; j < numChannels; j++) {
+			Config.numWorkers = Workers[i];
+			Config.numChannels = Channels[j];
+			if (Main_run(&Config, &Load, Seconds, Paced, &Result) != 0) {
+				fprintf(stderr, "Invalid configuration, %u workers, "
+						"%u channels\n", Workers[i], Channels[j]);
+				return 2;
+			}
+			if (Paced && (Result.Misses || Result.Dropped)) {
+				Failed = 1;
+			}
+
+			/* Real time channels per core actually used */
+			Audio = (double) Result.Frames * SERVER_FRAME / FS;
+			Used = (Workers[i] < (uint32_t) Cores) ? Workers[i] :
+					(uint32_t) Cores;
+			printf("%7u %8u %9llu %10.2f %8.1f %6.1f %7.0f %7.0f %7.0f "
+					"%7llu %8llu %7llu %8.1f\n", Workers[i], Channels[j],
+					(unsigned long long) Result.Frames,
+					Audio / Channels[j] / Result.Wall,
+					Audio / Result.Wall / Used,
+					100.0 * Result.Busy / Result.Wall / Used,
+					Result.P50, Result.P99, Result.Max,
+					(unsigned long long) Result.Misses,
+					(unsigned long long) Result.Dropped,
+					(unsigned long long) Result.Steals, Result.Erle);
+			fflush(stdout);
+		}
+	}
+
+	free(Load.pFar);
+	for (i = 0; i < MAIN_SCENARIOS; i++) {
+		free(Load.pMic[i]);
+	}
+	return Failed;
+}
+/*****************************************************************************/
+/*  End         : main                                                       */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Main_run                                                   */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Runs a server with the load of Seconds audio per channel   */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pConfig    Server configuration                            */
+/*                pLoad      Recordings                                      */
+/*                Seconds    Audio per channel                               */
+/*                Paced      1: one frame per channel and frame period       */
+/*                                                                           */
+/*  Output Para : pResult    Result                                          */
+/*                Return     0, or -1 if the server can not be started       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static int Main_run(const ChannelServerConfig *pConfig, const MainLoad *pLoad,
+		double Seconds, uint8_t Paced, MainResult *pResult) {
+
+	/* procedure data */
+	ChannelServer Server;
+	LMSMetricsReport Report;
+	q15_t Far[SERVER_FRAME];
+	q15_t Mic[SERVER_FRAME];
+	uint32_t *pSent;
+	uint64_t Frames;
+	uint64_t Pending;
+	uint64_t Next;
+	uint64_t Start;
+	uint64_t Time;
+	uint64_t Done;
+	uint64_t Latency;
+	struct timespec Wake;
+	uint32_t Offset;
+	uint32_t Channel;
+	uint32_t Scenario;
+	uint32_t n;
+	uint8_t Pushed;
+	uint8_t Work;
+
+	/* procedure code */
+	memset(pResult, 0, sizeof(*pResult));
+	memset(Histogram, 0, sizeof(Histogram));
+	Frames = (uint64_t) (Seconds * FS / SERVER_FRAME);
+	if (Frames == 0) {
+		Frames = 1;
+	}
+	pSent = (uint32_t *) calloc(pConfig->numChannels, sizeof(uint32_t));
+	if ((pSent == 0) || (ChannelServer_init(&Server, pConfig) != 0)) {
+		free(pSent);
+		return -1;
+	}
+	if (ChannelServer_start(&Server) != 0) {
+		ChannelServer_free(&Server);
+		free(pSent);
+		return -1;
+	}
+
+	Pending = Frames * pConfig->numChannels;
+	Start = ChannelServer_now();
+	Next = Start;
+	while (Pending > 0) {
+		Work = 0;
+
+		/* Frames of the load generator */
+		if (!Paced || (ChannelServer_now() >= Next)) {
+			Pushed = 0;
+			for (Channel = 0; Channel < pConfig->numChannels; Channel++) {
+				if (pSent[Channel] >= Frames) {
+					continue;
+				}
+				Scenario = Channel % MAIN_SCENARIOS;
+				Offset = (uint32_t) (((uint64_t) Channel * MAIN_OFFSET +
+						(uint64_t) pSent[Channel] * SERVER_FRAME) %
+						pLoad->Length);
+				for (n = 0; n < SERVER_FRAME; n++) {
+					Far[n] = pLoad->pFar[Offset];
+					Mic[n] = pLoad->pMic[Scenario][Offset];
+					if (++Offset >= pLoad->Length) {
+						Offset = 0;
+					}
+				}
+				if (ChannelServer_push(&Server, Channel, Far, Mic,
+						ChannelServer_now()) == 0) {
+					pSent[Channel]++;
+					Pushed = 1;
+				} else if (Paced) {
+					/* A real time source does not wait */
+					pSent[Channel]++;
+					pResult->Dropped++;
+					Pending--;
+				}
+			}
+			if (Pushed) {
+				ChannelServer_tick(&Server);
+				Work = 1;
+			}
+			Next += MAIN_PERIOD;
+		}
+
+		/* Outputs of all channels */
+		for (Channel = 0; Channel < pConfig->numChannels; Channel++) {
+			while (ChannelServer_pop(&Server, Channel, 0, &Time, &Done) == 0) {
+				Latency = (Done - Time) / MAIN_BIN;
+				Histogram[(Latency < MAIN_BINS) ? Latency : MAIN_BINS - 1]++;
+				if (Done - Time > MAIN_PERIOD) {
+					pResult->Misses++;
+				}
+				if ((double) (Done - Time) / 1e3 > pResult->Max) {
+					pResult->Max = (double) (Done - Time) / 1e3;
+				}
+				pResult->Frames++;
+				Pending--;
+				Work = 1;
+			}
+		}
+
+		if (Paced && !Work && (Pending > 0)) {
+			Wake.tv_sec = (time_t) (Next / 1000000000u);
+			Wake.tv_nsec = (long) (Next % 1000000000u);
+			clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &Wake, 0);
+		} else if (!Work) {
+			sched_yield();
+		}
+	}
+	pResult->Wall = (double) (ChannelServer_now() - Start) / 1e9;
+	ChannelServer_stop(&Server);
+
+	for (n = 0; n < pConfig->numWorkers; n++) {
+		pResult->Busy += (double) Server.pWorkers[n].BusyTime / 1e9;
+		pResult->Steals += Server.pWorkers[n].Steals;
+	}
+	for (Channel = 0; Channel < pConfig->numChannels; Channel++) {
+		pResult->Overrun += Server.pChannels[Channel].Overrun;
+	}
+	pResult->P50 = Main_percentile(pResult->Frames, 0.50);
+	pResult->P99 = Main_percentile(pResult->Frames, 0.99);
+#if LMS_METRICS
+	EchoCanceller_report(&Server.pChannels[0].Canceller, &Report);
+	pResult->Erle = Report.ErleLong;
+#else
+	(void) Report;
+#endif
+
+	ChannelServer_free(&Server);
+	free(pSent);
+	return 0;
+}
+/*****************************************************************************/
+/*  End         : Main_run                                                   */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Main_percentile                                            */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Percentile of the latency histogram                        */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : Count      Frames in the histogram                         */
+/*                Fraction   Percentile [0 ... 1]                            */
+/*                                                                           */
+/*  Output Para : Return     Upper edge of its bin [us]                      */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static double Main_percentile(uint64_t Count, double Fraction) {
+
+	/* procedure data */
+	uint64_t Sum = 0;
+	uint32_t i;
+
+	/* procedure code */
+	for (i = 0; i < MAIN_BINS; i++) {
+		Sum += Histogram[i];
+		if ((double) Sum >= Fraction * (double) Count) {
+			break;
+		}
+	}
+	return (double) (i + 1) * MAIN_BIN / 1e3;
+}
+/*****************************************************************************/
+/*  End         : Main_percentile                                            */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Main_list                                                  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Parses a list of numbers separated by commas               */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pText      List                                            */
+/*                                                                           */
+/*  Output Para : pValues    Values [MAIN_LIST_MAX]                          */
+/*                Return     Number of values, 0 if invalid                  */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint32_t Main_list(const char *pText, uint32_t *pValues) {
+
+	/* procedure data */
+	uint32_t Count = 0;
+	char *pEnd;
+
+	/* procedure code */
+	while ((*pText != '\0') && (Count < MAIN_LIST_MAX)) {
+		pValues[Count] = (uint32_t) strtoul(pText, &pEnd, 10);
+		if ((pEnd == pText) || (pValues[Count] == 0)) {
+			return 0;
+		}
+		Count++;
+		pText = (*pEnd == ',') ? pEnd + 1 : pEnd;
+		if ((*pEnd != ',') && (*pEnd != '\0')) {
+			return 0;
+		}
+	}
+	return Count;
+}
+/*****************************************************************************/
+/*  End         : Main_list                                                  */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : ChannelServerMain                                          */
+/*****************************************************************************/
@@ -0,0 +1,364 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : CoeffStoreTest (host)                          Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Tests the snapshot store of the firmware (CoeffStore.c) on  */
+/*               its host flash, the file COEFF_STORE_FILE in the current    */
+/*               directory (deleted before every test). A reset is           */
+/*               CoeffStore_init() again, which reads the file back.         */
+/*                                                                           */
+/*               - Torn records: a record cut off after every header word,   */
+/*                 in the data and before Crc and Magic must be skipped,     */
+/*                 the record before it stays the newest and the next one    */
+/*                 is stored behind it.                                      */
+/*               - Many saves: -saves records, a reset after every           */
+/*                 TEST_RESET of them. Every record must be accepted (the    */
+/*                 sectors are erased in turn by CoeffStore_idle()) and read */
+/*                 back intact, also after a reset.                          */
+/*                                                                           */
+/*               Build (from this directory):                                */
+/*               gcc -O2 -DARM_MATH_CM4 -I. -I../src                         */
+/*                   -I../Libraries/CMSIS/Include -o coeffstoretest          */
+/*                   CoeffStoreTest.c ../src/CoeffStore.c                    */
+/*                                                                           */
+/*               Options:                                                    */
+/*               -saves n     Records of the second test (80)                */
+/*               -size n      Bytes of data per record (6800, float32        */
+/*                            coefficients of 1700 taps)                     */
+/*                                                                           */
+/*  Procedures : main()                                                      */
+/*               Test_torn()                                                 */
+/*               Test_saves()                                                */
+/*               Test_save()                                                 */
+/*               Test_check()                                                */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : CoeffStoreTest.c                                            */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "CoeffStore.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* module constant declaration */
+
+/* Largest data of a record [bytes] */
+#define TEST_SIZE_MAX (COEFF_STORE_SECTOR_SIZE / 2)
+
+/* Idle calls of a complete record at most (one word each, and the erase */
+/* of a sector after it)                                                  */
+#define TEST_STEPS_MAX (TEST_SIZE_MAX / 4 + 64)
+
+/* Records between two resets of the second test */
+#define TEST_RESET 7
+
+/* module type declaration */
+
+/* module data declaration */
+
+static uint8_t Data[TEST_SIZE_MAX];
+
+/* module procedure declaration */
+static int Test_torn(uint32_t Size);
+static int Test_saves(uint32_t Saves, uint32_t Size);
+static uint32_t Test_save(uint32_t Id, uint32_t Size, uint32_t Steps);
+static int Test_check(uint32_t Id, uint32_t Size);
+
+/*****************************************************************************/
+/*  Procedure   : main                                                       */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Parses the options and runs both tests                     */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : argc, argv Options, see module header                      */
+/*                                                                           */
+/*  Output Para : Return     0 if both tests pass, 1 if one fails, 2 on      */
+/*                           invalid options                                 */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+int main(int argc, char *argv[]) {
+
+	/* procedure data */
+	uint32_t Saves = 80;
+	uint32_t Size = 1700 * sizeof(float32_t);
+	int Result;
+	int a;
+
+	/* procedure code */
+	for (a = 1; a < argc; a++) {
+		if (a + 1 >= argc) {
+			fprintf(stderr, "Missing value of %s\n", argv[a]);
+			return 2;
+		} else if (strcmp(argv[a], "-saves") == 0) {
+			Saves = (uint32_t) atol(argv[++a]);
+		} else if (strcmp(argv[a], "-size") == 0) {
+			Size = (uint32_t) atol(argv[++a]);
+		} else {
+			fprintf(stderr, "Unknown option %s\n", argv[a]);
+			return 2;
+		}
+	}
+	if ((Size == 0) || (Size > TEST_SIZE_MAX)) {
+		fprintf(stderr, "Size must be 1 ... %u bytes\n", TEST_SIZE_MAX);
+		return 2;
+	}
+
+	Result = Test_torn(Size);
+	printf("Torn records    %s\n", Result ? "FAIL" : "ok");
+	if (Result == 0) {
+		Result = Test_saves(Saves, Size);
+		printf("Many saves      %s\n", Result ? "FAIL" : "ok");
+	}
+	remove(COEFF_STORE_FILE);
+	return Result;
+}
+/*****************************************************************************/
+/*  End         : main                                                       */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Test_torn                                                  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Cuts a record off at every header word, in the middle of   */
+/*                the data and before Crc and Magic, resets and checks that  */
+/*                the previous record is the newest and the next one fits    */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : Size       Bytes of data per record                        */
+/*                                                                           */
+/*  Output Para : Return     0 if passed, 1 if failed                        */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static int Test_torn(uint32_t Size) {
+
+	/* procedure data */
+	uint32_t Words = (Size + 3u) / 4u;
+	uint32_t Cuts[9];
+	uint32_t i;
+
+	/* procedure code */
+
+	/* Idle calls before the reset: the header words (Size ... Erle), */
+	/* data, all data, Crc                                             */
+	Cuts[0] = 1;
+	Cuts[1] = 2;
+	Cuts[2] = 3;
+	Cuts[3] = 4;
+	Cuts[4] = 5;
+	Cuts[5] = 5 + Words / 2u;
+	Cuts[6] = 5 + Words;
+	Cuts[7] = 6 + Words;
+	Cuts[8] = 0;
+
+	for (i = 0; i < sizeof(Cuts) / sizeof(Cuts[0]); i++) {
+		remove(COEFF_STORE_FILE);
+		CoeffStore_init(Size);
+		if ((Test_save(1, Size, TEST_STEPS_MAX) == 0) ||
+				(Test_save(2, Size, Cuts[i]) == 0)) {
+			printf("  cut %u: save refused\n", Cuts[i]);
+			return 1;
+		}
+
+		/* Reset in the middle of the record */
+		CoeffStore_init(Size);
+		if (Test_check(1, Size) != 0) {
+			printf("  cut %u: torn record taken or the one before lost\n",
+					Cuts[i]);
+			return 1;
+		}
+
+		/* The next record is stored behind the torn one */
+		if (Test_save(3, Size, TEST_STEPS_MAX) == 0) {
+			printf("  cut %u: no record after the torn one\n", Cuts[i]);
+			return 1;
+		}
+		CoeffStore_init(Size);
+		if (Test_check(3, Size) != 0) {
+			printf("  cut %u: record after the torn one lost\n", Cuts[i]);
+			return 1;
+		}
+	}
+	return 0;
+}
+/*****************************************************************************/
+/*  End         : Test_torn                                                  */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Test_saves                                                 */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Saves records with a reset after every TEST_RESET, each    */
+/*                one must be accepted and read back                         */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : Saves      Records to store                                */
+/*                Size       Bytes of data per record                        */
+/*                                                                           */
+/*  Output Para : Return     0 if passed, 1 if failed                        */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static int Test_saves(uint32_t Saves, uint32_t Size) {
+
+	/* procedure data */
+	uint32_t PerSector = COEFF_STORE_SECTOR_SIZE /
+			(COEFF_STORE_HEADER_WORDS * 4u + ((Size + 3u) & ~3u));
+	uint32_t Resets = 0;
+	uint32_t Id;
+
+	/* procedure code */
+	remove(COEFF_STORE_FILE);
+	CoeffStore_init(Size);
+	for (Id = 1; Id <= Saves; Id++) {
+		if ((Test_save(Id, Size, TEST_STEPS_MAX) == 0) ||
+				CoeffStore_busy()) {
+			printf("  record %u refused or not finished (%u per sector)\n",
+					Id, PerSector);
+			return 1;
+		}
+		if (Test_check(Id, Size) != 0) {
+			printf("  record %u not read back\n", Id);
+			return 1;
+		}
+		if (Id % TEST_RESET == 0) {
+			CoeffStore_init(Size);
+			Resets++;
+			if (Test_check(Id, Size) != 0) {
+				printf("  record %u lost by the reset\n", Id);
+				return 1;
+			}
+		}
+	}
+
+	/* The newest one also after a reset */
+	CoeffStore_init(Size);
+	if (Test_check(Saves, Size) != 0) {
+		printf("  record %u lost by the reset\n", Saves);
+		return 1;
+	}
+	printf("  %u records of %u bytes, %u per sector, %u resets\n", Saves,
+			Size, PerSector, Resets);
+	return 0;
+}
+/*****************************************************************************/
+/*  End         : Test_saves                                                 */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Test_save                                                  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Saves a record with data made from Id, and runs the idle   */
+/*                loop for at most Steps calls (the reset comes after)       */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : Id         Record, stored as numTaps and in the data       */
+/*                Size       Bytes of data                                   */
+/*                Steps      Idle calls at most                              */
+/*                                                                           */
+/*  Output Para : Return     0 if the store refused the record               */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint32_t Test_save(uint32_t Id, uint32_t Size, uint32_t Steps) {
+
+	/* procedure data */
+	CoeffStoreHeader Info;
+	uint32_t i;
+
+	/* procedure code */
+	for (i = 0; i < Size; i++) {
+		Data[i] = (uint8_t) (Id * 131u + i * 7u);
+	}
+	memset(&Info, 0, sizeof(Info));
+	Info.Size = Size;
+	Info.numTaps = (uint16_t) Id;
+	if (CoeffStore_save(&Info, Data) == 0) {
+		return 0;
+	}
+	for (i = 0; (i < Steps) && CoeffStore_busy(); i++) {
+		CoeffStore_idle();
+	}
+	return 1;
+}
+/*****************************************************************************/
+/*  End         : Test_save                                                  */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Test_check                                                 */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Checks that the newest record is Id with its data          */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : Id         Record expected                                 */
+/*                Size       Bytes of data                                   */
+/*                                                                           */
+/*  Output Para : Return     0 if it is, 1 if not                            */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static int Test_check(uint32_t Id, uint32_t Size) {
+
+	/* procedure data */
+	const CoeffStoreHeader *pRecord = CoeffStore_latest();
+	const uint8_t *pData;
+	uint32_t i;
+
+	/* procedure code */
+	if ((pRecord == 0) || (pRecord->numTaps != Id) || (pRecord->Size != Size)) {
+		return 1;
+	}
+	pData = (const uint8_t *) ((const uint32_t *) pRecord +
+			COEFF_STORE_HEADER_WORDS);
+	for (i = 0; i < Size; i++) {
+		if (pData[i] != (uint8_t) (Id * 131u + i * 7u)) {
+			return 1;
+		}
+	}
+	return 0;
+}
+/*****************************************************************************/
+/*  End         : Test_check                                                 */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : CoeffStoreTest                                             */
+/*****************************************************************************/
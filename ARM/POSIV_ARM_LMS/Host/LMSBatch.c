@@ -0,0 +1,204 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : LMSBatch (host)                                Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Q15 LMS for LMS_BATCH_LANES channels of equal length.       */
+/*                                                                           */
+/*               Coefficients and delay lines of all channels are            */
+/*               interleaved (structure of arrays), tap t of channel c is    */
+/*               at [t * LMS_BATCH_LANES + c]. Every inner loop runs over    */
+/*               the lanes, so the compiler turns it into a few wide vector  */
+/*               instructions instead of one short reduction per channel.    */
+/*               Samples are interleaved the same way, [n][LMS_BATCH_LANES]. */
+/*                                                                           */
+/*               The arithmetic is that of arm_lms_q15() for Cortex-M4:      */
+/*               64 bit accumulator, wrapping error, truncating alpha and    */
+/*               saturating update, so every lane gives bit exact the same   */
+/*               output as one arm_lms_q15() instance.                       */
+/*                                                                           */
+/*               On x86-64 Linux, GCC builds the kernel for AVX-512, AVX2,   */
+/*               SSE4.2 and plain x86-64 (x86-64-v4 ... v1) and selects the  */
+/*               best at load time (LMS_BATCH_DISPATCH). It is a host module */
+/*               for many channels on a PC (like ChannelServer.c), the board */
+/*               runs one canceller. LMSBatchBench.c checks it against       */
+/*               arm_lms_q15() and measures the speedup.                     */
+/*                                                                           */
+/*  Procedures : LMSBatch_init_q15()                                         */
+/*               LMSBatch_q15()                                              */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSBatch.c                                                  */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "LMSBatch.h"
+
+/* module constant declaration */
+
+/* Runtime CPU dispatch of the kernel (host builds only) */
+#if defined(__GNUC__) && (__GNUC__ >= 12) && !defined(__clang__) && \
+	defined(__x86_64__) && defined(__linux__)
+#define LMS_BATCH_DISPATCH __attribute__((target_clones("arch=x86-64-v4", \
+	"arch=x86-64-v3", "arch=x86-64-v2", "default")))
+#else
+#define LMS_BATCH_DISPATCH
+#endif
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+
+/*****************************************************************************/
+/*  Procedure   : LMSBatch_init_q15                                          */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Initializes a batch instance. The state is cleared, the    */
+/*                coefficients are left as they are (as arm_lms_init_q15)    */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance to initialize                          */
+/*                numTaps    Number of filter coefficients per channel       */
+/*                pCoeffs    Coefficient buffer [numTaps * LMS_BATCH_LANES]  */
+/*                pState     State buffer                                    */
+/*                           [(numTaps + blockSize - 1) * LMS_BATCH_LANES]   */
+/*                Mu         Step size (Q15) of all lanes, may be changed    */
+/*                           per lane in S->Mu afterwards                    */
+/*                blockSize  Number of samples per call                      */
+/*                postShift  Shift of filter output, as for arm_lms_q15      */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void LMSBatch_init_q15(LMSBatchInstanceQ15 *S, uint16_t numTaps,
+		q15_t *pCoeffs, q15_t *pState, q15_t Mu, uint32_t blockSize,
+		uint8_t postShift) {
+
+	/* procedure data */
+	uint32_t c;
+
+	/* procedure code */
+	S->numTaps = numTaps;
+	S->pCoeffs = pCoeffs;
+	S->pState = pState;
+	S->postShift = postShift;
+	for (c = 0; c < LMS_BATCH_LANES; c++) {
+		S->Mu[c] = Mu;
+	}
+
+	memset(pState, 0, (numTaps + (blockSize - 1u)) * LMS_BATCH_LANES * sizeof(q15_t));
+}
+/*****************************************************************************/
+/*  End         : LMSBatch_init_q15                                          */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSBatch_q15                                               */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Filters one block of all lanes and adapts the coefficients */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Input (reference) samples                       */
+/*                           [blockSize][LMS_BATCH_LANES]                    */
+/*                pRef       Desired samples, as pSrc                        */
+/*                blockSize  Number of samples per lane                      */
+/*                                                                           */
+/*  Output Para : pOut       Filter output, as pSrc                          */
+/*                pErr       Error, as pSrc                                  */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+LMS_BATCH_DISPATCH
+void LMSBatch_q15(LMSBatchInstanceQ15 *S, q15_t *pSrc, q15_t *pRef,
+		q15_t *pOut, q15_t *pErr, uint32_t blockSize) {
+
+	/* procedure data */
+	q63_t Acc[LMS_BATCH_LANES];
+	q31_t Alpha[LMS_BATCH_LANES];
+	q31_t Coef;
+	q31_t Out;
+	q15_t *pState = S->pState;
+	q15_t *pCoeffs = S->pCoeffs;
+	q15_t *px;
+	q15_t *pb;
+	uint32_t numTaps = S->numTaps;
+	int32_t lShift = 15 - (int32_t) S->postShift;
+	uint32_t n;
+	uint32_t t;
+	uint32_t c;
+
+	/* procedure code */
+	for (n = 0; n < blockSize; n++) {
+
+		/* New input samples into the state buffer */
+		memcpy(&pState[(numTaps - 1u + n) * LMS_BATCH_LANES],
+				&pSrc[n * LMS_BATCH_LANES], LMS_BATCH_LANES * sizeof(q15_t));
+
+		/* Filter */
+		for (c = 0; c < LMS_BATCH_LANES; c++) {
+			Acc[c] = 0;
+		}
+		px = &pState[n * LMS_BATCH_LANES];
+		pb = pCoeffs;
+		for (t = 0; t < numTaps; t++) {
+			for (c = 0; c < LMS_BATCH_LANES; c++) {
+				Acc[c] += (q31_t) px[c] * pb[c];
+			}
+			px += LMS_BATCH_LANES;
+			pb += LMS_BATCH_LANES;
+		}
+
+		/* Output, error and alpha as in arm_lms_q15() */
+		for (c = 0; c < LMS_BATCH_LANES; c++) {
+			Out = (q31_t) (Acc[c] >> lShift);
+			Out = (Out > 32767) ? 32767 : ((Out < -32768) ? -32768 : Out);
+			pOut[n * LMS_BATCH_LANES + c] = (q15_t) Out;
+			pErr[n * LMS_BATCH_LANES + c] = (q15_t) (pRef[n * LMS_BATCH_LANES + c] - Out);
+			Alpha[c] = (q15_t) (((q31_t) pErr[n * LMS_BATCH_LANES + c] * S->Mu[c]) >> 15);
+		}
+
+		/* Coefficient update */
+		px = &pState[n * LMS_BATCH_LANES];
+		pb = pCoeffs;
+		for (t = 0; t < numTaps; t++) {
+			for (c = 0; c < LMS_BATCH_LANES; c++) {
+				Coef = pb[c] + ((Alpha[c] * px[c]) >> 15);
+				pb[c] = (q15_t) ((Coef > 32767) ? 32767 : ((Coef < -32768) ? -32768 : Coef));
+			}
+			px += LMS_BATCH_LANES;
+			pb += LMS_BATCH_LANES;
+		}
+	}
+
+	/* Keep the last numTaps - 1 samples for the next block */
+	memmove(pState, &pState[blockSize * LMS_BATCH_LANES],
+			(numTaps - 1u) * LMS_BATCH_LANES * sizeof(q15_t));
+}
+/*****************************************************************************/
+/*  End         : LMSBatch_q15                                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : LMSBatch                                                   */
+/*****************************************************************************/
@@ -0,0 +1,56 @@
+#ifndef LMSBATCH_H
+#define LMSBATCH_H
+/*****************************************************************************/
+/*  Header     : LMSBatch (host)                                Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Q15 LMS for LMS_BATCH_LANES channels of equal length in one */
+/*               pass, bit exact with arm_lms_q15() (Cortex-M4 code) per     */
+/*               channel                                                     */
+/*                                                                           */
+/*  Procedures : LMSBatch_init_q15()                                         */
+/*               LMSBatch_q15()                                              */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSBatch.h                                                  */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "arm_math.h"
+
+/* module constant declaration  */
+
+/* Number of channels processed together (lanes of one vector pass) */
+#define LMS_BATCH_LANES 8
+
+/* module type declaration      */
+
+typedef struct
+{
+	uint16_t numTaps;
+	q15_t *pCoeffs;    /* [numTaps][LMS_BATCH_LANES]                 */
+	q15_t *pState;     /* [numTaps + blockSize - 1][LMS_BATCH_LANES] */
+	q15_t Mu[LMS_BATCH_LANES];
+	uint8_t postShift;
+} LMSBatchInstanceQ15;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+void LMSBatch_init_q15(LMSBatchInstanceQ15 *S, uint16_t numTaps,
+		q15_t *pCoeffs, q15_t *pState, q15_t Mu, uint32_t blockSize,
+		uint8_t postShift);
+void LMSBatch_q15(LMSBatchInstanceQ15 *S, q15_t *pSrc, q15_t *pRef,
+		q15_t *pOut, q15_t *pErr, uint32_t blockSize);
+
+/*****************************************************************************/
+/*  End Header  : LMSBatch                                                   */
+/*****************************************************************************/
+#endif
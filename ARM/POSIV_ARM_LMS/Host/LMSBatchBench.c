@@ -0,0 +1,331 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : LMSBatchBench (host)                           Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Checks the batched Q15 LMS (LMSBatch.c) against             */
+/*               LMS_BATCH_LANES instances of arm_lms_q15() and compares     */
+/*               their speed.                                                */
+/*                                                                           */
+/*               Every lane gets its own reference (white noise) and an echo */
+/*               of it through its own decaying random path, plus noise.     */
+/*               The lanes have different step sizes.                        */
+/*               1. Bit exactness: every output and error sample and the     */
+/*                  final coefficients of every lane must equal those of     */
+/*                  its arm_lms_q15() instance, else the exit code is 1.     */
+/*               2. Speed: time of one batch pass against the eight scalar   */
+/*                  calls, both over the same blocks.                        */
+/*                                                                           */
+/*               Build (from this directory):                                */
+/*               gcc -O3 -DARM_MATH_CM4 -I. -I../src                         */
+/*                   -I../Libraries/CMSIS/Include -o lmsbatchbench           */
+/*                   LMSBatchBench.c LMSBatch.c                              */
+/*                   ../Libraries/CMSIS/DSP_Lib/Source/FilteringFunctions/   */
+/*                   arm_lms_q15.c                                           */
+/*                   ../Libraries/CMSIS/DSP_Lib/Source/FilteringFunctions/   */
+/*                   arm_lms_init_q15.c                                      */
+/*                                                                           */
+/*               Options:                                                    */
+/*               -taps n      Filter length per lane (1700)                  */
+/*               -block n     Samples per call (4)                           */
+/*               -samples n   Samples per lane (16000, 2s at 8kHz)           */
+/*                                                                           */
+/*  Procedures : main()                                                      */
+/*               Bench_signals()                                             */
+/*               Bench_random()                                              */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSBatchBench.c                                             */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "LMSBatch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* module constant declaration */
+
+/* Step sizes (Q15) of the lanes, lane c uses BENCH_MU << (c % 4) */
+#define BENCH_MU 8
+
+/* Output shift, as the firmware (arm_lms_init_q15()) */
+#define BENCH_POST_SHIFT 0
+
+/* module type declaration */
+
+/* module data declaration */
+
+static uint32_t Seed = 1;
+
+/* module procedure declaration */
+static void Bench_signals(q15_t *pSrc, q15_t *pRef, uint32_t numTaps,
+		uint32_t numSamples);
+static int32_t Bench_random(void);
+
+/*****************************************************************************/
+/*  Procedure   : main                                                       */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Parses the options, runs both versions and compares them   */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : argc, argv Options, see module header                      */
+/*                                                                           */
+/*  Output Para : Return     0 if bit exact, 1 if not, 2 error               */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+int main(int argc, char *argv[]) {
+
+	/* procedure data */
+	arm_lms_instance_q15 Scalar[LMS_BATCH_LANES];
+	LMSBatchInstanceQ15 Batch;
+	q15_t *pSrc;
+	q15_t *pRef;
+	q15_t *pOut;
+	q15_t *pErr;
+	q15_t *pCoeffs;
+	q15_t *pState;
+	q15_t *pLane;
+	q15_t *pBatchCoeffs;
+	q15_t *pBatchState;
+	q15_t *pBatchOut;
+	q15_t *pBatchErr;
+	uint32_t numTaps = 1700;
+	uint32_t blockSize = 4;
+	uint32_t numSamples = 16000;
+	uint32_t Blocks;
+	uint32_t Errors = 0;
+	uint32_t c, i, n;
+	struct timespec Start;
+	struct timespec End;
+	double ScalarTime;
+	double BatchTime;
+	int a;
+
+	/* procedure code */
+	for (a = 1; a < argc; a++) {
+		if (a + 1 >= argc) {
+			fprintf(stderr, "Missing value of %s\n", argv[a]);
+			return 2;
+		} else if (strcmp(argv[a], "-taps") == 0) {
+			numTaps = (uint32_t) atol(argv[++a]);
+		} else if (strcmp(argv[a], "-block") == 0) {
+			blockSize = (uint32_t) atol(argv[++a]);
+		} else if (strcmp(argv[a], "-samples") == 0) {
+			numSamples = (uint32_t) atol(argv[++a]);
+		} else {
+			fprintf(stderr, "Unknown option %s\n", argv[a]);
+			return 2;
+		}
+	}
+	if ((numTaps < 4u) || (numTaps > 65535u) || (blockSize == 0) ||
+			(numSamples < blockSize)) {
+		fprintf(stderr, "Invalid option value\n");
+		return 2;
+	}
+	Blocks = numSamples / blockSize;
+	numSamples = Blocks * blockSize;
+
+	/* Signals and results, interleaved [n][LMS_BATCH_LANES] */
+	pSrc = (q15_t *) malloc(4u * numSamples * LMS_BATCH_LANES * sizeof(q15_t));
+	pBatchOut = (q15_t *) malloc(2u * numSamples * LMS_BATCH_LANES *
+			sizeof(q15_t));
+	pCoeffs = (q15_t *) calloc(2u * numTaps * LMS_BATCH_LANES, sizeof(q15_t));
+	pState = (q15_t *) malloc(2u * (numTaps + blockSize - 1u) *
+			LMS_BATCH_LANES * sizeof(q15_t));
+	pLane = (q15_t *) malloc(4u * blockSize * sizeof(q15_t));
+	if ((pSrc == 0) || (pBatchOut == 0) || (pCoeffs == 0) || (pState == 0) ||
+			(pLane == 0)) {
+		fprintf(stderr, "Out of memory\n");
+		return 2;
+	}
+	pRef = pSrc + numSamples * LMS_BATCH_LANES;
+	pOut = pRef + numSamples * LMS_BATCH_LANES;
+	pErr = pOut + numSamples * LMS_BATCH_LANES;
+	pBatchErr = pBatchOut + numSamples * LMS_BATCH_LANES;
+	pBatchCoeffs = pCoeffs + numTaps * LMS_BATCH_LANES;
+	pBatchState = pState + (numTaps + blockSize - 1u) * LMS_BATCH_LANES;
+	Bench_signals(pSrc, pRef, numTaps, numSamples);
+
+	/* arm_lms_q15() per lane, block by block like the batch */
+	for (c = 0; c < LMS_BATCH_LANES; c++) {
+		arm_lms_init_q15(&Scalar[c], (uint16_t) numTaps, &pCoeffs[c * numTaps],
+				&pState[c * (numTaps + blockSize - 1u)],
+				(q15_t) (BENCH_MU << (c % 4u)), blockSize, BENCH_POST_SHIFT);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &Start);
+	for (n = 0; n < Blocks; n++) {
+		for (c = 0; c < LMS_BATCH_LANES; c++) {
+			for (i = 0; i < blockSize; i++) {
+				pLane[i] = pSrc[(n * blockSize + i) * LMS_BATCH_LANES + c];
+				pLane[blockSize + i] =
+						pRef[(n * blockSize + i) * LMS_BATCH_LANES + c];
+			}
+			arm_lms_q15(&Scalar[c], pLane, &pLane[blockSize],
+					&pLane[2u * blockSize], &pLane[3u * blockSize], blockSize);
+			for (i = 0; i < blockSize; i++) {
+				pOut[(n * blockSize + i) * LMS_BATCH_LANES + c] =
+						pLane[2u * blockSize + i];
+				pErr[(n * blockSize + i) * LMS_BATCH_LANES + c] =
+						pLane[3u * blockSize + i];
+			}
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &End);
+	ScalarTime = (End.tv_sec - Start.tv_sec) +
+			1e-9 * (End.tv_nsec - Start.tv_nsec);
+
+	/* All lanes in one pass */
+	LMSBatch_init_q15(&Batch, (uint16_t) numTaps, pBatchCoeffs, pBatchState,
+			BENCH_MU, blockSize, BENCH_POST_SHIFT);
+	for (c = 0; c < LMS_BATCH_LANES; c++) {
+		Batch.Mu[c] = (q15_t) (BENCH_MU << (c % 4u));
+	}
+	clock_gettime(CLOCK_MONOTONIC, &Start);
+	for (n = 0; n < Blocks; n++) {
+		i = n * blockSize * LMS_BATCH_LANES;
+		LMSBatch_q15(&Batch, &pSrc[i], &pRef[i], &pBatchOut[i], &pBatchErr[i],
+				blockSize);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &End);
+	BatchTime = (End.tv_sec - Start.tv_sec) +
+			1e-9 * (End.tv_nsec - Start.tv_nsec);
+
+	/* 1. Bit exactness */
+	for (i = 0; i < numSamples * LMS_BATCH_LANES; i++) {
+		if ((pOut[i] != pBatchOut[i]) || (pErr[i] != pBatchErr[i])) {
+			Errors++;
+		}
+	}
+	for (c = 0; c < LMS_BATCH_LANES; c++) {
+		for (i = 0; i < numTaps; i++) {
+			if (pCoeffs[c * numTaps + i] !=
+					pBatchCoeffs[i * LMS_BATCH_LANES + c]) {
+				Errors++;
+			}
+		}
+	}
+	printf("%u lanes, %u taps, block %u, %u samples per lane\n",
+			LMS_BATCH_LANES, numTaps, blockSize, numSamples);
+	printf("Bit exact       %s (%u differences)\n", Errors ? "FAIL" : "ok",
+			Errors);
+
+	/* 2. Speed */
+	printf("arm_lms_q15 x %u %8.1f us per block\n", LMS_BATCH_LANES,
+			1e6 * ScalarTime / Blocks);
+	printf("LMSBatch_q15    %8.1f us per block, speedup %.2f\n",
+			1e6 * BatchTime / Blocks, ScalarTime / BatchTime);
+
+	free(pSrc);
+	free(pBatchOut);
+	free(pCoeffs);
+	free(pState);
+	free(pLane);
+	return Errors ? 1 : 0;
+}
+/*****************************************************************************/
+/*  End         : main                                                       */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Bench_signals                                              */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Reference of every lane (white noise, -10dBFS) and its     */
+/*                echo through a random path decaying over the taps, plus    */
+/*                noise at -60dBFS                                           */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : numTaps    Length of the echo paths                        */
+/*                numSamples Samples per lane                                */
+/*                                                                           */
+/*  Output Para : pSrc       Reference [numSamples][LMS_BATCH_LANES]         */
+/*                pRef       Microphone, as pSrc                             */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Bench_signals(q15_t *pSrc, q15_t *pRef, uint32_t numTaps,
+		uint32_t numSamples) {
+
+	/* procedure data */
+	float32_t *pPath;
+	float32_t Echo;
+	float32_t Gain;
+	uint32_t c, i, t;
+
+	/* procedure code */
+	pPath = (float32_t *) malloc(numTaps * sizeof(float32_t));
+	for (c = 0; c < LMS_BATCH_LANES; c++) {
+		Gain = 0.5f;
+		for (t = 0; t < numTaps; t++) {
+			pPath[t] = Gain * (float32_t) Bench_random() / 32768.0f;
+			Gain *= 1.0f - 8.0f / numTaps;
+		}
+		for (i = 0; i < numSamples; i++) {
+			pSrc[i * LMS_BATCH_LANES + c] = (q15_t) (Bench_random() / 3);
+		}
+		for (i = 0; i < numSamples; i++) {
+			Echo = (float32_t) (Bench_random() / 1000);
+			for (t = 0; (t < numTaps) && (t <= i); t++) {
+				Echo += pPath[t] * pSrc[(i - t) * LMS_BATCH_LANES + c];
+			}
+			Echo = (Echo > 32767.0f) ? 32767.0f :
+					((Echo < -32768.0f) ? -32768.0f : Echo);
+			pRef[i * LMS_BATCH_LANES + c] = (q15_t) Echo;
+		}
+	}
+	free(pPath);
+}
+/*****************************************************************************/
+/*  End         : Bench_signals                                              */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Bench_random                                               */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Uniform pseudo random number, the same on every run        */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : Return     -32768 ... 32767                                */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static int32_t Bench_random(void) {
+
+	/* procedure code */
+	Seed = Seed * 1664525u + 1013904223u;
+	return (int32_t) (Seed >> 16) - 32768;
+}
+/*****************************************************************************/
+/*  End         : Bench_random                                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : LMSBatchBench                                              */
+/*****************************************************************************/
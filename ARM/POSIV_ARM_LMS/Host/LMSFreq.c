@@ -0,0 +1,764 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : LMSFreq (host)                                 Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Partitioned block frequency domain LMS (multidelay filter)  */
+/*               for long echo tails, e.g. 500ms at 16kHz (8192 taps) or     */
+/*               48kHz (24576 taps).                                         */
+/*                                                                           */
+/*               The filter is split into K partitions of P taps. Each block */
+/*               of P samples costs three real FFTs of length 2P (input,     */
+/*               output, error) plus one FFT pair for the gradient           */
+/*               constraint, and about 2K(P + 1) complex multiply-adds. Per  */
+/*               sample this is O(K + log P) instead of the O(KP) of the     */
+/*               time domain LMS, at the price of a delay of P samples.      */
+/*                                                                           */
+/*               Overlap-save with frames [previous block, new block].       */
+/*               Only the P + 1 bins up to FS/2 are computed (RealFft.c).    */
+/*               The spectra are stored in cache blocks of blockBins bins,   */
+/*               partition after partition, real and imaginary parts apart:  */
+/*               the filter and update loops run over all partitions of one  */
+/*               block with the accumulators of the block in the L1 cache,   */
+/*               and stream through the spectra once per FFT block. The      */
+/*               input spectra are a ring (Head), nothing is shifted. Bin P  */
+/*               is real and kept apart.                                     */
+/*                                                                           */
+/*               The cache blocks are independent, LMSFreq_start_f32() runs  */
+/*               the loops over the partitions on several threads, each      */
+/*               with its own share of the blocks.                           */
+/*                                                                           */
+/*               The step of every bin is normalized to the input energy of  */
+/*               the whole filter, the sum of |X(k)|^2 over all partitions   */
+/*               (running sum, recomputed once per turn of the ring). The    */
+/*               gradient constraint (filter taps beyond P of a partition    */
+/*               set to zero) is applied to one partition per block in       */
+/*               turn, which keeps the filter close to the constrained       */
+/*               solution at a fraction of the cost.                         */
+/*                                                                           */
+/*               The samples are Q15 as on the board, LMS_METRICS of         */
+/*               EchoCanceller.h enables the metrics of LMSMetrics.c.        */
+/*                                                                           */
+/*  Procedures : LMSFreq_init_f32()                                          */
+/*               LMSFreq_start_f32()                                         */
+/*               LMSFreq_stop_f32()                                          */
+/*               LMSFreq_f32()                                               */
+/*               LMSFreq_report()                                            */
+/*               LMSFreq_run()                                               */
+/*               LMSFreq_helper()                                            */
+/*               LMSFreq_stage()                                             */
+/*               LMSFreq_filter()                                            */
+/*               LMSFreq_update()                                            */
+/*               LMSFreq_constrain()                                         */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSFreq.c                                                   */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "LMSFreq.h"
+#include <string.h>
+
+/* module constant declaration */
+
+/* Loops over the partitions */
+#define LMS_FREQ_FILTER 0
+#define LMS_FREQ_UPDATE 1
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+static void LMSFreq_run(LMSFreqInstanceF32 *S, uint32_t Stage);
+static void *LMSFreq_helper(void *pArg);
+static void LMSFreq_stage(LMSFreqInstanceF32 *S, uint32_t Stage,
+		uint32_t Thread);
+static void LMSFreq_filter(LMSFreqInstanceF32 *S, uint32_t First,
+		uint32_t End);
+static void LMSFreq_update(LMSFreqInstanceF32 *S, uint32_t First,
+		uint32_t End);
+static void LMSFreq_constrain(LMSFreqInstanceF32 *S);
+
+/*****************************************************************************/
+/*  Procedure   : LMSFreq_init_f32                                           */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Initializes the filter in the given memory (all cleared),  */
+/*                single threaded                                            */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance to initialize                          */
+/*                numTaps    Number of filter coefficients                   */
+/*                blockSize  Samples per call (16 ... 2048, power of 2)      */
+/*                pMemory    Memory [LMS_FREQ_MEMORY(numTaps, blockSize)]    */
+/*                                                                           */
+/*  Output Para : Return     ARM_MATH_ARGUMENT_ERROR if blockSize or numTaps */
+/*                           is not supported                                */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+arm_status LMSFreq_init_f32(LMSFreqInstanceF32 *S, uint32_t numTaps,
+		uint16_t blockSize, float32_t *pMemory) {
+
+	/* procedure data */
+	uint32_t numPartitions;
+
+	/* procedure code */
+	numPartitions = LMS_FREQ_PARTITIONS(numTaps, blockSize);
+	if ((blockSize < 16u) || (blockSize > 2048u) ||
+			((blockSize & (blockSize - 1u)) != 0) || (numTaps == 0) ||
+			(numPartitions > UINT16_MAX)) {
+		return ARM_MATH_ARGUMENT_ERROR;
+	}
+	memset(S, 0, sizeof(*S));
+	S->blockSize = blockSize;
+	S->numPartitions = (uint16_t) numPartitions;
+	S->blockBins = (blockSize < LMS_FREQ_BLOCK_BINS) ? blockSize :
+			LMS_FREQ_BLOCK_BINS;
+	S->numBlocks = (uint16_t) (blockSize / S->blockBins);
+	S->Mu = LMS_FREQ_MU;
+	S->Pool.numThreads = 1;
+
+	memset(pMemory, 0, LMS_FREQ_MEMORY(numTaps, blockSize) * sizeof(float32_t));
+	S->pX = pMemory;
+	pMemory += 2u * numPartitions * blockSize;
+	S->pW = pMemory;
+	pMemory += 2u * numPartitions * blockSize;
+	S->pXNyquist = pMemory;
+	pMemory += numPartitions;
+	S->pWNyquist = pMemory;
+	pMemory += numPartitions;
+	S->pPower = pMemory;
+	pMemory += blockSize + 1u;
+	S->pFrame = pMemory;
+	pMemory += 2u * blockSize;
+	S->pWork = pMemory;
+	pMemory += 2u * blockSize + 2u;
+
+#if LMS_METRICS
+	LMSMetrics_init_q15(&S->Metrics);
+#endif
+	return RealFft_init_f32(&S->Fft, 2u * blockSize, pMemory);
+}
+/*****************************************************************************/
+/*  End         : LMSFreq_init_f32                                           */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSFreq_start_f32                                          */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Shares the loops over the partitions with helper threads   */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                numThreads Threads including the caller of LMSFreq_f32()   */
+/*                           (1 ... LMS_FREQ_THREADS_MAX), more than the     */
+/*                           cache blocks leave threads without work         */
+/*                                                                           */
+/*  Output Para : Return     0, or -1 if a thread can not be created (the    */
+/*                           instance stays single threaded)                 */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+int LMSFreq_start_f32(LMSFreqInstanceF32 *S, uint32_t numThreads) {
+
+	/* procedure data */
+	LMSFreqPool *pPool = &S->Pool;
+	uint32_t i;
+
+	/* procedure code */
+	if ((numThreads == 0) || (numThreads > LMS_FREQ_THREADS_MAX) ||
+			(pPool->numThreads > 1)) {
+		return -1;
+	}
+	if (numThreads == 1) {
+		return 0;
+	}
+	pthread_mutex_init(&pPool->Lock, 0);
+	pthread_cond_init(&pPool->Start, 0);
+	pthread_cond_init(&pPool->Done, 0);
+	pPool->Stop = 0;
+	pPool->Generation = 0;
+	pPool->Pending = 0;
+
+	for (i = 1; i < numThreads; i++) {
+		pPool->Threads[i].S = S;
+		pPool->Threads[i].Index = i;
+		if (pthread_create(&pPool->Threads[i].Thread, 0, LMSFreq_helper,
+				&pPool->Threads[i]) != 0) {
+			pPool->numThreads = i;
+			LMSFreq_stop_f32(S);
+			return -1;
+		}
+	}
+	pPool->numThreads = numThreads;
+	return 0;
+}
+/*****************************************************************************/
+/*  End         : LMSFreq_start_f32                                          */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSFreq_stop_f32                                           */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Joins the helper threads, the instance is single threaded  */
+/*                again                                                      */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void LMSFreq_stop_f32(LMSFreqInstanceF32 *S) {
+
+	/* procedure data */
+	LMSFreqPool *pPool = &S->Pool;
+	uint32_t i;
+
+	/* procedure code */
+	if (pPool->numThreads <= 1) {
+		return;
+	}
+	pthread_mutex_lock(&pPool->Lock);
+	pPool->Stop = 1;
+	pthread_cond_broadcast(&pPool->Start);
+	pthread_mutex_unlock(&pPool->Lock);
+	for (i = 1; i < pPool->numThreads; i++) {
+		pthread_join(pPool->Threads[i].Thread, 0);
+	}
+	pthread_cond_destroy(&pPool->Start);
+	pthread_cond_destroy(&pPool->Done);
+	pthread_mutex_destroy(&pPool->Lock);
+	pPool->numThreads = 1;
+}
+/*****************************************************************************/
+/*  End         : LMSFreq_stop_f32                                           */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSFreq_f32                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Cancels the echo of one block of S->blockSize samples      */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Input (reference) samples [blockSize]           */
+/*                pRef       Desired (microphone) samples [blockSize]        */
+/*                                                                           */
+/*  Output Para : pErr       Error samples [blockSize]                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void LMSFreq_f32(LMSFreqInstanceF32 *S, q15_t *pSrc, q15_t *pRef,
+		q15_t *pErr) {
+
+	/* procedure data */
+	uint32_t P = S->blockSize;
+	uint32_t K = S->numPartitions;
+	float32_t *pWork = S->pWork;
+	float32_t Error;
+	uint32_t f;
+
+	/* procedure code */
+
+	/* Input frame [previous block, new block] and its spectrum */
+	memcpy(S->pFrame, &S->pFrame[P], P * sizeof(float32_t));
+	for (f = 0; f < P; f++) {
+		S->pFrame[P + f] = pSrc[f] * (1.0f / 32768.0f);
+	}
+	RealFft_forward_f32(&S->Fft, S->pFrame, pWork);
+
+	/* The new spectrum replaces the oldest one, filter output */
+	S->Head = (uint16_t) ((S->Head + K - 1u) % K);
+	LMSFreq_run(S, LMS_FREQ_FILTER);
+	RealFft_inverse_f32(&S->Fft, pWork, pWork);
+
+	/* Error, the last P samples of the frame are valid */
+	for (f = 0; f < P; f++) {
+		Error = pRef[f] - pWork[P + f] * 32768.0f;
+		Error = (Error > 32767.0f) ? 32767.0f :
+				((Error < -32768.0f) ? -32768.0f : Error);
+		pErr[f] = (q15_t) Error;
+	}
+
+	/* Error spectrum of [0, e], update with the normalized step */
+	memset(pWork, 0, P * sizeof(float32_t));
+	for (f = 0; f < P; f++) {
+		pWork[P + f] = pErr[f] * (1.0f / 32768.0f);
+	}
+	RealFft_forward_f32(&S->Fft, pWork, pWork);
+	LMSFreq_run(S, LMS_FREQ_UPDATE);
+
+	LMSFreq_constrain(S);
+
+#if LMS_METRICS
+	LMSMetrics_q15(&S->Metrics, pSrc, pRef, pErr, P);
+#endif
+}
+/*****************************************************************************/
+/*  End         : LMSFreq_f32                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSFreq_report                                             */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Metrics of the filter as EchoCanceller_report()            */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                                                                           */
+/*  Output Para : pReport    Metrics, cleared if LMS_METRICS is off. Times   */
+/*                           are in samples / FS of config.h                 */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void LMSFreq_report(LMSFreqInstanceF32 *S, LMSMetricsReport *pReport) {
+
+	/* procedure code */
+#if LMS_METRICS
+	LMSMetrics_report(&S->Metrics, pReport);
+#else
+	(void) S;
+	memset(pReport, 0, sizeof(*pReport));
+#endif
+}
+/*****************************************************************************/
+/*  End         : LMSFreq_report                                             */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSFreq_run                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Runs a loop over the partitions on all threads and waits   */
+/*                for its end                                                */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                Stage      LMS_FREQ_FILTER or LMS_FREQ_UPDATE              */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void LMSFreq_run(LMSFreqInstanceF32 *S, uint32_t Stage) {
+
+	/* procedure data */
+	LMSFreqPool *pPool = &S->Pool;
+
+	/* procedure code */
+	if (pPool->numThreads > 1) {
+		pthread_mutex_lock(&pPool->Lock);
+		pPool->Stage = Stage;
+		pPool->Pending = pPool->numThreads - 1u;
+		pPool->Generation++;
+		pthread_cond_broadcast(&pPool->Start);
+		pthread_mutex_unlock(&pPool->Lock);
+	}
+
+	LMSFreq_stage(S, Stage, 0);
+
+	if (pPool->numThreads > 1) {
+		pthread_mutex_lock(&pPool->Lock);
+		while (pPool->Pending > 0) {
+			pthread_cond_wait(&pPool->Done, &pPool->Lock);
+		}
+		pthread_mutex_unlock(&pPool->Lock);
+	}
+}
+/*****************************************************************************/
+/*  End         : LMSFreq_run                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSFreq_helper                                             */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Helper thread, runs its share of every loop started        */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pArg       LMSFreqThread                                   */
+/*                                                                           */
+/*  Output Para : Return     0                                               */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void *LMSFreq_helper(void *pArg) {
+
+	/* procedure data */
+	LMSFreqThread *pThread = (LMSFreqThread *) pArg;
+	LMSFreqInstanceF32 *S = pThread->S;
+	LMSFreqPool *pPool = &S->Pool;
+	uint32_t Generation;
+	uint32_t Stage;
+
+	/* procedure code */
+	/* Reset by LMSFreq_start_f32(), a loop may start before this thread */
+	Generation = 0;
+	pthread_mutex_lock(&pPool->Lock);
+	for (;;) {
+		while ((pPool->Generation == Generation) && !pPool->Stop) {
+			pthread_cond_wait(&pPool->Start, &pPool->Lock);
+		}
+		if (pPool->Stop) {
+			break;
+		}
+		Generation = pPool->Generation;
+		Stage = pPool->Stage;
+		pthread_mutex_unlock(&pPool->Lock);
+
+		LMSFreq_stage(S, Stage, pThread->Index);
+
+		pthread_mutex_lock(&pPool->Lock);
+		if (--pPool->Pending == 0) {
+			pthread_cond_signal(&pPool->Done);
+		}
+	}
+	pthread_mutex_unlock(&pPool->Lock);
+	return 0;
+}
+/*****************************************************************************/
+/*  End         : LMSFreq_helper                                             */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSFreq_stage                                              */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Runs the share of one thread of a loop                     */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                Stage      LMS_FREQ_FILTER or LMS_FREQ_UPDATE              */
+/*                Thread     Thread number, 0 = caller                       */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void LMSFreq_stage(LMSFreqInstanceF32 *S, uint32_t Stage,
+		uint32_t Thread) {
+
+	/* procedure data */
+	uint32_t First;
+	uint32_t End;
+
+	/* procedure code */
+	First = Thread * S->numBlocks / S->Pool.numThreads;
+	End = (Thread + 1u) * S->numBlocks / S->Pool.numThreads;
+	if (Stage == LMS_FREQ_FILTER) {
+		LMSFreq_filter(S, First, End);
+	} else {
+		LMSFreq_update(S, First, End);
+	}
+}
+/*****************************************************************************/
+/*  End         : LMSFreq_stage                                              */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSFreq_filter                                             */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Puts the new input spectrum into the ring and replaces it  */
+/*                by the filter output, the sum over the partitions of       */
+/*                X(k) W(k), for the cache blocks First ... End - 1. The     */
+/*                thread with the last block also does bin P.                */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Instance, S->pWork holds the input spectrum     */
+/*                First      First cache block                               */
+/*                End        Cache block after the last                      */
+/*                                                                           */
+/*  Output Para : None (output spectrum in S->pWork)                         */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void LMSFreq_filter(LMSFreqInstanceF32 *S, uint32_t First,
+		uint32_t End) {
+
+	/* procedure data */
+	uint32_t K = S->numPartitions;
+	uint32_t B = S->blockBins;
+	uint32_t P = S->blockSize;
+	float32_t Yr[LMS_FREQ_BLOCK_BINS];
+	float32_t Yi[LMS_FREQ_BLOCK_BINS];
+	float32_t *pSpectrum;
+	float32_t *pPower;
+	float32_t *pX;
+	float32_t *pW;
+	float32_t Re;
+	float32_t Im;
+	uint32_t Slot;
+	uint32_t b, j, k;
+
+	/* procedure code */
+	for (b = First; b < End; b++) {
+		pSpectrum = &S->pWork[2u * b * B];
+		pPower = &S->pPower[b * B];
+
+		/* The new spectrum replaces the oldest one in the ring */
+		pX = &S->pX[2u * (b * K + S->Head) * B];
+		for (j = 0; j < B; j++) {
+			Re = pSpectrum[2u * j];
+			Im = pSpectrum[2u * j + 1u];
+			pPower[j] += Re * Re + Im * Im -
+					pX[j] * pX[j] - pX[B + j] * pX[B + j];
+			pX[j] = Re;
+			pX[B + j] = Im;
+		}
+
+		/* Recompute the energy once per turn, against rounding drift */
+		if (S->Head == 0) {
+			memset(pPower, 0, B * sizeof(float32_t));
+			for (k = 0; k < K; k++) {
+				pX = &S->pX[2u * (b * K + k) * B];
+				for (j = 0; j < B; j++) {
+					pPower[j] += pX[j] * pX[j] + pX[B + j] * pX[B + j];
+				}
+			}
+		}
+
+		/* Sum over the partitions of X(k) * W(k) */
+		memset(Yr, 0, B * sizeof(float32_t));
+		memset(Yi, 0, B * sizeof(float32_t));
+		Slot = S->Head;
+		for (k = 0; k < K; k++) {
+			pX = &S->pX[2u * (b * K + Slot) * B];
+			pW = &S->pW[2u * (b * K + k) * B];
+			for (j = 0; j < B; j++) {
+				Yr[j] += pX[j] * pW[j] - pX[B + j] * pW[B + j];
+				Yi[j] += pX[j] * pW[B + j] + pX[B + j] * pW[j];
+			}
+			if (++Slot == K) {
+				Slot = 0;
+			}
+		}
+		for (j = 0; j < B; j++) {
+			pSpectrum[2u * j] = Yr[j];
+			pSpectrum[2u * j + 1u] = Yi[j];
+		}
+	}
+
+	/* Bin P, real */
+	if ((End == S->numBlocks) && (First < End)) {
+		Re = S->pWork[2u * P];
+		S->pPower[P] += Re * Re -
+				S->pXNyquist[S->Head] * S->pXNyquist[S->Head];
+		S->pXNyquist[S->Head] = Re;
+		if (S->Head == 0) {
+			S->pPower[P] = 0.0f;
+			for (k = 0; k < K; k++) {
+				S->pPower[P] += S->pXNyquist[k] * S->pXNyquist[k];
+			}
+		}
+		Re = 0.0f;
+		Slot = S->Head;
+		for (k = 0; k < K; k++) {
+			Re += S->pXNyquist[Slot] * S->pWNyquist[k];
+			if (++Slot == K) {
+				Slot = 0;
+			}
+		}
+		S->pWork[2u * P] = Re;
+		S->pWork[2u * P + 1u] = 0.0f;
+	}
+}
+/*****************************************************************************/
+/*  End         : LMSFreq_filter                                             */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSFreq_update                                             */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : W(k) += mu E conj(X(k)) / sum |X|^2 for the cache blocks   */
+/*                First ... End - 1. The thread with the last block also     */
+/*                does bin P.                                                */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Instance, S->pWork holds the error spectrum     */
+/*                First      First cache block                               */
+/*                End        Cache block after the last                      */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void LMSFreq_update(LMSFreqInstanceF32 *S, uint32_t First,
+		uint32_t End) {
+
+	/* procedure data */
+	uint32_t K = S->numPartitions;
+	uint32_t B = S->blockBins;
+	uint32_t P = S->blockSize;
+	float32_t Delta = 2.0f * P * K * LMS_FREQ_DELTA;
+	float32_t Er[LMS_FREQ_BLOCK_BINS];
+	float32_t Ei[LMS_FREQ_BLOCK_BINS];
+	float32_t *pSpectrum;
+	float32_t *pPower;
+	float32_t *pX;
+	float32_t *pW;
+	float32_t Scale;
+	uint32_t Slot;
+	uint32_t b, j, k;
+
+	/* procedure code */
+	for (b = First; b < End; b++) {
+		pSpectrum = &S->pWork[2u * b * B];
+		pPower = &S->pPower[b * B];
+
+		/* Normalized step per bin */
+		for (j = 0; j < B; j++) {
+			Scale = S->Mu / (pPower[j] + Delta);
+			Er[j] = pSpectrum[2u * j] * Scale;
+			Ei[j] = pSpectrum[2u * j + 1u] * Scale;
+		}
+
+		Slot = S->Head;
+		for (k = 0; k < K; k++) {
+			pX = &S->pX[2u * (b * K + Slot) * B];
+			pW = &S->pW[2u * (b * K + k) * B];
+			for (j = 0; j < B; j++) {
+				pW[j] += Er[j] * pX[j] + Ei[j] * pX[B + j];
+				pW[B + j] += Ei[j] * pX[j] - Er[j] * pX[B + j];
+			}
+			if (++Slot == K) {
+				Slot = 0;
+			}
+		}
+	}
+
+	/* Bin P, real */
+	if ((End == S->numBlocks) && (First < End)) {
+		Scale = S->Mu * S->pWork[2u * P] / (S->pPower[P] + Delta);
+		Slot = S->Head;
+		for (k = 0; k < K; k++) {
+			S->pWNyquist[k] += Scale * S->pXNyquist[Slot];
+			if (++Slot == K) {
+				Slot = 0;
+			}
+		}
+	}
+}
+/*****************************************************************************/
+/*  End         : LMSFreq_update                                             */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSFreq_constrain                                          */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Gradient constraint of the next partition in turn: only    */
+/*                its first P taps are kept                                  */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void LMSFreq_constrain(LMSFreqInstanceF32 *S) {
+
+	/* procedure data */
+	uint32_t K = S->numPartitions;
+	uint32_t B = S->blockBins;
+	uint32_t P = S->blockSize;
+	float32_t *pWork = S->pWork;
+	float32_t *pW;
+	uint32_t b, j;
+
+	/* procedure code */
+
+	/* Spectrum of the partition, out of the cache blocks */
+	for (b = 0; b < S->numBlocks; b++) {
+		pW = &S->pW[2u * (b * K + S->Constrain) * B];
+		for (j = 0; j < B; j++) {
+			pWork[2u * (b * B + j)] = pW[j];
+			pWork[2u * (b * B + j) + 1u] = pW[B + j];
+		}
+	}
+	pWork[2u * P] = S->pWNyquist[S->Constrain];
+	pWork[2u * P + 1u] = 0.0f;
+
+	RealFft_inverse_f32(&S->Fft, pWork, pWork);
+	memset(&pWork[P], 0, P * sizeof(float32_t));
+	RealFft_forward_f32(&S->Fft, pWork, pWork);
+
+	for (b = 0; b < S->numBlocks; b++) {
+		pW = &S->pW[2u * (b * K + S->Constrain) * B];
+		for (j = 0; j < B; j++) {
+			pW[j] = pWork[2u * (b * B + j)];
+			pW[B + j] = pWork[2u * (b * B + j) + 1u];
+		}
+	}
+	S->pWNyquist[S->Constrain] = pWork[2u * P];
+	S->Constrain = (uint16_t) ((S->Constrain + 1u) % K);
+}
+/*****************************************************************************/
+/*  End         : LMSFreq_constrain                                          */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : LMSFreq                                                    */
+/*****************************************************************************/
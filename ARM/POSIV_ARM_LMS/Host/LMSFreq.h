@@ -0,0 +1,128 @@
+#ifndef LMSFREQ_H
+#define LMSFREQ_H
+/*****************************************************************************/
+/*  Header     : LMSFreq (host)                                 Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Partitioned block frequency domain LMS (float32) for long   */
+/*               echo tails on a PC (10k to 50k taps at 16kHz ... 48kHz),    */
+/*               with the switches and metrics of the canceller of the       */
+/*               board (EchoCanceller.h, LMSMetrics.c)                       */
+/*                                                                           */
+/*  Procedures : LMSFreq_init_f32()                                          */
+/*               LMSFreq_start_f32()                                         */
+/*               LMSFreq_stop_f32()                                          */
+/*               LMSFreq_f32()                                               */
+/*               LMSFreq_report()                                            */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSFreq.h                                                   */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "EchoCanceller.h"
+#include "RealFft.h"
+#include <pthread.h>
+
+/* module constant declaration  */
+
+/* Normalized step size (1 = full NLMS step) */
+#define LMS_FREQ_MU 0.5f
+
+/* Regularization of the power estimate (-60dBFS per bin) */
+#define LMS_FREQ_DELTA 1e-6f
+
+/* Bins of a cache block: the filter and update loops run over all   */
+/* partitions of one block (64 bins, 512 bytes per partition) before */
+/* the next, the accumulators stay in the L1 cache                   */
+#define LMS_FREQ_BLOCK_BINS 64
+
+/* Threads of the partition loops at most */
+#define LMS_FREQ_THREADS_MAX 16
+
+/* Number of partitions of a filter with numTaps coefficients */
+#define LMS_FREQ_PARTITIONS(numTaps, blockSize) \
+	(((numTaps) + (blockSize) - 1) / (blockSize))
+
+/* Memory (number of float32_t) of a filter with numTaps coefficients   */
+/* processed in blocks of blockSize (16 ... 2048, power of 2) samples:  */
+/* input and filter spectra [K][2P + 1], energy [P + 1], frame [2P],    */
+/* work [2P + 2] and the FFT tables                                      */
+#define LMS_FREQ_MEMORY(numTaps, blockSize) \
+	(2 * LMS_FREQ_PARTITIONS(numTaps, blockSize) * (2 * (blockSize) + 1) + \
+	((blockSize) + 1) + 2 * (blockSize) + 2 * (blockSize) + 2 + \
+	REAL_FFT_MEMORY(2 * (blockSize)))
+
+/* module type declaration      */
+
+struct LMSFreqInstanceF32;
+
+/* Helper thread of the partition loops */
+typedef struct
+{
+	struct LMSFreqInstanceF32 *S;
+	pthread_t Thread;
+	uint32_t Index;
+} LMSFreqThread;
+
+/* Threads, the caller of LMSFreq_f32() is thread 0 */
+typedef struct
+{
+	uint32_t numThreads;
+	uint32_t Stage;           /* Loop to run                           */
+	uint32_t Generation;      /* Counts the loops started              */
+	uint32_t Pending;         /* Helpers still running the loop        */
+	uint8_t Stop;
+	pthread_mutex_t Lock;
+	pthread_cond_t Start;
+	pthread_cond_t Done;
+	LMSFreqThread Threads[LMS_FREQ_THREADS_MAX];
+} LMSFreqPool;
+
+typedef struct LMSFreqInstanceF32
+{
+	uint16_t blockSize;       /* Partition length P, FFT length 2P     */
+	uint16_t numPartitions;   /* K                                     */
+	uint16_t blockBins;       /* Bins of a cache block                 */
+	uint16_t numBlocks;       /* Cache blocks of bins 0 ... P - 1      */
+	uint16_t Head;            /* Partition of the newest input spectrum */
+	uint16_t Constrain;       /* Partition constrained next            */
+	float32_t Mu;
+	float32_t *pX;            /* Input spectra, bins 0 ... P - 1:      */
+	                          /* [block][K][re, im][blockBins]         */
+	float32_t *pW;            /* Filter spectra, same order            */
+	float32_t *pXNyquist;     /* Bin P of the input spectra [K] (real) */
+	float32_t *pWNyquist;     /* Bin P of the filter spectra [K]       */
+	float32_t *pPower;        /* Energy of X(0..K-1) per bin [P + 1]   */
+	float32_t *pFrame;        /* Last two input blocks [2P]            */
+	float32_t *pWork;         /* Spectrum [P + 1] (complex) or signal  */
+	                          /* [2P] of the current step              */
+	RealFftInstanceF32 Fft;
+	LMSFreqPool Pool;
+#if LMS_METRICS
+	LMSMetricsQ15 Metrics;
+#endif
+} LMSFreqInstanceF32;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+arm_status LMSFreq_init_f32(LMSFreqInstanceF32 *S, uint32_t numTaps,
+		uint16_t blockSize, float32_t *pMemory);
+int LMSFreq_start_f32(LMSFreqInstanceF32 *S, uint32_t numThreads);
+void LMSFreq_stop_f32(LMSFreqInstanceF32 *S);
+void LMSFreq_f32(LMSFreqInstanceF32 *S, q15_t *pSrc, q15_t *pRef,
+		q15_t *pErr);
+void LMSFreq_report(LMSFreqInstanceF32 *S, LMSMetricsReport *pReport);
+
+/*****************************************************************************/
+/*  End Header  : LMSFreq                                                    */
+/*****************************************************************************/
+#endif
@@ -0,0 +1,394 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : LMSFreqBench (host)                            Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Benchmark of the long tail canceller LMSFreq.c on the       */
+/*               recorded scenarios of Matlab/, brought to the sampling      */
+/*               frequency of the test (Wav.c).                              */
+/*                                                                           */
+/*               1. Channels per core: -channels cancellers, each with its   */
+/*                  own scenario and start offset, run block by block on     */
+/*                  one thread. Reports how many such channels one core runs */
+/*                  in real time; the exit code is 1 below -channels.        */
+/*               2. Metrics of LMSMetrics.c (ERLE, convergence time) as on   */
+/*                  the board, mean over the channels and per scenario.      */
+/*               3. Threads: one canceller with 1, 2, ... threads for the    */
+/*                  partition loops (LMSFreq_start_f32()), time per block.   */
+/*                                                                           */
+/*               Build (from this directory):                                */
+/*               gcc -O3 -DARM_MATH_CM4 -I. -I../src                         */
+/*                   -I../Libraries/CMSIS/Include -o lmsfreqbench            */
+/*                   LMSFreqBench.c LMSFreq.c RealFft.c Wav.c                */
+/*                   ../src/LMSMetrics.c -lpthread -lm                       */
+/*                                                                           */
+/*               Options:                                                    */
+/*               -fs n          Sampling frequency (16000)                   */
+/*               -tail ms       Echo tail (500), sets the taps               */
+/*               -taps n        Filter length (tail * fs)                    */
+/*               -block n       Partition length P (256)                     */
+/*               -channels n    Channels per core required (50)              */
+/*               -threads list  Threads of the single channel test (1,2,4)   */
+/*               -dir path      Directory of the recordings (WAV_DIRECTORY)  */
+/*                                                                           */
+/*  Procedures : main()                                                      */
+/*               Bench_fill()                                                */
+/*               Bench_list()                                                */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSFreqBench.c                                              */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "LMSFreq.h"
+#include "Wav.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* module constant declaration */
+
+/* Reference and the recorded microphone signals (reference + echo) */
+#define BENCH_REFERENCE "Lorem_ipsum_3500.wav"
+#define BENCH_SCENARIOS 2
+
+/* Values of a list option */
+#define BENCH_LIST_MAX 16
+
+/* Start offset of channel c: c * BENCH_OFFSET samples (a prime) */
+#define BENCH_OFFSET 997
+
+/* module type declaration */
+
+/* Recordings */
+typedef struct
+{
+	int16_t *pFar;
+	int16_t *pMic[BENCH_SCENARIOS];
+	uint32_t Length;
+} BenchLoad;
+
+/* module data declaration */
+
+static const char *Scenarios[BENCH_SCENARIOS] =
+{
+	"Lorem_ipsum_delay_3500.wav",
+	"Lorem_ipsum_verb_3500.wav"
+};
+
+/* module procedure declaration */
+static void Bench_fill(const BenchLoad *pLoad, uint32_t Channel,
+		uint32_t Position, uint32_t blockSize, q15_t *pFar, q15_t *pMic);
+static uint32_t Bench_list(const char *pText, uint32_t *pValues);
+
+/*****************************************************************************/
+/*  Procedure   : main                                                       */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Parses the options, loads the recordings, runs the tests   */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : argc, argv Options, see module header                      */
+/*                                                                           */
+/*  Output Para : Return     0 ok, 1 fewer channels per core than required,  */
+/*                           2 error                                         */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+int main(int argc, char *argv[]) {
+
+	/* procedure data */
+	LMSFreqInstanceF32 *pCancellers;
+	LMSFreqInstanceF32 Single;
+	LMSMetricsReport Report;
+	BenchLoad Load;
+	float32_t *pMemory;
+	q15_t *pFar;
+	q15_t *pMic;
+	q15_t *pErr;
+	uint32_t Threads[BENCH_LIST_MAX];
+	uint32_t numThreads = 3;
+	uint32_t Fs = 16000;
+	uint32_t Tail = 500;
+	uint32_t numTaps = 0;
+	uint32_t blockSize = 256;
+	uint32_t numChannels = 50;
+	uint32_t Length;
+	uint32_t Blocks;
+	uint32_t Words;
+	uint32_t Position;
+	uint32_t c, i, n;
+	const char *pDir = WAV_DIRECTORY;
+	char Name[512];
+	struct timespec Start;
+	struct timespec End;
+	double Seconds;
+	double Audio;
+	double Erle[BENCH_SCENARIOS];
+	double Convergence[BENCH_SCENARIOS];
+	double Single1 = 0.0;
+	double PerCore;
+	int a;
+
+	/* procedure code */
+	Threads[0] = 1;
+	Threads[1] = 2;
+	Threads[2] = 4;
+	for (a = 1; a < argc; a++) {
+		if (a + 1 >= argc) {
+			fprintf(stderr, "Missing value of %s\n", argv[a]);
+			return 2;
+		} else if (strcmp(argv[a], "-fs") == 0) {
+			Fs = (uint32_t) atol(argv[++a]);
+		} else if (strcmp(argv[a], "-tail") == 0) {
+			Tail = (uint32_t) atol(argv[++a]);
+		} else if (strcmp(argv[a], "-taps") == 0) {
+			numTaps = (uint32_t) atol(argv[++a]);
+		} else if (strcmp(argv[a], "-block") == 0) {
+			blockSize = (uint32_t) atol(argv[++a]);
+		} else if (strcmp(argv[a], "-channels") == 0) {
+			numChannels = (uint32_t) atol(argv[++a]);
+		} else if (strcmp(argv[a], "-threads") == 0) {
+			numThreads = Bench_list(argv[++a], Threads);
+		} else if (strcmp(argv[a], "-dir") == 0) {
+			pDir = argv[++a];
+		} else {
+			fprintf(stderr, "Unknown option %s\n", argv[a]);
+			return 2;
+		}
+	}
+	if (numTaps == 0) {
+		numTaps = (uint32_t) ((uint64_t) Tail * Fs / 1000u);
+	}
+	if ((Fs == 0) || (numTaps == 0) || (numChannels == 0) ||
+			(numThreads == 0) || (blockSize > 2048u)) {
+		fprintf(stderr, "Invalid option value\n");
+		return 2;
+	}
+
+	/* Recordings at Fs */
+	snprintf(Name, sizeof(Name), "%s/%s", pDir, BENCH_REFERENCE);
+	if (Wav_read(Name, Fs, &Load.pFar, &Load.Length) != 0) {
+		fprintf(stderr, "Can not read %s\n", Name);
+		return 2;
+	}
+	for (i = 0; i < BENCH_SCENARIOS; i++) {
+		snprintf(Name, sizeof(Name), "%s/%s", pDir, Scenarios[i]);
+		if (Wav_read(Name, Fs, &Load.pMic[i], &Length) != 0) {
+			fprintf(stderr, "Can not read %s\n", Name);
+			return 2;
+		}
+		if (Length < Load.Length) {
+			Load.Length = Length;
+		}
+	}
+	Blocks = Load.Length / blockSize;
+
+	/* Cancellers of all channels */
+	Words = LMS_FREQ_MEMORY(numTaps, blockSize);
+	pCancellers = (LMSFreqInstanceF32 *) malloc(
+			numChannels * sizeof(LMSFreqInstanceF32));
+	pMemory = (float32_t *) malloc(
+			(size_t) numChannels * Words * sizeof(float32_t));
+	pFar = (q15_t *) malloc(3u * blockSize * sizeof(q15_t));
+	if ((pCancellers == 0) || (pMemory == 0) || (pFar == 0) ||
+			(Blocks == 0)) {
+		fprintf(stderr, "Out of memory\n");
+		return 2;
+	}
+	pMic = pFar + blockSize;
+	pErr = pMic + blockSize;
+	for (c = 0; c < numChannels; c++) {
+		if (LMSFreq_init_f32(&pCancellers[c], numTaps, (uint16_t) blockSize,
+				&pMemory[(size_t) c * Words]) != ARM_MATH_SUCCESS) {
+			fprintf(stderr, "Invalid configuration, block %u\n", blockSize);
+			return 2;
+		}
+	}
+	printf("Fs %u Hz, %u taps (%.0f ms), P %u, K %u, %.0f kB per channel\n",
+			Fs, numTaps, 1e3 * numTaps / Fs, blockSize,
+			pCancellers[0].numPartitions, Words * sizeof(float32_t) / 1024.0);
+
+	/* 1. All channels on this thread, block by block */
+	clock_gettime(CLOCK_MONOTONIC, &Start);
+	for (n = 0; n < Blocks; n++) {
+		Position = n * blockSize;
+		for (c = 0; c < numChannels; c++) {
+			Bench_fill(&Load, c, Position, blockSize, pFar, pMic);
+			LMSFreq_f32(&pCancellers[c], pFar, pMic, pErr);
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &End);
+	Seconds = (End.tv_sec - Start.tv_sec) + 1e-9 * (End.tv_nsec - Start.tv_nsec);
+	Audio = (double) Blocks * blockSize / Fs;
+	PerCore = numChannels * Audio / Seconds;
+	printf("%u channels x %.2f s in %.3f s: %.0f channels per core in real "
+			"time (%u required)\n", numChannels, Audio, Seconds, PerCore,
+			numChannels);
+
+	/* 2. Metrics, times of LMSMetrics.c are in samples / FS */
+	for (i = 0; i < BENCH_SCENARIOS; i++) {
+		Erle[i] = 0.0;
+		Convergence[i] = 0.0;
+	}
+	for (c = 0; c < numChannels; c++) {
+		LMSFreq_report(&pCancellers[c], &Report);
+		Erle[c % BENCH_SCENARIOS] += Report.ErleLong;
+		if ((Report.ConvergenceTime >= 0.0f) && (Convergence[c %
+				BENCH_SCENARIOS] >= 0.0)) {
+			Convergence[c % BENCH_SCENARIOS] += Report.ConvergenceTime;
+		} else {
+			Convergence[c % BENCH_SCENARIOS] = -1.0;
+		}
+	}
+	for (i = 0; (i < BENCH_SCENARIOS) && (i < numChannels); i++) {
+		n = (numChannels - i + BENCH_SCENARIOS - 1u) / BENCH_SCENARIOS;
+		printf("%-28s ERLE %5.1f dB, convergence ", Scenarios[i],
+				Erle[i] / n);
+		if (Convergence[i] >= 0.0) {
+			printf("%.2f s\n", Convergence[i] / n * FS / Fs);
+		} else {
+			printf("not reached on all channels\n");
+		}
+	}
+
+	/* 3. One channel on 1, 2, ... threads */
+	for (i = 0; i < numThreads; i++) {
+		if ((LMSFreq_init_f32(&Single, numTaps, (uint16_t) blockSize,
+				pMemory) != ARM_MATH_SUCCESS) ||
+				(LMSFreq_start_f32(&Single, Threads[i]) != 0)) {
+			fprintf(stderr, "Can not start %u threads\n", Threads[i]);
+			return 2;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &Start);
+		for (n = 0; n < Blocks; n++) {
+			Bench_fill(&Load, 0, n * blockSize, blockSize, pFar, pMic);
+			LMSFreq_f32(&Single, pFar, pMic, pErr);
+		}
+		clock_gettime(CLOCK_MONOTONIC, &End);
+		LMSFreq_stop_f32(&Single);
+		Seconds = (End.tv_sec - Start.tv_sec) +
+				1e-9 * (End.tv_nsec - Start.tv_nsec);
+		if (i == 0) {
+			Single1 = Seconds;
+		}
+		printf("1 channel, %2u threads: %8.1f us per block, speedup %.2f\n",
+				Threads[i], 1e6 * Seconds / Blocks, Single1 / Seconds);
+	}
+
+	free(pCancellers);
+	free(pMemory);
+	free(pFar);
+	free(Load.pFar);
+	for (i = 0; i < BENCH_SCENARIOS; i++) {
+		free(Load.pMic[i]);
+	}
+	return (PerCore < numChannels) ? 1 : 0;
+}
+/*****************************************************************************/
+/*  End         : main                                                       */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Bench_fill                                                 */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Samples of a channel: its scenario from its start offset,  */
+/*                repeated                                                   */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pLoad      Recordings                                      */
+/*                Channel    Channel number                                  */
+/*                Position   First sample of the block                       */
+/*                blockSize  Samples                                         */
+/*                                                                           */
+/*  Output Para : pFar       Far end (reference) [blockSize]                 */
+/*                pMic       Microphone [blockSize]                          */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Bench_fill(const BenchLoad *pLoad, uint32_t Channel,
+		uint32_t Position, uint32_t blockSize, q15_t *pFar, q15_t *pMic) {
+
+	/* procedure data */
+	const int16_t *pScenario = pLoad->pMic[Channel % BENCH_SCENARIOS];
+	uint32_t Offset;
+	uint32_t i;
+
+	/* procedure code */
+	Offset = (uint32_t) (((uint64_t) Channel * BENCH_OFFSET + Position) %
+			pLoad->Length);
+	for (i = 0; i < blockSize; i++) {
+		pFar[i] = pLoad->pFar[Offset];
+		pMic[i] = pScenario[Offset];
+		if (++Offset >= pLoad->Length) {
+			Offset = 0;
+		}
+	}
+}
+/*****************************************************************************/
+/*  End         : Bench_fill                                                 */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Bench_list                                                 */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Parses a list of numbers separated by commas               */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pText      List                                            */
+/*                                                                           */
+/*  Output Para : pValues    Values [BENCH_LIST_MAX]                         */
+/*                Return     Number of values, 0 if invalid                  */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint32_t Bench_list(const char *pText, uint32_t *pValues) {
+
+	/* procedure data */
+	uint32_t Count = 0;
+	char *pEnd;
+
+	/* procedure code */
+	while ((*pText != '\0') && (Count < BENCH_LIST_MAX)) {
+		pValues[Count] = (uint32_t) strtoul(pText, &pEnd, 10);
+		if ((pEnd == pText) || (pValues[Count] == 0)) {
+			return 0;
+		}
+		Count++;
+		pText = (*pEnd == ',') ? pEnd + 1 : pEnd;
+		if ((*pEnd != ',') && (*pEnd != '\0')) {
+			return 0;
+		}
+	}
+	return Count;
+}
+/*****************************************************************************/
+/*  End         : Bench_list                                                 */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : LMSFreqBench                                               */
+/*****************************************************************************/
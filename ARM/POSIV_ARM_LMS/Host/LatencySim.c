@@ -0,0 +1,298 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : LatencySim (host)                              Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Runs the latency measurement of the firmware (Latency.c)    */
+/*               on the virtual board (BoardSim.c), with output 2 looped     */
+/*               back to input 1 as the cable on the bench. Output 1 passes  */
+/*               input 1 through, the idle loop is called every sample.      */
+/*                                                                           */
+/*               Build (from this directory):                                */
+/*               gcc -O2 -DARM_MATH_CM4 -I. -I../src                         */
+/*                   -I../Libraries/CMSIS/Include -o latencysim              */
+/*                   BoardSim.c LatencySim.c ../src/Latency.c                */
+/*                   ../Libraries/CMSIS/DSP_Lib/Source/FilteringFunctions/   */
+/*                   arm_correlate_fast_q15.c                                */
+/*                                                                           */
+/*               Options:                                                    */
+/*               -block n     Block size of the board (BLOCK_SIZE)           */
+/*               -deferred 0|1, -half 0|1, -cpt c, -cycles c, -seconds s     */
+/*                            As for BoardSimMain.c                          */
+/*               -analog n    Samples of the analog path (0)                 */
+/*               -gain f      Gain of the loopback (0.5)                     */
+/*               -noise n     Peak of the noise added on input 1 (200)       */
+/*               -max n       Exit code 1 above n samples (regression test)  */
+/*                                                                           */
+/*  Procedures : main()                                                      */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LatencySim.c                                                */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "BoardSim.h"
+#include "Latency.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* module constant declaration */
+
+/* Longest analog path [samples] */
+#define SIM_ANALOG_MAX 256
+
+/* module type declaration */
+
+/* Bench: loopback cable and the firmware measurement */
+typedef struct
+{
+	LatencyInstance Latency;
+	LatencyReport Report;
+	int16_t Analog[SIM_ANALOG_MAX];
+	uint32_t AnalogDelay;
+	double Gain;
+	uint32_t Noise;
+	uint32_t Rand;
+} SimBench;
+
+/* module data declaration */
+
+/* module procedure declaration */
+static void Bench_process(void *pUser, int16_t *pIn1, int16_t *pIn2,
+		int16_t *pOut1, int16_t *pOut2, uint32_t blockSize);
+static int16_t Bench_input(void *pUser, uint32_t Channel, uint64_t Tick,
+		const int16_t *pDac);
+static void Bench_output(void *pUser, uint64_t Tick, const int16_t *pDac);
+
+/*****************************************************************************/
+/*  Procedure   : main                                                       */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Parses the options, runs the board and prints the latency  */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : argc, argv Options, see module header                      */
+/*                                                                           */
+/*  Output Para : Return     0 if markers were found within -max             */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+int main(int argc, char *argv[]) {
+
+	/* procedure data */
+	static SimBench Bench;
+	BoardSimConfig Config;
+	BoardSimReport Board;
+	uint32_t Max = UINT32_MAX;
+	double us;
+	int a;
+
+	/* procedure code */
+	BoardSim_defaults(&Config);
+	Config.Seconds = 5.0;
+	Bench.Gain = 0.5;
+	Bench.Noise = 200;
+	Bench.Rand = 1;
+
+	for (a = 1; a < argc; a++) {
+		if (a + 1 >= argc) {
+			fprintf(stderr, "Missing value of %s\n", argv[a]);
+			return 2;
+		} else if (strcmp(argv[a], "-block") == 0) {
+			Config.BlockSize = (uint32_t) atol(argv[++a]);
+		} else if (strcmp(argv[a], "-deferred") == 0) {
+			Config.Deferred = (uint8_t) atoi(argv[++a]);
+		} else if (strcmp(argv[a], "-half") == 0) {
+			Config.HalfBuffer = (uint8_t) atoi(argv[++a]);
+		} else if (strcmp(argv[a], "-cpt") == 0) {
+			Config.CyclesPerTap = atof(argv[++a]);
+		} else if (strcmp(argv[a], "-cycles") == 0) {
+			Config.CostMeasured = (uint32_t) atol(argv[++a]);
+		} else if (strcmp(argv[a], "-seconds") == 0) {
+			Config.Seconds = atof(argv[++a]);
+		} else if (strcmp(argv[a], "-analog") == 0) {
+			Bench.AnalogDelay = (uint32_t) atol(argv[++a]);
+		} else if (strcmp(argv[a], "-gain") == 0) {
+			Bench.Gain = atof(argv[++a]);
+		} else if (strcmp(argv[a], "-noise") == 0) {
+			Bench.Noise = (uint32_t) atol(argv[++a]);
+		} else if (strcmp(argv[a], "-max") == 0) {
+			Max = (uint32_t) atol(argv[++a]);
+		} else {
+			fprintf(stderr, "Unknown option %s\n", argv[a]);
+			return 2;
+		}
+	}
+	if ((Bench.AnalogDelay >= SIM_ANALOG_MAX) || (Config.BlockSize == 0) ||
+			(2u * Config.BlockSize + Bench.AnalogDelay +
+			2u * LATENCY_MARKER_LENGTH > LATENCY_WINDOW)) {
+		fprintf(stderr, "Latency longer than LATENCY_WINDOW\n");
+		return 2;
+	}
+
+	Latency_init(&Bench.Latency, &Bench.Report);
+	Config.Process = Bench_process;
+	Config.Input = Bench_input;
+	Config.Output = Bench_output;
+	Config.pUser = &Bench;
+	if (BoardSim_run(&Config, &Board) != 0) {
+		fprintf(stderr, "Invalid board configuration\n");
+		return 2;
+	}
+	BoardSim_print(stdout, &Config, &Board);
+
+	us = 1e6 / Board.FsActual;
+	printf("Latency         %u samples, %.1f us (min %u, max %u), "
+			"%u markers, %u not found\n", Bench.Report.Samples,
+			Bench.Report.Samples * us, Bench.Report.SamplesMin,
+			Bench.Report.SamplesMax, Bench.Report.Measurements,
+			Bench.Report.Failures);
+	printf("Model           %u samples: 2 blocks of %s DMA, %u analog\n",
+			2u * Config.BlockSize + Bench.AnalogDelay,
+			Config.HalfBuffer ? "half buffer" : "double buffer",
+			Bench.AnalogDelay);
+
+	if ((Bench.Report.Measurements == 0) || (Bench.Report.SamplesMax > Max)) {
+		return 1;
+	}
+	return 0;
+}
+/*****************************************************************************/
+/*  End         : main                                                       */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Bench_process                                              */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : ProcessBlock() of the measurement: input 1 on output 1,    */
+/*                marker on output 2                                         */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pUser      Bench                                           */
+/*                pIn1, pIn2 Inputs [blockSize]                              */
+/*                blockSize  Number of samples                               */
+/*                                                                           */
+/*  Output Para : pOut1, pOut2 Outputs [blockSize]                           */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Bench_process(void *pUser, int16_t *pIn1, int16_t *pIn2,
+		int16_t *pOut1, int16_t *pOut2, uint32_t blockSize) {
+
+	/* procedure data */
+	SimBench *pBench = (SimBench *) pUser;
+
+	/* procedure code */
+	(void) pIn2;
+	memcpy(pOut1, pIn1, blockSize * sizeof(int16_t));
+	Latency_q15(&pBench->Latency, pIn1, pOut2, blockSize);
+}
+/*****************************************************************************/
+/*  End         : Bench_process                                              */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Bench_input                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Input 1 is DAC 2 through the analog path with noise,       */
+/*                input 2 is silent                                          */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pUser      Bench                                           */
+/*                Channel    0 or 1                                          */
+/*                Tick       Sample number                                   */
+/*                pDac       DAC outputs of this sample                      */
+/*                                                                           */
+/*  Output Para : Return     ADC sample                                      */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static int16_t Bench_input(void *pUser, uint32_t Channel, uint64_t Tick,
+		const int16_t *pDac) {
+
+	/* procedure data */
+	SimBench *pBench = (SimBench *) pUser;
+	uint32_t Now = (uint32_t) (Tick % SIM_ANALOG_MAX);
+	uint32_t Then;
+	double Sample;
+
+	/* procedure code */
+	if (Channel != 0) {
+		return 0;
+	}
+	pBench->Analog[Now] = pDac[1];
+	Then = (Now + SIM_ANALOG_MAX - pBench->AnalogDelay) % SIM_ANALOG_MAX;
+	Sample = pBench->Gain * pBench->Analog[Then];
+
+	pBench->Rand = pBench->Rand * 1664525u + 1013904223u;
+	Sample += ((double) pBench->Rand / 2147483648.0 - 1.0) * pBench->Noise;
+	if (Sample > 32767.0) {
+		Sample = 32767.0;
+	} else if (Sample < -32768.0) {
+		Sample = -32768.0;
+	}
+	return (int16_t) Sample;
+}
+/*****************************************************************************/
+/*  End         : Bench_input                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Bench_output                                               */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Called every sample, runs the idle loop of the             */
+/*                measurement                                                */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pUser      Bench                                           */
+/*                Tick       Sample number                                   */
+/*                pDac       DAC outputs                                     */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Bench_output(void *pUser, uint64_t Tick, const int16_t *pDac) {
+
+	/* procedure data */
+	SimBench *pBench = (SimBench *) pUser;
+
+	/* procedure code */
+	(void) Tick;
+	(void) pDac;
+	Latency_idle(&pBench->Latency, &pBench->Report);
+}
+/*****************************************************************************/
+/*  End         : Bench_output                                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : LatencySim                                                 */
+/*****************************************************************************/
@@ -0,0 +1,312 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : RealFft (host)                                 Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : FFT of real signals of N samples with a complex FFT of      */
+/*               M = N/2 points. The samples x(2n) + i x(2n+1) are the       */
+/*               complex input z(n), so the transform runs in place. With    */
+/*               Z = FFT(z), W = exp(-2pi i / N) and k = 0 ... M/2:          */
+/*                                                                           */
+/*                 Fe = (Z(k) + conj(Z(M-k))) / 2     (even samples)         */
+/*                 Fo = (Z(k) - conj(Z(M-k))) / 2i    (odd samples)          */
+/*                 X(k) = Fe + W^k Fo,  X(M-k) = conj(Fe - W^k Fo)           */
+/*                                                                           */
+/*               The inverse runs the same steps backwards. Half the work of */
+/*               a complex FFT of N points with a zero imaginary part.       */
+/*                                                                           */
+/*               The complex FFT is radix 2, decimation in time, after a     */
+/*               bit reversed reordering.                                    */
+/*                                                                           */
+/*  Procedures : RealFft_init_f32()                                          */
+/*               RealFft_forward_f32()                                       */
+/*               RealFft_inverse_f32()                                       */
+/*               RealFft_complex()                                           */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : RealFft.c                                                   */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "RealFft.h"
+#include <math.h>
+#include <string.h>
+
+/* module constant declaration */
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+static void RealFft_complex(const RealFftInstanceF32 *S, float32_t *pData,
+		int32_t Sign);
+
+/*****************************************************************************/
+/*  Procedure   : RealFft_init_f32                                           */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Computes the twiddle tables of a transform                 */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance to initialize                          */
+/*                fftLen     N, power of 2, at least 4                       */
+/*                pMemory    Memory [REAL_FFT_MEMORY(fftLen)]                */
+/*                                                                           */
+/*  Output Para : Return     ARM_MATH_ARGUMENT_ERROR if fftLen is not        */
+/*                           supported                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+arm_status RealFft_init_f32(RealFftInstanceF32 *S, uint32_t fftLen,
+		float32_t *pMemory) {
+
+	/* procedure data */
+	uint32_t M = fftLen / 2u;
+	uint32_t j;
+
+	/* procedure code */
+	if ((fftLen < 4u) || ((fftLen & (fftLen - 1u)) != 0)) {
+		return ARM_MATH_ARGUMENT_ERROR;
+	}
+	S->fftLen = fftLen;
+	S->pTwiddle = pMemory;
+	S->pSplit = pMemory + M;
+
+	for (j = 0; j < M / 2u; j++) {
+		S->pTwiddle[2u * j] = (float32_t) cos(2.0 * PI * j / M);
+		S->pTwiddle[2u * j + 1u] = (float32_t) -sin(2.0 * PI * j / M);
+	}
+	for (j = 0; j < M; j++) {
+		S->pSplit[2u * j] = (float32_t) cos(2.0 * PI * j / fftLen);
+		S->pSplit[2u * j + 1u] = (float32_t) -sin(2.0 * PI * j / fftLen);
+	}
+	return ARM_MATH_SUCCESS;
+}
+/*****************************************************************************/
+/*  End         : RealFft_init_f32                                           */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : RealFft_forward_f32                                        */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Spectrum of a real signal, bins 0 ... N/2 (unscaled)       */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Signal [N]                                      */
+/*                                                                           */
+/*  Output Para : pDst       Spectrum [N/2 + 1] (complex), may be pSrc if    */
+/*                           that has room for N + 2 values                  */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void RealFft_forward_f32(const RealFftInstanceF32 *S, float32_t *pSrc,
+		float32_t *pDst) {
+
+	/* procedure data */
+	uint32_t M = S->fftLen / 2u;
+	float32_t EvenRe, EvenIm;
+	float32_t OddRe, OddIm;
+	float32_t Re, Im;
+	float32_t Wr, Wi;
+	uint32_t k;
+
+	/* procedure code */
+	if (pDst != pSrc) {
+		memcpy(pDst, pSrc, S->fftLen * sizeof(float32_t));
+	}
+	RealFft_complex(S, pDst, -1);
+
+	/* Bins 0 and N/2 from Z(0) */
+	Re = pDst[0];
+	Im = pDst[1];
+	pDst[0] = Re + Im;
+	pDst[1] = 0.0f;
+	pDst[2u * M] = Re - Im;
+	pDst[2u * M + 1u] = 0.0f;
+
+	for (k = 1; k <= M / 2u; k++) {
+		EvenRe = 0.5f * (pDst[2u * k] + pDst[2u * (M - k)]);
+		EvenIm = 0.5f * (pDst[2u * k + 1u] - pDst[2u * (M - k) + 1u]);
+		OddRe = 0.5f * (pDst[2u * k + 1u] + pDst[2u * (M - k) + 1u]);
+		OddIm = -0.5f * (pDst[2u * k] - pDst[2u * (M - k)]);
+
+		/* W^k Fo */
+		Wr = S->pSplit[2u * k];
+		Wi = S->pSplit[2u * k + 1u];
+		Re = Wr * OddRe - Wi * OddIm;
+		Im = Wr * OddIm + Wi * OddRe;
+
+		pDst[2u * k] = EvenRe + Re;
+		pDst[2u * k + 1u] = EvenIm + Im;
+		pDst[2u * (M - k)] = EvenRe - Re;
+		pDst[2u * (M - k) + 1u] = Im - EvenIm;
+	}
+}
+/*****************************************************************************/
+/*  End         : RealFft_forward_f32                                        */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : RealFft_inverse_f32                                        */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Real signal of a spectrum of bins 0 ... N/2, scaled by 1/N */
+/*                (the inverse of RealFft_forward_f32())                     */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Spectrum [N/2 + 1] (complex), destroyed         */
+/*                                                                           */
+/*  Output Para : pDst       Signal [N], may be pSrc                         */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void RealFft_inverse_f32(const RealFftInstanceF32 *S, float32_t *pSrc,
+		float32_t *pDst) {
+
+	/* procedure data */
+	uint32_t M = S->fftLen / 2u;
+	float32_t Scale = 1.0f / S->fftLen;
+	float32_t EvenRe, EvenIm;
+	float32_t OddRe, OddIm;
+	float32_t Re, Im;
+	float32_t Wr, Wi;
+	uint32_t k;
+
+	/* procedure code */
+
+	/* Z(0) from bins 0 and N/2 */
+	Re = pSrc[0];
+	Im = pSrc[2u * M];
+	pSrc[0] = Scale * (Re + Im);
+	pSrc[1] = Scale * (Re - Im);
+
+	for (k = 1; k <= M / 2u; k++) {
+		EvenRe = Scale * (pSrc[2u * k] + pSrc[2u * (M - k)]);
+		EvenIm = Scale * (pSrc[2u * k + 1u] - pSrc[2u * (M - k) + 1u]);
+		Re = Scale * (pSrc[2u * k] - pSrc[2u * (M - k)]);
+		Im = Scale * (pSrc[2u * k + 1u] + pSrc[2u * (M - k) + 1u]);
+
+		/* Fo = (X(k) - conj(X(M-k))) conj(W^k) */
+		Wr = S->pSplit[2u * k];
+		Wi = S->pSplit[2u * k + 1u];
+		OddRe = Wr * Re + Wi * Im;
+		OddIm = Wr * Im - Wi * Re;
+
+		/* Z(k) = Fe + i Fo, Z(M-k) = conj(Fe) + i conj(Fo) */
+		pSrc[2u * k] = EvenRe - OddIm;
+		pSrc[2u * k + 1u] = EvenIm + OddRe;
+		pSrc[2u * (M - k)] = EvenRe + OddIm;
+		pSrc[2u * (M - k) + 1u] = OddRe - EvenIm;
+	}
+
+	RealFft_complex(S, pSrc, 1);
+	if (pDst != pSrc) {
+		memcpy(pDst, pSrc, S->fftLen * sizeof(float32_t));
+	}
+}
+/*****************************************************************************/
+/*  End         : RealFft_inverse_f32                                        */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : RealFft_complex                                            */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Complex FFT of N/2 points in place, unscaled               */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pData      Data [N/2] (complex)                            */
+/*                Sign       -1 forward, 1 inverse                           */
+/*                                                                           */
+/*  Output Para : pData      Transform                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void RealFft_complex(const RealFftInstanceF32 *S, float32_t *pData,
+		int32_t Sign) {
+
+	/* procedure data */
+	uint32_t M = S->fftLen / 2u;
+	uint32_t Half;
+	uint32_t Step;
+	uint32_t i, j, k;
+	float32_t Wr, Wi;
+	float32_t Re, Im;
+	float32_t *pA;
+	float32_t *pB;
+
+	/* procedure code */
+
+	/* Bit reversed order */
+	j = 0;
+	for (i = 0; i < M - 1u; i++) {
+		if (i < j) {
+			Re = pData[2u * i];
+			Im = pData[2u * i + 1u];
+			pData[2u * i] = pData[2u * j];
+			pData[2u * i + 1u] = pData[2u * j + 1u];
+			pData[2u * j] = Re;
+			pData[2u * j + 1u] = Im;
+		}
+		k = M >> 1;
+		while (k <= j) {
+			j -= k;
+			k >>= 1;
+		}
+		j += k;
+	}
+
+	/* Butterflies of length 2 * Half */
+	for (Half = 1, Step = M / 2u; Half < M; Half <<= 1, Step >>= 1) {
+		for (j = 0; j < Half; j++) {
+			Wr = S->pTwiddle[2u * j * Step];
+			Wi = Sign * S->pTwiddle[2u * j * Step + 1u];
+			for (i = j; i < M; i += 2u * Half) {
+				pA = &pData[2u * i];
+				pB = &pData[2u * (i + Half)];
+				Re = Wr * pB[0] + Wi * pB[1];
+				Im = Wr * pB[1] - Wi * pB[0];
+				pB[0] = pA[0] - Re;
+				pB[1] = pA[1] - Im;
+				pA[0] += Re;
+				pA[1] += Im;
+			}
+		}
+	}
+}
+/*****************************************************************************/
+/*  End         : RealFft_complex                                            */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : RealFft                                                    */
+/*****************************************************************************/
@@ -0,0 +1,58 @@
+#ifndef REALFFT_H
+#define REALFFT_H
+/*****************************************************************************/
+/*  Header     : RealFft (host)                                 Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : FFT of real float32 signals of length N (power of 2): one   */
+/*               complex FFT of N/2 points and a split into the N/2 + 1      */
+/*               bins up to FS/2. The twiddle tables are computed by the     */
+/*               init, no tables of the CMSIS library are needed.            */
+/*                                                                           */
+/*  Procedures : RealFft_init_f32()                                          */
+/*               RealFft_forward_f32()                                       */
+/*               RealFft_inverse_f32()                                       */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : RealFft.h                                                   */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "arm_math.h"
+
+/* module constant declaration  */
+
+/* Memory (number of float32_t) of a transform of fftLen real samples:  */
+/* twiddles of the N/2 FFT [N/4] and of the split [N/2] (complex)       */
+#define REAL_FFT_MEMORY(fftLen) (3 * (fftLen) / 2)
+
+/* module type declaration      */
+
+typedef struct
+{
+	uint32_t fftLen;          /* N, real samples                       */
+	float32_t *pTwiddle;      /* exp(-2pi i j / (N/2)), j < N/4        */
+	float32_t *pSplit;        /* exp(-2pi i k / N), k < N/2            */
+} RealFftInstanceF32;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+arm_status RealFft_init_f32(RealFftInstanceF32 *S, uint32_t fftLen,
+		float32_t *pMemory);
+void RealFft_forward_f32(const RealFftInstanceF32 *S, float32_t *pSrc,
+		float32_t *pDst);
+void RealFft_inverse_f32(const RealFftInstanceF32 *S, float32_t *pSrc,
+		float32_t *pDst);
+
+/*****************************************************************************/
+/*  End Header  : RealFft                                                    */
+/*****************************************************************************/
+#endif
@@ -0,0 +1,421 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : SignBench (host)                               Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Compares the multiplierfree sign LMS kernels (LMSSign.c)    */
+/*               with arm_lms_q15() on the recorded scenarios of Matlab/,    */
+/*               with the Q15 arithmetic of the target (the kernels are      */
+/*               built with the host intrinsics of Host/). Reports the ERLE  */
+/*               and convergence time of LMSMetrics.c and the time per       */
+/*               sample of each kernel, relative to arm_lms_q15().           */
+/*                                                                           */
+/*               The baseline is a Q15 NLMS with a rounded update: the step  */
+/*               is divided by the power of the delay line, and the update   */
+/*               is rounded. arm_lms_q15() truncates its update, the bias of */
+/*               -1/2 LSB per tap and sample outgrows small steps and lets   */
+/*               the firmware row drift below 0 dB on these recordings.      */
+/*                                                                           */
+/*               Build (from this directory):                                */
+/*               gcc -O2 -DARM_MATH_CM4 -I. -I../src                         */
+/*                   -I../Libraries/CMSIS/Include -o signbench SignBench.c   */
+/*                   Wav.c ../src/LMSSign.c ../src/LMSMetrics.c              */
+/*                   ../Libraries/CMSIS/DSP_Lib/Source/FilteringFunctions/   */
+/*                   arm_lms_q15.c                                           */
+/*                   ../Libraries/CMSIS/DSP_Lib/Source/FilteringFunctions/   */
+/*                   arm_lms_init_q15.c -lm                                  */
+/*                                                                           */
+/*               Options:                                                    */
+/*               -taps n      Filter length (FILTER_LENGTH, 1700)            */
+/*               -mu n        Step of the NLMS in Q15 (16384 = 0.5)          */
+/*               -shift n     Step 2^-n of the sign-error LMS (12)           */
+/*               -delta n     Step of the sign-sign LMS in Q15 (1)           */
+/*               -dir path    Directory of the recordings (WAV_DIRECTORY)    */
+/*               -csv prefix  ERLE over time, one file per run               */
+/*                                                                           */
+/*               The host time shows the relation of the kernels only, the   */
+/*               cycles on the target are in CyclesPerTap.                   */
+/*                                                                           */
+/*  Procedures : main()                                                      */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : SignBench.c                                                 */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "Wav.h"
+#include "LMSSign.h"
+#include "LMSMetrics.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* module constant declaration */
+
+/* Reference and the recorded microphone signals (reference + echo) */
+#define BENCH_REFERENCE "Lorem_ipsum_3500.wav"
+#define BENCH_SCENARIOS 2
+
+/* Kernels compared */
+#define BENCH_RULES 4
+
+/* Step of the full LMS on the target (MU in SignalProcessingLMSFilter.c) */
+#define BENCH_FIRMWARE_MU 1
+
+/* Regularisation of the NLMS, mean square of the reference (rms 32) */
+#define BENCH_NLMS_FLOOR 1024
+
+/* Interval of the csv lines [samples] (0.1s) */
+#define BENCH_CSV_INTERVAL (FS / 10)
+
+/* module type declaration */
+
+/* module data declaration */
+
+static const char *Scenarios[BENCH_SCENARIOS] =
+{
+	"Lorem_ipsum_delay_3500.wav",
+	"Lorem_ipsum_verb_3500.wav"
+};
+
+static const char *Rules[BENCH_RULES] =
+{
+	"LMS, MU (firmware)",
+	"NLMS, rounded",
+	"sign-error",
+	"sign-sign"
+};
+
+/* module procedure declaration */
+static double Bench_run(uint32_t Rule, uint32_t numTaps, q15_t Mu,
+		uint16_t MuShift, q15_t Delta, q15_t *pSrc, q15_t *pMic, q15_t *pErr,
+		uint32_t Length);
+static void Bench_nlms(uint32_t numTaps, q15_t Mu, q15_t *pCoeffs,
+		q15_t *pSrc, q15_t *pMic, q15_t *pErr, uint32_t Length);
+static void Bench_metrics(q15_t *pSrc, q15_t *pMic, q15_t *pErr,
+		uint32_t Length, const char *pCsv, LMSMetricsReport *pReport);
+
+/*****************************************************************************/
+/*  Procedure   : main                                                       */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Runs every kernel on every scenario and prints a table     */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : argc, argv Options, see module header                      */
+/*                                                                           */
+/*  Output Para : Return     0, 2 if a recording can not be read             */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+int main(int argc, char *argv[]) {
+
+	/* procedure data */
+	const char *pDir = WAV_DIRECTORY;
+	const char *pPrefix = 0;
+	char Name[512];
+	char Csv[512];
+	uint32_t numTaps = 1700;
+	q15_t Mu = 16384;
+	uint16_t MuShift = 12;
+	q15_t Delta = 1;
+	q15_t *pSrc;
+	q15_t *pMic;
+	q15_t *pErr;
+	uint32_t SrcLength;
+	uint32_t MicLength;
+	uint32_t Length;
+	LMSMetricsReport Report[BENCH_RULES];
+	double Time[BENCH_RULES];
+	uint32_t f, r;
+	int a;
+
+	/* procedure code */
+	for (a = 1; a < argc; a++) {
+		if (a + 1 >= argc) {
+			fprintf(stderr, "Missing value of %s\n", argv[a]);
+			return 2;
+		} else if (strcmp(argv[a], "-taps") == 0) {
+			numTaps = (uint32_t) atol(argv[++a]);
+		} else if (strcmp(argv[a], "-mu") == 0) {
+			Mu = (q15_t) atoi(argv[++a]);
+		} else if (strcmp(argv[a], "-shift") == 0) {
+			MuShift = (uint16_t) atoi(argv[++a]);
+		} else if (strcmp(argv[a], "-delta") == 0) {
+			Delta = (q15_t) atoi(argv[++a]);
+		} else if (strcmp(argv[a], "-dir") == 0) {
+			pDir = argv[++a];
+		} else if (strcmp(argv[a], "-csv") == 0) {
+			pPrefix = argv[++a];
+		} else {
+			fprintf(stderr, "Unknown option %s\n", argv[a]);
+			return 2;
+		}
+	}
+	if ((numTaps < 4) || (numTaps > 65535)) {
+		fprintf(stderr, "Invalid number of taps\n");
+		return 2;
+	}
+
+	snprintf(Name, sizeof(Name), "%s/%s", pDir, BENCH_REFERENCE);
+	if (Wav_read(Name, FS, &pSrc, &SrcLength) != 0) {
+		fprintf(stderr, "Can not read %s\n", Name);
+		return 2;
+	}
+
+	printf("%u taps, FS %u, NLMS mu %d (firmware MU %d), sign-error 2^-%u, "
+			"sign-sign delta %d\n\n", numTaps, FS, Mu, BENCH_FIRMWARE_MU, MuShift,
+			Delta);
+	printf("%-28s %-20s %9s %9s %10s %9s %6s\n", "Scenario", "Kernel",
+			"ERLE/dB", "Short/dB", "20dB at/s", "ns/sample", "Time");
+	for (f = 0; f < BENCH_SCENARIOS; f++) {
+		snprintf(Name, sizeof(Name), "%s/%s", pDir, Scenarios[f]);
+		if (Wav_read(Name, FS, &pMic, &MicLength) != 0) {
+			fprintf(stderr, "Can not read %s\n", Name);
+			return 2;
+		}
+		Length = (SrcLength < MicLength) ? SrcLength : MicLength;
+		Length -= Length % BLOCK_SIZE;
+		pErr = (q15_t *) malloc(Length * sizeof(q15_t));
+
+		for (r = 0; r < BENCH_RULES; r++) {
+			Time[r] = Bench_run(r, numTaps, Mu, MuShift, Delta, pSrc, pMic,
+					pErr, Length);
+			if (pPrefix != 0) {
+				snprintf(Csv, sizeof(Csv), "%s_%u_%u.csv", pPrefix, f, r);
+			}
+			Bench_metrics(pSrc, pMic, pErr, Length,
+					(pPrefix != 0) ? Csv : 0, &Report[r]);
+		}
+
+		/* Time relative to arm_lms_q15() */
+		for (r = 0; r < BENCH_RULES; r++) {
+			printf("%-28s %-20s %9.1f %9.1f %10.2f %9.1f %5.0f%%\n",
+					Scenarios[f], Rules[r], Report[r].ErleLong,
+					Report[r].ErleShort, Report[r].ConvergenceTime,
+					1e9 * Time[r] / Length, 100.0 * Time[r] / Time[0]);
+		}
+		free(pErr);
+		free(pMic);
+	}
+	free(pSrc);
+	return 0;
+}
+/*****************************************************************************/
+/*  End         : main                                                       */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Bench_run                                                  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Runs one kernel over a scenario in blocks of BLOCK_SIZE    */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : Rule       Index into Rules[]                              */
+/*                numTaps    Filter length                                   */
+/*                Mu         Step of the NLMS (Q15), rule 1                  */
+/*                MuShift    Step of the sign-error LMS                      */
+/*                Delta      Step of the sign-sign LMS (Q15)                 */
+/*                pSrc       Reference [Length]                              */
+/*                pMic       Microphone [Length]                             */
+/*                Length     Number of samples                               */
+/*                                                                           */
+/*  Output Para : pErr       Error [Length]                                  */
+/*                Return     Time of the kernel [s]                          */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static double Bench_run(uint32_t Rule, uint32_t numTaps, q15_t Mu,
+		uint16_t MuShift, q15_t Delta, q15_t *pSrc, q15_t *pMic, q15_t *pErr,
+		uint32_t Length) {
+
+	/* procedure data */
+	arm_lms_instance_q15 Lms;
+	LMSSignInstanceQ15 Sign;
+	q15_t *pCoeffs = (q15_t *) calloc(numTaps, sizeof(q15_t));
+	q15_t *pState = (q15_t *) calloc(numTaps + BLOCK_SIZE - 1, sizeof(q15_t));
+	q15_t *pUpdate = (q15_t *) calloc(numTaps + BLOCK_SIZE - 1, sizeof(q15_t));
+	q15_t Out[BLOCK_SIZE];
+	struct timespec Start;
+	struct timespec End;
+	uint32_t i;
+
+	/* procedure code */
+	if (Rule == 0) {
+		arm_lms_init_q15(&Lms, (uint16_t) numTaps, pCoeffs, pState,
+				BENCH_FIRMWARE_MU, BLOCK_SIZE, 0);
+	} else if (Rule >= 2) {
+		LMSSign_init_q15(&Sign, (uint16_t) numTaps, pCoeffs, pState, pUpdate,
+				(Rule == 2) ? LMS_SIGN_ERROR : LMS_SIGN_SIGN, MuShift, Delta,
+				BLOCK_SIZE, 0);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &Start);
+	if (Rule == 1) {
+		Bench_nlms(numTaps, Mu, pCoeffs, pSrc, pMic, pErr, Length);
+	}
+	for (i = 0; (Rule != 1) && (i < Length); i += BLOCK_SIZE) {
+		if (Rule == 0) {
+			arm_lms_q15(&Lms, &pSrc[i], &pMic[i], Out, &pErr[i], BLOCK_SIZE);
+		} else {
+			LMSSign_q15(&Sign, &pSrc[i], &pMic[i], Out, &pErr[i], BLOCK_SIZE);
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &End);
+
+	free(pCoeffs);
+	free(pState);
+	free(pUpdate);
+	return (End.tv_sec - Start.tv_sec) + 1e-9 * (End.tv_nsec - Start.tv_nsec);
+}
+/*****************************************************************************/
+/*  End         : Bench_run                                                  */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Bench_nlms                                                 */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Q15 NLMS with a rounded update, the baseline of the bench  */
+/*                alpha = Mu * e / (sum x^2 + numTaps * BENCH_NLMS_FLOOR)    */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : numTaps    Filter length                                   */
+/*                Mu         Step (Q15)                                      */
+/*                pCoeffs    Coefficients [numTaps], zero                    */
+/*                pSrc       Reference [Length]                              */
+/*                pMic       Microphone [Length]                             */
+/*                Length     Number of samples                               */
+/*                                                                           */
+/*  Output Para : pErr       Error [Length]                                  */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Bench_nlms(uint32_t numTaps, q15_t Mu, q15_t *pCoeffs,
+		q15_t *pSrc, q15_t *pMic, q15_t *pErr, uint32_t Length) {
+
+	/* procedure data */
+	int64_t Power = 0;
+	int64_t Acc;
+	int64_t Alpha;
+	int32_t Coeff;
+	int32_t e;
+	uint32_t Taps;
+	uint32_t n, k;
+
+	/* procedure code */
+	for (n = 0; n < Length; n++) {
+		/* Power of the delay line, x[n] ... x[n - numTaps + 1] */
+		Power += (int64_t) pSrc[n] * pSrc[n];
+		if (n >= numTaps) {
+			Power -= (int64_t) pSrc[n - numTaps] * pSrc[n - numTaps];
+		}
+		Taps = (n < numTaps) ? n + 1 : numTaps;
+
+		/* Filter, as arm_lms_q15() */
+		Acc = 0;
+		for (k = 0; k < Taps; k++) {
+			Acc += (int64_t) pCoeffs[k] * pSrc[n - k];
+		}
+		e = pMic[n] - __SSAT((int32_t) (Acc >> 15), 16);
+		e = __SSAT(e, 16);
+		pErr[n] = (q15_t) e;
+
+		/* Normalised step in Q15 */
+		Alpha = ((int64_t) Mu * e * 32768)
+				/ (Power + (int64_t) numTaps * BENCH_NLMS_FLOOR);
+		Alpha = (Alpha > 32767) ? 32767 : ((Alpha < -32768) ? -32768 : Alpha);
+
+		/* Update, rounded */
+		for (k = 0; k < Taps; k++) {
+			Coeff = pCoeffs[k]
+					+ (int32_t) ((Alpha * pSrc[n - k] + 0x4000) >> 15);
+			pCoeffs[k] = (q15_t) __SSAT(Coeff, 16);
+		}
+	}
+}
+/*****************************************************************************/
+/*  End         : Bench_nlms                                                 */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Bench_metrics                                              */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Measures a run with LMSMetrics, as the target does         */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pSrc       Reference [Length]                              */
+/*                pMic       Microphone [Length]                             */
+/*                pErr       Error [Length]                                  */
+/*                Length     Number of samples                               */
+/*                pCsv       File for the ERLE over time, 0 = none           */
+/*                                                                           */
+/*  Output Para : pReport    Report at the end                               */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Bench_metrics(q15_t *pSrc, q15_t *pMic, q15_t *pErr,
+		uint32_t Length, const char *pCsv, LMSMetricsReport *pReport) {
+
+	/* procedure data */
+	LMSMetricsQ15 Metrics;
+	FILE *pFile = 0;
+	uint32_t i;
+
+	/* procedure code */
+	if (pCsv != 0) {
+		pFile = fopen(pCsv, "w");
+	}
+	if (pFile != 0) {
+		fprintf(pFile, "time,erle_short,erle_long,error_level\n");
+	}
+
+	LMSMetrics_init_q15(&Metrics);
+	for (i = 0; i < Length; i += BLOCK_SIZE) {
+		LMSMetrics_q15(&Metrics, &pSrc[i], &pMic[i], &pErr[i], BLOCK_SIZE);
+		if ((pFile != 0) && ((i + BLOCK_SIZE) % BENCH_CSV_INTERVAL == 0)) {
+			LMSMetrics_report(&Metrics, pReport);
+			fprintf(pFile, "%.2f,%.2f,%.2f,%.2f\n", pReport->Runtime,
+					pReport->ErleShort, pReport->ErleLong, pReport->ErrorLevel);
+		}
+	}
+	LMSMetrics_report(&Metrics, pReport);
+
+	if (pFile != 0) {
+		fclose(pFile);
+	}
+}
+/*****************************************************************************/
+/*  End         : Bench_metrics                                              */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : SignBench                                                  */
+/*****************************************************************************/
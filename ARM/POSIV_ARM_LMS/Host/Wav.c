@@ -0,0 +1,185 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : Wav (host)                                     Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Reader of 16 bit PCM mono wav files. The samples are taken  */
+/*               as Q15. Resampling picks the nearest sample without a       */
+/*               filter, as the MATLAB scripts do, so the host programs see  */
+/*               the same signals as the simulations.                        */
+/*                                                                           */
+/*  Procedures : Wav_read()                                                  */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : Wav.c                                                       */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "Wav.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* module constant declaration */
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+static uint32_t Wav_le(const uint8_t *pBytes, uint32_t Size);
+
+/*****************************************************************************/
+/*  Procedure   : Wav_read                                                   */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Reads a wav file and resamples it to Fs                    */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : pName      File name                                       */
+/*                Fs         Sampling frequency wanted, 0 = as recorded      */
+/*                                                                           */
+/*  Output Para : ppSamples  Samples (Q15), free() them                      */
+/*                pLength    Number of samples                               */
+/*                Return     0, or -1 if the file can not be read or is not  */
+/*                           16 bit PCM mono                                 */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+int Wav_read(const char *pName, uint32_t Fs, int16_t **ppSamples,
+		uint32_t *pLength) {
+
+	/* procedure data */
+	FILE *pFile;
+	uint8_t Header[8];
+	uint8_t Format[16];
+	uint32_t Size;
+	uint32_t FsWav = 0;
+	uint32_t Frames = 0;
+	int16_t *pWav = 0;
+	int16_t *pResampled;
+	uint32_t Length;
+	double Step;
+	uint32_t i;
+
+	/* procedure code */
+	pFile = fopen(pName, "rb");
+	if (pFile == 0) {
+		return -1;
+	}
+	if ((fread(Header, 1, 8, pFile) != 8) || (memcmp(Header, "RIFF", 4) != 0) ||
+			(fread(Header, 1, 4, pFile) != 4) ||
+			(memcmp(Header, "WAVE", 4) != 0)) {
+		fclose(pFile);
+		return -1;
+	}
+
+	/* Chunks up to the samples */
+	while (fread(Header, 1, 8, pFile) == 8) {
+		Size = Wav_le(&Header[4], 4);
+		if (memcmp(Header, "fmt ", 4) == 0) {
+			if ((Size < 16) || (fread(Format, 1, 16, pFile) != 16) ||
+					(Wav_le(&Format[0], 2) != 1) ||
+					(Wav_le(&Format[2], 2) != 1) ||
+					(Wav_le(&Format[14], 2) != 16)) {
+				break;
+			}
+			FsWav = Wav_le(&Format[4], 4);
+			fseek(pFile, (long) (Size - 16 + (Size & 1u)), SEEK_CUR);
+		} else if ((memcmp(Header, "data", 4) == 0) && (FsWav != 0)) {
+			Frames = Size / 2u;
+			pWav = (int16_t *) malloc(Frames * sizeof(int16_t) + 1u);
+			if ((pWav == 0) ||
+					(fread(pWav, sizeof(int16_t), Frames, pFile) != Frames)) {
+				Frames = 0;
+			}
+			break;
+		} else {
+			fseek(pFile, (long) (Size + (Size & 1u)), SEEK_CUR);
+		}
+	}
+	fclose(pFile);
+	if (Frames == 0) {
+		free(pWav);
+		return -1;
+	}
+
+	/* Little endian samples on any host */
+	for (i = 0; i < Frames; i++) {
+		pWav[i] = (int16_t) Wav_le((const uint8_t *) &pWav[i], 2);
+	}
+
+	/* Nearest sample, index round(1 + k * FsWav / Fs) - 1 */
+	if ((Fs != 0) && (Fs != FsWav)) {
+		Step = (double) FsWav / Fs;
+		for (Length = 0; (uint32_t) lround(Length * Step) < Frames; Length++) {
+		}
+		pResampled = (int16_t *) malloc(Length * sizeof(int16_t) + 1u);
+		if (pResampled == 0) {
+			free(pWav);
+			return -1;
+		}
+		for (i = 0; i < Length; i++) {
+			pResampled[i] = pWav[lround(i * Step)];
+		}
+		free(pWav);
+		pWav = pResampled;
+		Frames = Length;
+	}
+	*ppSamples = pWav;
+	*pLength = Frames;
+	return 0;
+}
+/*****************************************************************************/
+/*  End         : Wav_read                                                   */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Wav_le                                                     */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Reads an unsigned little endian number                     */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pBytes     Bytes                                           */
+/*                Size       Number of bytes (at most 4)                     */
+/*                                                                           */
+/*  Output Para : Return     Value                                           */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint32_t Wav_le(const uint8_t *pBytes, uint32_t Size) {
+
+	/* procedure data */
+	uint32_t Value = 0;
+
+	/* procedure code */
+	while (Size-- > 0) {
+		Value = (Value << 8) | pBytes[Size];
+	}
+	return Value;
+}
+/*****************************************************************************/
+/*  End         : Wav_le                                                     */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : Wav                                                        */
+/*****************************************************************************/
@@ -0,0 +1,43 @@
+#ifndef WAV_H
+#define WAV_H
+/*****************************************************************************/
+/*  Header     : Wav (host)                                     Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Reads the 16 bit mono .wav recordings of Matlab/ and brings */
+/*               them to the sampling frequency of the board the same way    */
+/*               the MATLAB scripts do (sound(round(1:fswav/fs:end)))        */
+/*                                                                           */
+/*  Procedures : Wav_read()                                                  */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : Wav.h                                                       */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include <stdint.h>
+
+/* module constant declaration  */
+
+/* Directory of the recordings, relative to Host/ */
+#define WAV_DIRECTORY "../../../Matlab"
+
+/* module type declaration      */
+
+/* module data declaration      */
+
+/* module procedure declaration */
+int Wav_read(const char *pName, uint32_t Fs, int16_t **ppSamples,
+		uint32_t *pLength);
+
+/*****************************************************************************/
+/*  End Header  : Wav                                                        */
+/*****************************************************************************/
+#endif
@@ -0,0 +1,254 @@
+#ifndef __CORE_CM4_SIMD_H
+#define __CORE_CM4_SIMD_H
+/*****************************************************************************/
+/*  Header     : core_cm4_simd (host)                           Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Host replacement of the CMSIS Cortex-M4 SIMD intrinsics, so */
+/*               the Cortex-M4 code of the DSP library and of src/ runs on a */
+/*               PC (simulations, regression against the board).             */
+/*                                                                           */
+/*               Every intrinsic gives bit exact the result of the           */
+/*               instruction (ARMv7-M Architecture Reference Manual), the    */
+/*               Q flag is not modelled. Saturating and dual multiply        */
+/*               operations use one SSE2 instruction on x86 (PADDSW,         */
+/*               PMADDWD, ...), everything else is plain C which the         */
+/*               compiler inlines into a few instructions.                   */
+/*                                                                           */
+/*               Host build: -DARM_MATH_CM4 -IHost -ILibraries/CMSIS/Include */
+/*               (Host before the CMSIS directory). core_cm4.h then takes    */
+/*               this file, core_cmInstr.h and core_cmFunc.h from Host/.     */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : core_cm4_simd.h                                             */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include <stdint.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* module constant declaration  */
+
+/* Signed halfwords and bytes of a word */
+#define __HOST_LO16(x)   ((int32_t) (int16_t) (uint16_t) (x))
+#define __HOST_HI16(x)   ((int32_t) (int16_t) (uint16_t) ((uint32_t) (x) >> 16))
+#define __HOST_B(x, n)   ((int32_t) (int8_t) (uint8_t) ((uint32_t) (x) >> (8 * (n))))
+#define __HOST_PACK16(hi, lo) \
+	((uint32_t) (((uint32_t) (uint16_t) (hi) << 16) | (uint16_t) (lo)))
+
+/* module type declaration      */
+
+/* module data declaration      */
+
+/* module procedure declaration */
+
+static inline int32_t __HOST_SAT16(int32_t x) {
+	return (x > 32767) ? 32767 : ((x < -32768) ? -32768 : x);
+}
+
+static inline int32_t __HOST_SAT8(int32_t x) {
+	return (x > 127) ? 127 : ((x < -128) ? -128 : x);
+}
+
+/* Saturating arithmetic */
+
+static inline uint32_t __QADD(uint32_t x, uint32_t y) {
+	int64_t r = (int64_t) (int32_t) x + (int32_t) y;
+	return (uint32_t) (int32_t) ((r > INT32_MAX) ? INT32_MAX : ((r < INT32_MIN) ? INT32_MIN : r));
+}
+
+static inline uint32_t __QSUB(uint32_t x, uint32_t y) {
+	int64_t r = (int64_t) (int32_t) x - (int32_t) y;
+	return (uint32_t) (int32_t) ((r > INT32_MAX) ? INT32_MAX : ((r < INT32_MIN) ? INT32_MIN : r));
+}
+
+static inline uint32_t __QADD16(uint32_t x, uint32_t y) {
+#if defined(__SSE2__)
+	return (uint32_t) _mm_cvtsi128_si32(_mm_adds_epi16(
+			_mm_cvtsi32_si128((int) x), _mm_cvtsi32_si128((int) y)));
+#else
+	return __HOST_PACK16(__HOST_SAT16(__HOST_HI16(x) + __HOST_HI16(y)),
+			__HOST_SAT16(__HOST_LO16(x) + __HOST_LO16(y)));
+#endif
+}
+
+static inline uint32_t __QSUB16(uint32_t x, uint32_t y) {
+#if defined(__SSE2__)
+	return (uint32_t) _mm_cvtsi128_si32(_mm_subs_epi16(
+			_mm_cvtsi32_si128((int) x), _mm_cvtsi32_si128((int) y)));
+#else
+	return __HOST_PACK16(__HOST_SAT16(__HOST_HI16(x) - __HOST_HI16(y)),
+			__HOST_SAT16(__HOST_LO16(x) - __HOST_LO16(y)));
+#endif
+}
+
+static inline uint32_t __QADD8(uint32_t x, uint32_t y) {
+#if defined(__SSE2__)
+	return (uint32_t) _mm_cvtsi128_si32(_mm_adds_epi8(
+			_mm_cvtsi32_si128((int) x), _mm_cvtsi32_si128((int) y)));
+#else
+	uint32_t r = 0;
+	int n;
+	for (n = 0; n < 4; n++) {
+		r |= (uint32_t) (uint8_t) __HOST_SAT8(__HOST_B(x, n) + __HOST_B(y, n)) << (8 * n);
+	}
+	return r;
+#endif
+}
+
+static inline uint32_t __QSUB8(uint32_t x, uint32_t y) {
+#if defined(__SSE2__)
+	return (uint32_t) _mm_cvtsi128_si32(_mm_subs_epi8(
+			_mm_cvtsi32_si128((int) x), _mm_cvtsi32_si128((int) y)));
+#else
+	uint32_t r = 0;
+	int n;
+	for (n = 0; n < 4; n++) {
+		r |= (uint32_t) (uint8_t) __HOST_SAT8(__HOST_B(x, n) - __HOST_B(y, n)) << (8 * n);
+	}
+	return r;
+#endif
+}
+
+static inline uint32_t __QASX(uint32_t x, uint32_t y) {
+	return __HOST_PACK16(__HOST_SAT16(__HOST_HI16(x) + __HOST_LO16(y)),
+			__HOST_SAT16(__HOST_LO16(x) - __HOST_HI16(y)));
+}
+
+static inline uint32_t __QSAX(uint32_t x, uint32_t y) {
+	return __HOST_PACK16(__HOST_SAT16(__HOST_HI16(x) - __HOST_LO16(y)),
+			__HOST_SAT16(__HOST_LO16(x) + __HOST_HI16(y)));
+}
+
+/* Wrapping and halving arithmetic */
+
+static inline uint32_t __SADD16(uint32_t x, uint32_t y) {
+	return __HOST_PACK16(__HOST_HI16(x) + __HOST_HI16(y),
+			__HOST_LO16(x) + __HOST_LO16(y));
+}
+
+static inline uint32_t __SSUB16(uint32_t x, uint32_t y) {
+	return __HOST_PACK16(__HOST_HI16(x) - __HOST_HI16(y),
+			__HOST_LO16(x) - __HOST_LO16(y));
+}
+
+static inline uint32_t __SHADD16(uint32_t x, uint32_t y) {
+	return __HOST_PACK16((__HOST_HI16(x) + __HOST_HI16(y)) >> 1,
+			(__HOST_LO16(x) + __HOST_LO16(y)) >> 1);
+}
+
+static inline uint32_t __SHSUB16(uint32_t x, uint32_t y) {
+	return __HOST_PACK16((__HOST_HI16(x) - __HOST_HI16(y)) >> 1,
+			(__HOST_LO16(x) - __HOST_LO16(y)) >> 1);
+}
+
+static inline uint32_t __SHASX(uint32_t x, uint32_t y) {
+	return __HOST_PACK16((__HOST_HI16(x) + __HOST_LO16(y)) >> 1,
+			(__HOST_LO16(x) - __HOST_HI16(y)) >> 1);
+}
+
+static inline uint32_t __SHSAX(uint32_t x, uint32_t y) {
+	return __HOST_PACK16((__HOST_HI16(x) - __HOST_LO16(y)) >> 1,
+			(__HOST_LO16(x) + __HOST_HI16(y)) >> 1);
+}
+
+/* Dual 16 bit multiplies, 32 bit results wrap like the instructions */
+
+static inline uint32_t __SMUAD(uint32_t x, uint32_t y) {
+#if defined(__SSE2__)
+	return (uint32_t) _mm_cvtsi128_si32(_mm_madd_epi16(
+			_mm_cvtsi32_si128((int) x), _mm_cvtsi32_si128((int) y)));
+#else
+	return (uint32_t) (__HOST_LO16(x) * __HOST_LO16(y)) +
+			(uint32_t) (__HOST_HI16(x) * __HOST_HI16(y));
+#endif
+}
+
+static inline uint32_t __SMUADX(uint32_t x, uint32_t y) {
+	return __SMUAD(x, (y >> 16) | (y << 16));
+}
+
+static inline uint32_t __SMLAD(uint32_t x, uint32_t y, uint32_t sum) {
+	return __SMUAD(x, y) + sum;
+}
+
+static inline uint32_t __SMLADX(uint32_t x, uint32_t y, uint32_t sum) {
+	return __SMUADX(x, y) + sum;
+}
+
+static inline uint32_t __SMUSD(uint32_t x, uint32_t y) {
+	return (uint32_t) (__HOST_LO16(x) * __HOST_LO16(y)) -
+			(uint32_t) (__HOST_HI16(x) * __HOST_HI16(y));
+}
+
+static inline uint32_t __SMUSDX(uint32_t x, uint32_t y) {
+	return (uint32_t) (__HOST_LO16(x) * __HOST_HI16(y)) -
+			(uint32_t) (__HOST_HI16(x) * __HOST_LO16(y));
+}
+
+static inline uint32_t __SMLSD(uint32_t x, uint32_t y, uint32_t sum) {
+	return __SMUSD(x, y) + sum;
+}
+
+static inline uint32_t __SMLSDX(uint32_t x, uint32_t y, uint32_t sum) {
+	return __SMUSDX(x, y) + sum;
+}
+
+/* Dual 16 bit multiplies with 64 bit accumulator (PMADDWD would wrap for */
+/* 0x8000 * 0x8000 twice, so these stay in C)                             */
+
+static inline uint64_t __SMLALD(uint32_t x, uint32_t y, uint64_t sum) {
+	return sum + (uint64_t) (int64_t) __HOST_LO16(x) * __HOST_LO16(y) +
+			(uint64_t) (int64_t) __HOST_HI16(x) * __HOST_HI16(y);
+}
+
+static inline uint64_t __SMLALDX(uint32_t x, uint32_t y, uint64_t sum) {
+	return sum + (uint64_t) (int64_t) __HOST_LO16(x) * __HOST_HI16(y) +
+			(uint64_t) (int64_t) __HOST_HI16(x) * __HOST_LO16(y);
+}
+
+static inline uint64_t __SMLSLD(uint32_t x, uint32_t y, uint64_t sum) {
+	return sum + (uint64_t) (int64_t) __HOST_LO16(x) * __HOST_LO16(y) -
+			(uint64_t) (int64_t) __HOST_HI16(x) * __HOST_HI16(y);
+}
+
+static inline uint64_t __SMLSLDX(uint32_t x, uint32_t y, uint64_t sum) {
+	return sum + (uint64_t) (int64_t) __HOST_LO16(x) * __HOST_HI16(y) -
+			(uint64_t) (int64_t) __HOST_HI16(x) * __HOST_LO16(y);
+}
+
+/* Packing and extension */
+
+#define __PKHBT(ARG1, ARG2, ARG3) \
+	((((uint32_t) (ARG1)) & 0x0000FFFFUL) | \
+	((((uint32_t) (ARG2)) << (ARG3)) & 0xFFFF0000UL))
+
+#define __PKHTB(ARG1, ARG2, ARG3) \
+	((((uint32_t) (ARG1)) & 0xFFFF0000UL) | \
+	(((uint32_t) (((int32_t) (ARG2)) >> (ARG3))) & 0x0000FFFFUL))
+
+static inline uint32_t __SXTB16(uint32_t x) {
+	return __HOST_PACK16(__HOST_B(x, 2), __HOST_B(x, 0));
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*****************************************************************************/
+/*  End Header  : core_cm4_simd (host)                                       */
+/*****************************************************************************/
+#endif
@@ -0,0 +1,61 @@
+#ifndef __CORE_CMFUNC_H
+#define __CORE_CMFUNC_H
+/*****************************************************************************/
+/*  Header     : core_cmFunc (host)                             Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Host replacement of the CMSIS core register access          */
+/*               functions (see core_cm4_simd.h in this directory). There    */
+/*               are no interrupts on the host: the functions do nothing,    */
+/*               registers read as 0.                                        */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : core_cmFunc.h                                               */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include <stdint.h>
+
+/* module constant declaration  */
+
+#define __enable_irq()             do { } while (0)
+#define __disable_irq()            do { } while (0)
+#define __enable_fault_irq()       do { } while (0)
+#define __disable_fault_irq()      do { } while (0)
+
+#define __get_CONTROL()            (0UL)
+#define __get_IPSR()               (0UL)
+#define __get_APSR()               (0UL)
+#define __get_xPSR()               (0UL)
+#define __get_PSP()                (0UL)
+#define __get_MSP()                (0UL)
+#define __get_PRIMASK()            (0UL)
+#define __get_BASEPRI()            (0UL)
+#define __get_FAULTMASK()          (0UL)
+#define __get_FPSCR()              (0UL)
+
+#define __set_CONTROL(value)       ((void) (value))
+#define __set_PSP(value)           ((void) (value))
+#define __set_MSP(value)           ((void) (value))
+#define __set_PRIMASK(value)       ((void) (value))
+#define __set_BASEPRI(value)       ((void) (value))
+#define __set_FAULTMASK(value)     ((void) (value))
+#define __set_FPSCR(value)         ((void) (value))
+
+/* module type declaration      */
+
+/* module data declaration      */
+
+/* module procedure declaration */
+
+/*****************************************************************************/
+/*  End Header  : core_cmFunc (host)                                         */
+/*****************************************************************************/
+#endif
@@ -0,0 +1,123 @@
+#ifndef __CORE_CMINSTR_H
+#define __CORE_CMINSTR_H
+/*****************************************************************************/
+/*  Header     : core_cmInstr (host)                            Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Host replacement of the CMSIS core instruction intrinsics   */
+/*               (see core_cm4_simd.h in this directory). Barriers and sleep */
+/*               instructions are compiler barriers only, exclusive stores   */
+/*               always succeed.                                             */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : core_cmInstr.h                                              */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include <stdint.h>
+
+/* module constant declaration  */
+
+#define __HOST_BARRIER() __asm__ volatile ("" ::: "memory")
+
+#define __NOP()   __HOST_BARRIER()
+#define __WFI()   __HOST_BARRIER()
+#define __WFE()   __HOST_BARRIER()
+#define __SEV()   __HOST_BARRIER()
+#define __ISB()   __HOST_BARRIER()
+#define __DSB()   __HOST_BARRIER()
+#define __DMB()   __HOST_BARRIER()
+#define __CLREX() __HOST_BARRIER()
+
+/* Saturation to ARG2 bits (1..32 signed, 0..31 unsigned) */
+#define __SSAT(ARG1, ARG2) __HOST_SSAT((int32_t) (ARG1), (ARG2))
+#define __USAT(ARG1, ARG2) __HOST_USAT((int32_t) (ARG1), (ARG2))
+
+/* module type declaration      */
+
+/* module data declaration      */
+
+/* module procedure declaration */
+
+static inline int32_t __HOST_SSAT(int32_t x, uint32_t bits) {
+	int32_t Max;
+	if (bits >= 32u) {
+		return x;
+	}
+	Max = (int32_t) ((1u << (bits - 1u)) - 1u);
+	return (x > Max) ? Max : ((x < -Max - 1) ? -Max - 1 : x);
+}
+
+static inline uint32_t __HOST_USAT(int32_t x, uint32_t bits) {
+	uint32_t Max = (bits >= 32u) ? 0xFFFFFFFFUL : ((1u << bits) - 1u);
+	return (x < 0) ? 0 : (((uint32_t) x > Max) ? Max : (uint32_t) x);
+}
+
+static inline uint32_t __REV(uint32_t value) {
+	return __builtin_bswap32(value);
+}
+
+static inline uint32_t __REV16(uint32_t value) {
+	return ((value & 0xFF00FF00UL) >> 8) | ((value & 0x00FF00FFUL) << 8);
+}
+
+static inline int32_t __REVSH(int32_t value) {
+	return (int32_t) (int16_t) (((value & 0xFF00) >> 8) | ((value & 0x00FF) << 8));
+}
+
+static inline uint32_t __ROR(uint32_t op1, uint32_t op2) {
+	op2 &= 31u;
+	return (op2 == 0u) ? op1 : ((op1 >> op2) | (op1 << (32u - op2)));
+}
+
+static inline uint32_t __RBIT(uint32_t value) {
+	uint32_t Result = 0;
+	int n;
+	for (n = 0; n < 32; n++) {
+		Result = (Result << 1) | ((value >> n) & 1u);
+	}
+	return Result;
+}
+
+static inline uint8_t __CLZ(uint32_t value) {
+	return (uint8_t) ((value == 0u) ? 32 : __builtin_clz(value));
+}
+
+static inline uint8_t __LDREXB(volatile uint8_t *addr) {
+	return *addr;
+}
+
+static inline uint16_t __LDREXH(volatile uint16_t *addr) {
+	return *addr;
+}
+
+static inline uint32_t __LDREXW(volatile uint32_t *addr) {
+	return *addr;
+}
+
+static inline uint32_t __STREXB(uint8_t value, volatile uint8_t *addr) {
+	*addr = value;
+	return 0;
+}
+
+static inline uint32_t __STREXH(uint16_t value, volatile uint16_t *addr) {
+	*addr = value;
+	return 0;
+}
+
+static inline uint32_t __STREXW(uint32_t value, volatile uint32_t *addr) {
+	*addr = value;
+	return 0;
+}
+
+/*****************************************************************************/
+/*  End Header  : core_cmInstr (host)                                        */
+/*****************************************************************************/
+#endif
@@ -0,0 +1,240 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : Arena                                          Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Static bump allocator over the RAM the linker leaves free.  */
+/*                                                                           */
+/*               stm32f4_flash.ld exports the free SRAM between heap and     */
+/*               stack (_sarena ... _earena) and the free CCM RAM behind     */
+/*               the .ccmram section (_sarena_ccm ... _earena_ccm).          */
+/*               Allocations move a pointer up, there is no free of single   */
+/*               blocks, only Arena_reset() of everything. So there is no    */
+/*               fragmentation and the same init sequence always gives the   */
+/*               same addresses.                                             */
+/*                                                                           */
+/*               Only allowed at init time (InitProcessing() or from the     */
+/*               idle loop while the memory is not in use), never from an    */
+/*               interrupt. Allocated memory is cleared.                     */
+/*                                                                           */
+/*  Procedures : Arena_init()                                                */
+/*               Arena_init_region()                                         */
+/*               Arena_alloc()                                               */
+/*               Arena_reset()                                               */
+/*               Arena_report()                                              */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : Arena.c                                                     */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include <string.h>
+#include "Arena.h"
+
+/* module constant declaration */
+
+/* module type declaration */
+
+typedef struct
+{
+	uint8_t *pStart;
+	uint8_t *pNext;
+	uint8_t *pEnd;
+} ArenaRegion;
+
+/* module data declaration */
+
+#if defined(STM32F4XX)
+/* Bounds of the free memory, from stm32f4_flash.ld */
+extern uint8_t _sarena[];
+extern uint8_t _earena[];
+extern uint8_t _sarena_ccm[];
+extern uint8_t _earena_ccm[];
+#endif
+
+static ArenaRegion Regions[ARENA_REGIONS];
+static uint32_t Failed;
+
+/* module procedure declaration */
+
+#if defined(STM32F4XX)
+/*****************************************************************************/
+/*  Procedure   : Arena_init                                                 */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Takes the free SRAM and CCM RAM given by the linker script */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void Arena_init(void) {
+
+	/* procedure code */
+	Arena_init_region(ARENA_SRAM, _sarena, _earena);
+	Arena_init_region(ARENA_CCM, _sarena_ccm, _earena_ccm);
+}
+/*****************************************************************************/
+/*  End         : Arena_init                                                 */
+/*****************************************************************************/
+#endif
+
+/*****************************************************************************/
+/*  Procedure   : Arena_init_region                                          */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Sets the memory of one region, all of it free (also for    */
+/*                host builds, which have no linker symbols)                 */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : Region     ARENA_SRAM or ARENA_CCM                         */
+/*                pStart     First byte of the region                        */
+/*                pEnd       First byte behind the region                    */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void Arena_init_region(uint8_t Region, void *pStart, void *pEnd) {
+
+	/* procedure code */
+	Regions[Region].pStart = (uint8_t *) pStart;
+	Regions[Region].pNext = (uint8_t *) pStart;
+	Regions[Region].pEnd = (uint8_t *) pEnd;
+}
+/*****************************************************************************/
+/*  End         : Arena_init_region                                          */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Arena_alloc                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Allocates a cleared block from a region                    */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : Region     ARENA_SRAM or ARENA_CCM                         */
+/*                Size       Number of bytes                                 */
+/*                Align      Alignment in bytes (power of 2), 0 for          */
+/*                           ARENA_ALIGN                                     */
+/*                                                                           */
+/*  Output Para : Return     Block, 0 if the region is too small             */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void *Arena_alloc(uint8_t Region, uint32_t Size, uint32_t Align) {
+
+	/* procedure data */
+	ArenaRegion *pRegion = &Regions[Region];
+	uintptr_t Address;
+
+	/* procedure code */
+	if (Align == 0) {
+		Align = ARENA_ALIGN;
+	}
+	Address = ((uintptr_t) pRegion->pNext + (Align - 1u)) & ~(uintptr_t) (Align - 1u);
+
+	if ((pRegion->pStart == 0) || (Address > (uintptr_t) pRegion->pEnd) ||
+			(Size > (uintptr_t) pRegion->pEnd - Address)) {
+		Failed++;
+		return 0;
+	}
+
+	pRegion->pNext = (uint8_t *) (Address + Size);
+	memset((void *) Address, 0, Size);
+	return (void *) Address;
+}
+/*****************************************************************************/
+/*  End         : Arena_alloc                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Arena_reset                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Frees all blocks of all regions                            */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void Arena_reset(void) {
+
+	/* procedure data */
+	uint32_t r;
+
+	/* procedure code */
+	for (r = 0; r < ARENA_REGIONS; r++) {
+		Regions[r].pNext = Regions[r].pStart;
+	}
+}
+/*****************************************************************************/
+/*  End         : Arena_reset                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Arena_report                                               */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Reports size and usage of every region                     */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : pReport    Usage in bytes                                  */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void Arena_report(ArenaReport *pReport) {
+
+	/* procedure data */
+	uint32_t r;
+
+	/* procedure code */
+	for (r = 0; r < ARENA_REGIONS; r++) {
+		pReport->Size[r] = (uint32_t) (Regions[r].pEnd - Regions[r].pStart);
+		pReport->Used[r] = (uint32_t) (Regions[r].pNext - Regions[r].pStart);
+	}
+	pReport->Failed = Failed;
+}
+/*****************************************************************************/
+/*  End         : Arena_report                                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : Arena                                                      */
+/*****************************************************************************/
@@ -0,0 +1,63 @@
+#ifndef ARENA_H
+#define ARENA_H
+/*****************************************************************************/
+/*  Header     : Arena                                          Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Static bump allocator over the free SRAM and CCM RAM, for   */
+/*               buffers sized at InitProcessing() time                      */
+/*                                                                           */
+/*  Procedures : Arena_init()                                                */
+/*               Arena_init_region()                                         */
+/*               Arena_alloc()                                               */
+/*               Arena_reset()                                               */
+/*               Arena_report()                                              */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : Arena.h                                                     */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include <stdint.h>
+
+/* module constant declaration  */
+
+/* Regions. CCM RAM is faster (no bus matrix contention with the DMA), */
+/* but the DMA can not access it: only for coefficients and states     */
+#define ARENA_SRAM 0
+#define ARENA_CCM 1
+#define ARENA_REGIONS 2
+
+/* Default alignment (LDRD, 64 bit loads of the SIMD kernels) */
+#define ARENA_ALIGN 8
+
+/* module type declaration      */
+
+/* Usage of the regions in bytes, for the debugger */
+typedef struct
+{
+	uint32_t Size[ARENA_REGIONS];
+	uint32_t Used[ARENA_REGIONS];
+	uint32_t Failed;              /* Number of refused allocations */
+} ArenaReport;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+void Arena_init(void);
+void Arena_init_region(uint8_t Region, void *pStart, void *pEnd);
+void *Arena_alloc(uint8_t Region, uint32_t Size, uint32_t Align);
+void Arena_reset(void);
+void Arena_report(ArenaReport *pReport);
+
+/*****************************************************************************/
+/*  End Header  : Arena                                                      */
+/*****************************************************************************/
+#endif
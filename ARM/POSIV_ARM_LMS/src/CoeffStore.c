@@ -0,0 +1,834 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : CoeffStore                                     Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Persistent snapshots of converged filter coefficients.      */
+/*                                                                           */
+/*               Records (CoeffStoreHeader and the coefficients) are         */
+/*               appended one after the other to one of two reserved flash   */
+/*               sectors. The newest valid record (highest Sequence, CRC     */
+/*               ok) is the one to start from. A sector is only erased when  */
+/*               the newest record is in the other one, so there is always a */
+/*               valid record and both sectors wear evenly: with 3.4kB       */
+/*               records (1700 Q15 taps) a sector takes 37 records, at one   */
+/*               record every 10 minutes the 10000 erase cycles last for     */
+/*               about 14 years.                                             */
+/*                                                                           */
+/*               CoeffStore_init() erases the sector without the newest      */
+/*               record at boot, before the DMA is started. At runtime, as   */
+/*               soon as the sector written has no room for one more record  */
+/*               (19 float records of 6.8kB, 3 hours at 10 minutes),         */
+/*               CoeffStore_idle() erases the other one, whose records are   */
+/*               all older, and the next record goes there: the sectors are  */
+/*               used as a ring and the newest record is never older than    */
+/*               one interval. The erase stalls every flash read for 1 to 2s */
+/*               and with it the interrupts not running from RAM, once per   */
+/*               sector of records; CoeffStore_busy() is 1 meanwhile.        */
+/*               Writing is a state machine driven by CoeffStore_idle(),     */
+/*               one word per call and only when the flash is not busy. A    */
+/*               word programmed delays the interrupt by at most about 16us. */
+/*                                                                           */
+/*               The data is read while it is written, so it must not change */
+/*               until CoeffStore_busy() is 0: the caller passes a copy, not */
+/*               the coefficients the filter keeps adapting. The CRC is      */
+/*               taken over the words actually written.                      */
+/*                                                                           */
+/*               Host builds keep the sectors in a file, COEFF_STORE_FILE,   */
+/*               every word is written through, so a record cut off by a     */
+/*               reset stays torn in the file as it would in the flash.      */
+/*                                                                           */
+/*  Procedures : CoeffStore_init()                                           */
+/*               CoeffStore_latest()                                         */
+/*               CoeffStore_save()                                           */
+/*               CoeffStore_idle()                                           */
+/*               CoeffStore_busy()                                           */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : CoeffStore.c                                                */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include <string.h>
+#include "CoeffStore.h"
+#if defined(STM32F4XX)
+#include "stm32f4xx.h"
+#else
+#include <stdio.h>
+#endif
+
+/* module constant declaration */
+
+#define COEFF_STORE_MAGIC 0x57434653
+#define COEFF_STORE_ERASED 0xFFFFFFFF
+#define COEFF_STORE_HEADER_BYTES (COEFF_STORE_HEADER_WORDS * 4)
+
+/* Header words written before the data (Size ... Erle) */
+#define COEFF_STORE_HEAD_WORDS 5
+
+/* module type declaration */
+
+/* module data declaration */
+
+#if defined(STM32F4XX)
+/* Reserved sectors, from stm32f4_flash.ld */
+extern uint8_t _scoeffs[];
+#else
+/* Flash of the host build and its file */
+static uint32_t Image[COEFF_STORE_SECTORS * COEFF_STORE_SECTOR_SIZE / 4];
+static FILE *pImageFile;
+#endif
+
+static uint8_t *pSector[COEFF_STORE_SECTORS];
+static uint32_t Free[COEFF_STORE_SECTORS];    /* First free byte */
+static uint8_t Blank[COEFF_STORE_SECTORS];    /* Erased, nothing written */
+static uint8_t WriteSector;
+static uint32_t MaxLength;                     /* Largest record [bytes] */
+static volatile uint8_t Erasing;               /* Other sector erased    */
+static const CoeffStoreHeader *pLatest;
+static uint32_t NextSequence;
+
+/* Record being written */
+static CoeffStoreHeader Record;
+static const uint8_t *pRecordData;
+static uint32_t *pRecordFlash;
+static uint32_t DataWords;
+static uint32_t Step;
+static uint32_t Crc;
+static volatile uint8_t Writing;
+
+/* module procedure declaration */
+
+static void Flash_open(void);
+static void Flash_erase(uint8_t Sector);
+static void Record_next(void);
+static uint8_t Flash_blank(uint8_t Sector);
+static void Flash_unlock(void);
+static void Flash_lock(void);
+static uint8_t Flash_busy(void);
+static uint8_t Flash_error(void);
+static void Flash_program(uint32_t *pAddress, uint32_t Data);
+#if !defined(STM32F4XX)
+static void Flash_write(const void *pAddress, uint32_t Bytes);
+#endif
+static uint32_t Crc_word(uint32_t Crc, uint32_t Word);
+static uint8_t Record_valid(const CoeffStoreHeader *pHeader);
+
+/*****************************************************************************/
+/*  Procedure   : CoeffStore_init                                            */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Finds the newest record and makes room for the next one,   */
+/*                erases the sector without the newest record if needed      */
+/*                (blocking, call before the DMA is started)                 */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : MaxSize    Largest data (bytes) of a record to be saved    */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void CoeffStore_init(uint32_t MaxSize) {
+
+	/* procedure data */
+	const CoeffStoreHeader *pHeader;
+	uint32_t Position;
+	uint8_t Newest = 0;
+	uint8_t k;
+
+	/* procedure code */
+	Flash_open();
+	pLatest = 0;
+	Writing = 0;
+	Erasing = 0;
+	WriteSector = 0;
+
+	/* Walk the records of both sectors */
+	for (k = 0; k < COEFF_STORE_SECTORS; k++) {
+		Position = 0;
+		while (Position + COEFF_STORE_HEADER_BYTES <= COEFF_STORE_SECTOR_SIZE) {
+			pHeader = (const CoeffStoreHeader *) (pSector[k] + Position);
+			if (pHeader->Size == COEFF_STORE_ERASED) {
+				break;
+			}
+			if (pHeader->Size > COEFF_STORE_SECTOR_SIZE - COEFF_STORE_HEADER_BYTES -
+					Position) {
+				/* Size destroyed, the rest of the sector is lost */
+				Position = COEFF_STORE_SECTOR_SIZE;
+				break;
+			}
+			if (Record_valid(pHeader) && ((pLatest == 0) ||
+					((int32_t) (pHeader->Sequence - pLatest->Sequence) > 0))) {
+				pLatest = pHeader;
+				Newest = k;
+			}
+			Position += COEFF_STORE_HEADER_BYTES + ((pHeader->Size + 3u) & ~3u);
+		}
+		Free[k] = Position;
+	}
+	NextSequence = (pLatest != 0) ? pLatest->Sequence + 1u : 1u;
+
+	/* Only older records in the sector without the newest one: erase it */
+	/* now, so that no erase is needed until the next reset              */
+	for (k = 0; k < COEFF_STORE_SECTORS; k++) {
+		Blank[k] = Flash_blank(k);
+		if (!Blank[k] && ((pLatest == 0) || (k != Newest))) {
+			Flash_erase(k);
+			while (Flash_busy()) {
+			}
+			Flash_lock();
+			Blank[k] = 1;
+		}
+		if (Blank[k]) {
+			Free[k] = 0;
+		}
+	}
+
+	/* Continue after the newest record, in the other sector if there is */
+	/* no room for one more                                              */
+	WriteSector = Newest;
+	MaxLength = COEFF_STORE_HEADER_BYTES + ((MaxSize + 3u) & ~3u);
+	Record_next();
+}
+/*****************************************************************************/
+/*  End         : CoeffStore_init                                            */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : CoeffStore_latest                                          */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Gives the newest valid record, its data follows the header */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : Return     Header of the record, 0 if there is none        */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+const CoeffStoreHeader *CoeffStore_latest(void) {
+
+	/* procedure code */
+	return pLatest;
+}
+/*****************************************************************************/
+/*  End         : CoeffStore_latest                                          */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : CoeffStore_save                                            */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Starts writing a record, CoeffStore_idle() does the work.  */
+/*                pData must stay unchanged until CoeffStore_busy() is 0.    */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : pInfo      Size, Format, numTaps, Delay and Erle           */
+/*                pData      Coefficients [pInfo->Size bytes]                */
+/*                                                                           */
+/*  Output Para : Return     1 if started, 0 while a record is written or a  */
+/*                           sector erased (CoeffStore_busy())               */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+uint8_t CoeffStore_save(const CoeffStoreHeader *pInfo, const void *pData) {
+
+	/* procedure data */
+	uint32_t Length = COEFF_STORE_HEADER_BYTES + ((pInfo->Size + 3u) & ~3u);
+
+	/* procedure code */
+	if (Writing || Erasing || (Length > MaxLength) ||
+			(COEFF_STORE_SECTOR_SIZE - Free[WriteSector] < Length)) {
+		/* No room only if the other sector could not be erased */
+		return 0;
+	}
+	Blank[WriteSector] = 0;
+
+	Record = *pInfo;
+	Record.Sequence = NextSequence++;
+	Record.Magic = COEFF_STORE_MAGIC;
+	pRecordData = (const uint8_t *) pData;
+	pRecordFlash = (uint32_t *) (pSector[WriteSector] + Free[WriteSector]);
+	DataWords = (pInfo->Size + 3u) / 4u;
+	Step = 0;
+	Crc = COEFF_STORE_ERASED;
+
+	/* The space is taken even if the record is not completed */
+	Free[WriteSector] += Length;
+
+	Flash_unlock();
+	Writing = 1;
+	return 1;
+}
+/*****************************************************************************/
+/*  End         : CoeffStore_save                                            */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : CoeffStore_idle                                            */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Programs the next word of the record being written, or     */
+/*                ends the erase of a sector, call from the idle loop.       */
+/*                Returns at once while the flash is busy.                   */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void CoeffStore_idle(void) {
+
+	/* procedure data */
+	const uint32_t *pHeader = (const uint32_t *) &Record;
+	uint32_t Word;
+	uint32_t Offset;
+
+	/* procedure code */
+	if ((!Writing && !Erasing) || Flash_busy()) {
+		return;
+	}
+	if (Erasing) {
+		/* Also after an error, the sector is checked */
+		Flash_lock();
+		Erasing = 0;
+		Blank[1u - WriteSector] = Flash_blank((uint8_t) (1u - WriteSector));
+		if (Blank[1u - WriteSector]) {
+			Record_next();
+		}
+		return;
+	}
+	if (Flash_error()) {
+		/* The record stays incomplete (no Magic) and is skipped */
+		Flash_lock();
+		Writing = 0;
+		Record_next();
+		return;
+	}
+
+	if (Step < COEFF_STORE_HEAD_WORDS) {
+		/* Size, Sequence, Format/numTaps, Delay, Erle */
+		Word = pHeader[Step];
+		Crc = Crc_word(Crc, Word);
+		Flash_program(&pRecordFlash[Step], Word);
+	} else if (Step < COEFF_STORE_HEAD_WORDS + DataWords) {
+		/* Data, the last word padded with erased bytes */
+		Offset = (Step - COEFF_STORE_HEAD_WORDS) * 4u;
+		Word = COEFF_STORE_ERASED;
+		memcpy(&Word, pRecordData + Offset,
+				(Record.Size - Offset < 4u) ? Record.Size - Offset : 4u);
+		Crc = Crc_word(Crc, Word);
+		Flash_program(&pRecordFlash[COEFF_STORE_HEADER_WORDS + Step -
+				COEFF_STORE_HEAD_WORDS], Word);
+	} else if (Step == COEFF_STORE_HEAD_WORDS + DataWords) {
+		Record.Crc = Crc;
+		Flash_program(&pRecordFlash[COEFF_STORE_HEAD_WORDS], Crc);
+	} else if (Step == COEFF_STORE_HEAD_WORDS + DataWords + 1u) {
+		Flash_program(&pRecordFlash[COEFF_STORE_HEAD_WORDS + 1u], Record.Magic);
+	} else {
+		/* Magic is written, the record is valid */
+		Flash_lock();
+		pLatest = (const CoeffStoreHeader *) pRecordFlash;
+		Writing = 0;
+		Record_next();
+		return;
+	}
+	Step++;
+}
+/*****************************************************************************/
+/*  End         : CoeffStore_idle                                            */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : CoeffStore_busy                                            */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Tells whether a record is written or a sector erased       */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : Return     1 while the store works, 0 when idle            */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+uint8_t CoeffStore_busy(void) {
+
+	/* procedure code */
+	return Writing || Erasing;
+}
+/*****************************************************************************/
+/*  End         : CoeffStore_busy                                            */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Flash_open                                                 */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Sets the addresses of the sectors, host builds read them   */
+/*                from COEFF_STORE_FILE (erased if there is none) and keep   */
+/*                it open                                                    */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Flash_open(void) {
+
+	/* procedure data */
+	uint8_t *pStart;
+	uint8_t k;
+
+	/* procedure code */
+#if defined(STM32F4XX)
+	pStart = _scoeffs;
+#else
+	pStart = (uint8_t *) Image;
+	memset(Image, 0xFF, sizeof(Image));
+	if (pImageFile != 0) {
+		fclose(pImageFile);
+	}
+	pImageFile = fopen(COEFF_STORE_FILE, "r+b");
+	if ((pImageFile == 0) ||
+			(fread(Image, 1, sizeof(Image), pImageFile) != sizeof(Image))) {
+		/* None or damaged: a new erased flash */
+		if (pImageFile != 0) {
+			fclose(pImageFile);
+		}
+		memset(Image, 0xFF, sizeof(Image));
+		pImageFile = fopen(COEFF_STORE_FILE, "w+b");
+		Flash_write(Image, sizeof(Image));
+	}
+#endif
+	for (k = 0; k < COEFF_STORE_SECTORS; k++) {
+		pSector[k] = pStart + k * COEFF_STORE_SECTOR_SIZE;
+	}
+}
+/*****************************************************************************/
+/*  End         : Flash_open                                                 */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Flash_erase                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Starts erasing one sector, Flash_busy() until it is done,  */
+/*                then Flash_lock()                                          */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : Sector     Sector (0 or 1) of the store                    */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Flash_erase(uint8_t Sector) {
+
+	/* procedure code */
+#if defined(STM32F4XX)
+	Flash_unlock();
+	FLASH->CR = (FLASH->CR & ~(FLASH_CR_PSIZE | FLASH_CR_SNB)) |
+			FLASH_PSIZE_WORD | FLASH_CR_SER |
+			((Sector == 0) ? FLASH_Sector_10 : FLASH_Sector_11);
+	FLASH->CR |= FLASH_CR_STRT;
+#else
+	memset(pSector[Sector], 0xFF, COEFF_STORE_SECTOR_SIZE);
+	Flash_write(pSector[Sector], COEFF_STORE_SECTOR_SIZE);
+#endif
+}
+/*****************************************************************************/
+/*  End         : Flash_erase                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Flash_blank                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Tells whether a sector is erased                           */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : Sector     Sector (0 or 1) of the store                    */
+/*                                                                           */
+/*  Output Para : Return     1 if every word is erased                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint8_t Flash_blank(uint8_t Sector) {
+
+	/* procedure data */
+	const uint32_t *pWord = (const uint32_t *) pSector[Sector];
+	uint32_t i;
+
+	/* procedure code */
+	for (i = 0; i < COEFF_STORE_SECTOR_SIZE / 4u; i++) {
+		if (pWord[i] != COEFF_STORE_ERASED) {
+			return 0;
+		}
+	}
+	return 1;
+}
+/*****************************************************************************/
+/*  End         : Flash_blank                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Flash_unlock                                               */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Unlocks the flash for programming                          */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Flash_unlock(void) {
+
+	/* procedure code */
+#if defined(STM32F4XX)
+	FLASH_Unlock();
+	FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
+			FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+#endif
+}
+/*****************************************************************************/
+/*  End         : Flash_unlock                                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Flash_lock                                                 */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Ends programming or erasing                                */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Flash_lock(void) {
+
+	/* procedure code */
+#if defined(STM32F4XX)
+	FLASH->CR &= ~(FLASH_CR_PG | FLASH_CR_SER | FLASH_CR_SNB);
+	FLASH_Lock();
+#endif
+}
+/*****************************************************************************/
+/*  End         : Flash_lock                                                 */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Flash_busy                                                 */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Tells whether the flash is still programming or erasing    */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : Return     1 while busy                                    */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint8_t Flash_busy(void) {
+
+	/* procedure code */
+#if defined(STM32F4XX)
+	return (FLASH->SR & FLASH_FLAG_BSY) != 0;
+#else
+	return 0;
+#endif
+}
+/*****************************************************************************/
+/*  End         : Flash_busy                                                 */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Flash_error                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Tells whether the last programming failed                  */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : Return     1 on a programming or protection error          */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint8_t Flash_error(void) {
+
+	/* procedure code */
+#if defined(STM32F4XX)
+	return (FLASH->SR & (FLASH_FLAG_WRPERR | FLASH_FLAG_PGAERR |
+			FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR)) != 0;
+#else
+	return 0;
+#endif
+}
+/*****************************************************************************/
+/*  End         : Flash_error                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Flash_program                                              */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Starts programming one word, does not wait for the end     */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pAddress   Word in the store                               */
+/*                Data       Value                                           */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Flash_program(uint32_t *pAddress, uint32_t Data) {
+
+	/* procedure code */
+#if defined(STM32F4XX)
+	FLASH->CR = (FLASH->CR & ~FLASH_CR_PSIZE) | FLASH_PSIZE_WORD | FLASH_CR_PG;
+	*(__IO uint32_t *) pAddress = Data;
+#else
+	/* Programming can only clear bits */
+	*pAddress &= Data;
+	Flash_write(pAddress, sizeof(uint32_t));
+#endif
+}
+/*****************************************************************************/
+/*  End         : Flash_program                                              */
+/*****************************************************************************/
+
+#if !defined(STM32F4XX)
+/*****************************************************************************/
+/*  Procedure   : Flash_write                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Writes a part of the host flash through to its file, at    */
+/*                the same offset                                            */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pAddress   Start in Image                                  */
+/*                Bytes      Length                                          */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Flash_write(const void *pAddress, uint32_t Bytes) {
+
+	/* procedure code */
+	if (pImageFile == 0) {
+		return;
+	}
+	fseek(pImageFile, (long) ((const uint8_t *) pAddress - (uint8_t *) Image),
+			SEEK_SET);
+	fwrite(pAddress, 1, Bytes, pImageFile);
+	fflush(pImageFile);
+}
+/*****************************************************************************/
+/*  End         : Flash_write                                                */
+/*****************************************************************************/
+#endif
+
+/*****************************************************************************/
+/*  Procedure   : Record_next                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Makes room for the next record: continues in the other     */
+/*                sector once the one written is full, and starts erasing    */
+/*                the other one (older records only) as long as it is not    */
+/*                blank                                                      */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Record_next(void) {
+
+	/* procedure data */
+	const uint8_t *pOther;
+
+	/* procedure code */
+	if ((COEFF_STORE_SECTOR_SIZE - Free[WriteSector] < MaxLength) &&
+			Blank[1u - WriteSector]) {
+		WriteSector = (uint8_t) (1u - WriteSector);
+	}
+
+	/* Never the sector of the newest record */
+	pOther = pSector[1u - WriteSector];
+	if ((COEFF_STORE_SECTOR_SIZE - Free[WriteSector] < MaxLength) &&
+			!Blank[1u - WriteSector] && ((pLatest == 0) ||
+			((const uint8_t *) pLatest < pOther) ||
+			((const uint8_t *) pLatest >= pOther + COEFF_STORE_SECTOR_SIZE))) {
+		Flash_erase((uint8_t) (1u - WriteSector));
+		Free[1u - WriteSector] = 0;
+		Erasing = 1;
+	}
+}
+/*****************************************************************************/
+/*  End         : Record_next                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Crc_word                                                   */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : CRC-32 (0xEDB88320, bitwise) of one more word              */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : Crc        CRC so far                                      */
+/*                Word       Next word                                       */
+/*                                                                           */
+/*  Output Para : Return     New CRC                                         */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint32_t Crc_word(uint32_t Crc, uint32_t Word) {
+
+	/* procedure data */
+	uint32_t Bit;
+
+	/* procedure code */
+	Crc ^= Word;
+	for (Bit = 0; Bit < 32u; Bit++) {
+		Crc = (Crc >> 1) ^ (0xEDB88320u & (0u - (Crc & 1u)));
+	}
+	return Crc;
+}
+/*****************************************************************************/
+/*  End         : Crc_word                                                   */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Record_valid                                               */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Checks Magic and CRC of a record in the store              */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pHeader    Record, Size already checked against the sector */
+/*                                                                           */
+/*  Output Para : Return     1 if the record is complete and intact          */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint8_t Record_valid(const CoeffStoreHeader *pHeader) {
+
+	/* procedure data */
+	const uint32_t *pWord = (const uint32_t *) pHeader;
+	uint32_t Check = COEFF_STORE_ERASED;
+	uint32_t i;
+
+	/* procedure code */
+	if (pHeader->Magic != COEFF_STORE_MAGIC) {
+		return 0;
+	}
+	for (i = 0; i < COEFF_STORE_HEAD_WORDS; i++) {
+		Check = Crc_word(Check, pWord[i]);
+	}
+	pWord += COEFF_STORE_HEADER_WORDS;
+	for (i = 0; i < (pHeader->Size + 3u) / 4u; i++) {
+		Check = Crc_word(Check, pWord[i]);
+	}
+	return Check == pHeader->Crc;
+}
+/*****************************************************************************/
+/*  End         : Record_valid                                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : CoeffStore                                                 */
+/*****************************************************************************/
@@ -0,0 +1,72 @@
+#ifndef COEFFSTORE_H
+#define COEFFSTORE_H
+/*****************************************************************************/
+/*  Header     : CoeffStore                                     Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Persistent snapshots of converged filter coefficients in    */
+/*               two reserved flash sectors, for a warm start after reset    */
+/*                                                                           */
+/*  Procedures : CoeffStore_init()                                           */
+/*               CoeffStore_latest()                                         */
+/*               CoeffStore_save()                                           */
+/*               CoeffStore_idle()                                           */
+/*               CoeffStore_busy()                                           */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : CoeffStore.h                                                */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "arm_math.h"
+
+/* module constant declaration  */
+
+/* Reserved flash: sectors 10 and 11 (0x080C0000, 2 x 128kB), cut off the */
+/* FLASH region in stm32f4_flash.ld                                       */
+#define COEFF_STORE_SECTORS 2
+#define COEFF_STORE_SECTOR_SIZE 0x20000
+
+/* File holding the flash contents of host builds */
+#define COEFF_STORE_FILE "CoeffStore.bin"
+
+/* Record header in words, the data follows */
+#define COEFF_STORE_HEADER_WORDS 7
+
+/* module type declaration      */
+
+/* Record header. Written in this order: Size first (so an interrupted   */
+/* record can still be skipped), then the data, Crc, and Magic last, so  */
+/* a record is only valid when it is complete                            */
+typedef struct
+{
+	uint32_t Size;             /* Bytes of data                          */
+	uint32_t Sequence;         /* Increments with every record           */
+	uint16_t Format;           /* Number format (ECHO_FORMAT_xxx)        */
+	uint16_t numTaps;
+	uint32_t Delay;            /* Echo path delay [samples]              */
+	float32_t Erle;            /* Long term ERLE at the snapshot [dB]    */
+	uint32_t Crc;              /* CRC-32 of the words above and the data */
+	uint32_t Magic;
+} CoeffStoreHeader;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+void CoeffStore_init(uint32_t MaxSize);
+const CoeffStoreHeader *CoeffStore_latest(void);
+uint8_t CoeffStore_save(const CoeffStoreHeader *pInfo, const void *pData);
+void CoeffStore_idle(void);
+uint8_t CoeffStore_busy(void);
+
+/*****************************************************************************/
+/*  End Header  : CoeffStore                                                 */
+/*****************************************************************************/
+#endif
@@ -8,6 +8,8 @@
 /*               starts ADC0, ADC1, DAC1 and DAC2 and their DMA channels for */
 /*               blockwise signalprocessing.                                 */
 /*               DMA uses double buffering for more effiziency               */
+/*               (or one circular buffer processed per half, see             */
+/*               DMA_HALF_BUFFER)                                            */
 /*                                                                           */
 /*               This code is based on the example code                      */
 /*               'DAC_SignalsGeneration' and 'ADC_Interleaved_DMAmode2'      */
@@ -53,13 +55,107 @@
 
 #define ADC_CDR_ADDRESS    ((uint32_t)0x40012308)
 
+#if DMA_HALF_BUFFER
+/* Samples per DMA transfer (both halves) */
+#define DMA_LENGTH (2 * BLOCK_SIZE)
+
+/* Half of the circular buffer the DMA is working on (0 or 1) */
+#define DMA_TARGET(Stream) (DMA_GetCurrDataCounter(Stream) > BLOCK_SIZE ? 0 : 1)
+
+/* Samples of the circular buffer the DMA has transferred */
+#define DMA_POSITION(Stream) (DMA_LENGTH - DMA_GetCurrDataCounter(Stream))
+
+/* Stream at most one sample apart from ADC1 (modulo the buffer) */
+#define DMA_NEAR(Stream) ((DMA_POSITION(Stream) - DMA_POSITION(DMA2_Stream0) \
+		+ DMA_LENGTH + 1) % DMA_LENGTH <= 2)
+#else
+/* Samples per DMA transfer */
+#define DMA_LENGTH BLOCK_SIZE
+
+/* Buffer the DMA is working on (0 or 1) */
+#define DMA_TARGET(Stream) DMA_GetCurrentMemoryTarget(Stream)
+#endif
+
+#if IO_Q15
+/* Sign bits of two left aligned ADC/DAC values, flipping them converts */
+/* between unsigned and Q15                                             */
+#define IO_SIGN 0x80008000
+
+/* Buffers as passed to ProcessBlock() */
+#define IO_SAMPLES(pBuffer) ((q15_t *) (pBuffer))
+#else
+#define IO_SAMPLES(pBuffer) (pBuffer)
+#endif
+
+/* Lowest priority of the core, for PendSV */
+#define PRIORITY_LOWEST ((1 << __NVIC_PRIO_BITS) - 1)
+
 
 /* module type declaration */
 
+/* Set of buffers of one block */
+typedef struct
+{
+	uint16_t *pIn1;
+	uint16_t *pOut1;
+#if NUMBER_OF_CHANNELS == 2
+	uint16_t *pIn2;
+	uint16_t *pOut2;
+#endif
+	int Target;                /* DMA target when the block was ready */
+} BlockBuffers;
+
 /* module data declaration */
 
+#if PROCESS_DEFERRED
+/* Block handed from ProcessBuffer() to ProcessDeferred() */
+static BlockBuffers NextBlock;
+static volatile uint8_t BlockPending = 0;
+static volatile uint8_t BlockRunning = 0;
+
+/* Blocks which missed their deadline: not processed (or not done) */
+/* before the DMA moved on to their buffers                        */
+volatile uint32_t DeadlineMisses = 0;
+
+/* Cycles from pending PendSV to the start of ProcessDeferred() (end of */
+/* the DMA handler, exception entry and stacking), last and longest     */
+static volatile uint32_t PendTime;
+volatile uint32_t ProcessEntryCycles = 0;
+volatile uint32_t ProcessEntryCyclesMax = 0;
+#endif
 
+/* CPU cycles of ProcessBlock() (DWT cycle counter), see SignalProcessing.h */
+volatile uint32_t ProcessCycles = 0;
+volatile uint32_t ProcessCyclesMax = 0;
 
+#if defined(__arm__)
+/* Symbol of the linker script, which has to match RAM_FUNCTIONS: */
+/* stm32f4_flash.ld (1) or stm32f4_flash_rom.ld (0), else no link */
+#if RAM_FUNCTIONS
+extern uint8_t _ram_functions[];
+#define LINKER_SCRIPT_SYMBOL _ram_functions
+#else
+extern uint8_t _rom_functions[];
+#define LINKER_SCRIPT_SYMBOL _rom_functions
+#endif
+volatile uint32_t LinkerScript;
+#endif
+
+
+
+#if DMA_HALF_BUFFER
+/* Buffers for circular DMA, the DMA      */
+/* fills one half while the signal        */
+/* processing works on the other one,     */
+/* swapped at half and full transfer      */
+uint16_t Buffer1_a[2 * BLOCK_SIZE] = {0};
+uint16_t TxBuffer1_a[2 * BLOCK_SIZE] = {0};
+
+#if NUMBER_OF_CHANNELS == 2
+uint16_t Buffer2_a[2 * BLOCK_SIZE] = {0};
+uint16_t TxBuffer2_a[2 * BLOCK_SIZE] = {0};
+#endif
+#else
 /* Buffers for DMA double buffering       */
 /* ...a and ...b belongs together,        */
 /* one will be used by DMA, the other     */
@@ -76,6 +172,7 @@ uint16_t Buffer2_b[BLOCK_SIZE] = {0};
 uint16_t TxBuffer2_a[BLOCK_SIZE] = {0};
 uint16_t TxBuffer2_b[BLOCK_SIZE] = {0};
 #endif
+#endif
 
 
 
@@ -88,6 +185,10 @@ void ADC_Ch2_Config(void);
 void DAC_Common_Config(void);
 void DAC_Ch1_Config(void);
 void DAC_Ch2_Config(void);
+RAMFUNC static void ProcessBuffers(const BlockBuffers *pBlock);
+#if IO_Q15
+RAMFUNC static void FlipSign(uint16_t *pBuffer);
+#endif
 
 
 /*****************************************************************************/
@@ -228,6 +329,25 @@ int main(int argc, char *argv[])
 
     /* procedure code */
 
+#if FPU_LAZY_STACKING
+	/* Save the FP context of the interrupted code only on first use. */
+	/* This is the reset value of FPCCR, only restated here so that a  */
+	/* startup code changing it does not change the measurement        */
+	FPU->FPCCR |= FPU_FPCCR_ASPEN_Msk | FPU_FPCCR_LSPEN_Msk;
+#else
+	/* Save the FP context on every exception entry */
+	FPU->FPCCR = (FPU->FPCCR | FPU_FPCCR_ASPEN_Msk) & ~FPU_FPCCR_LSPEN_Msk;
+#endif
+
+#if defined(__arm__)
+	LinkerScript = (uint32_t) LINKER_SCRIPT_SYMBOL;
+#endif
+
+	/* Start the cycle counter (ProcessCycles) */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
 	/* Call the init function from the user */
 	InitProcessing();
 
@@ -427,6 +547,11 @@ void Interrupt_Config(void)
    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
    NVIC_Init(&NVIC_InitStructure);
 #endif
+
+#if PROCESS_DEFERRED
+   /* Signal processing in PendSV, preempted by all interrupts above */
+   NVIC_SetPriority(PendSV_IRQn, PRIORITY_LOWEST);
+#endif
 }
 /*****************************************************************************/
 /*  End         : Interrupt_Config                                           */
@@ -528,7 +653,7 @@ void ADC_Ch1_Config(void)
     DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralToMemory;
 
     /* Define number of values to read int one block */
-    DMA_InitStructure.DMA_BufferSize = BLOCK_SIZE;
+    DMA_InitStructure.DMA_BufferSize = DMA_LENGTH;
 
     /* Define increment mode for Pheripherie and memory adress */
     DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
@@ -551,11 +676,13 @@ void ADC_Ch1_Config(void)
     /* Initialize DMA with given values */
     DMA_Init(DMA2_Stream0, &DMA_InitStructure);
 
+#if !DMA_HALF_BUFFER
     /* Define second buffer for doublebuffering */
     DMA_DoubleBufferModeConfig(DMA2_Stream0,  (uint32_t)&Buffer1_b, DMA_Memory_0);
 
     /* Enable doublebuffering */
     DMA_DoubleBufferModeCmd 	(DMA2_Stream0, ENABLE);
+#endif
 
     /* Enable DMA-Interrupts */
     DMA_ITConfig 	(DMA2_Stream0, DMA_IT_TC, ENABLE);
@@ -650,7 +777,7 @@ void ADC_Ch2_Config(void)
     DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralToMemory;
 
     /* Define number of values to read int one block */
-    DMA_InitStructure.DMA_BufferSize = BLOCK_SIZE;
+    DMA_InitStructure.DMA_BufferSize = DMA_LENGTH;
 
     /* Define increment mode for Pheripherie and memory adress */
     DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
@@ -673,11 +800,13 @@ void ADC_Ch2_Config(void)
     /* Initialize DMA with given values */
     DMA_Init(DMA2_Stream2, &DMA_InitStructure);
 
+#if !DMA_HALF_BUFFER
     /* Define second buffer for doublebuffering */
     DMA_DoubleBufferModeConfig(DMA2_Stream2,  (uint32_t)&Buffer2_b, DMA_Memory_0);
 
     /* Enable doublebuffering */
     DMA_DoubleBufferModeCmd 	(DMA2_Stream2, ENABLE);
+#endif
 
     /* Enable DMA-Interrupts */
     DMA_ITConfig 	(DMA2_Stream2, DMA_IT_TC, ENABLE);
@@ -772,7 +901,7 @@ void DAC_Ch2_Config(void)
    DMA_InitStructure.DMA_DIR = DMA_DIR_MemoryToPeripheral;
 
    /* Define number of values to read int one block */
-   DMA_InitStructure.DMA_BufferSize = BLOCK_SIZE;
+   DMA_InitStructure.DMA_BufferSize = DMA_LENGTH;
 
    /* Define increment mode for Pheripherie and memory adress */
    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
@@ -795,11 +924,13 @@ void DAC_Ch2_Config(void)
    /* Initialize DMA with given values */
    DMA_Init(DMA1_Stream6, &DMA_InitStructure);
 
+#if !DMA_HALF_BUFFER
    /* Define second buffer for doublebuffering */
   DMA_DoubleBufferModeConfig(DMA1_Stream6,  (uint32_t)&TxBuffer2_b, DMA_Memory_0);
 
   /* Enable doublebuffering */
   DMA_DoubleBufferModeCmd 	(DMA1_Stream6, ENABLE);
+#endif
 
   /* Enable DMA-Interrupts */
   DMA_ITConfig 	(DMA1_Stream6, DMA_IT_TC, ENABLE);
@@ -924,7 +1055,7 @@ void DAC_Ch1_Config(void)
   DMA_InitStructure.DMA_DIR = DMA_DIR_MemoryToPeripheral;
 
   /* Define number of values to read int one block */
-  DMA_InitStructure.DMA_BufferSize = BLOCK_SIZE;
+  DMA_InitStructure.DMA_BufferSize = DMA_LENGTH;
 
   /* Define increment mode for Pheripherie and memory adress */
   DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
@@ -947,11 +1078,13 @@ void DAC_Ch1_Config(void)
   /* Initialize DMA with given values */
   DMA_Init(DMA1_Stream5, &DMA_InitStructure);
 
+#if !DMA_HALF_BUFFER
   /* Define second buffer for doublebuffering */
   DMA_DoubleBufferModeConfig(DMA1_Stream5,  (uint32_t)&TxBuffer1_b, DMA_Memory_0);
 
   /* Enable doublebuffering */
   DMA_DoubleBufferModeCmd 	(DMA1_Stream5, ENABLE);
+#endif
 
   /* Enable DMA-Interrupts */
   DMA_ITConfig 	(DMA1_Stream5, DMA_IT_TC, ENABLE);
@@ -992,7 +1125,9 @@ void DAC_Ch1_Config(void)
 /*                is ready for processing                                    */
 /*                Checks if doublebuffering for all channels is still        */
 /*                synchron, stops system if synchronisation is lost          */
-/*                                                                           */
+/*                (half buffer mode: the DACs within one sample of the ADC)  */
+/*                With PROCESS_DEFERRED the buffers are only selected and    */
+/*                PendSV is pended to process them (ProcessDeferred())       */
 /*                                                                           */
 /*  Type        : Global                                                     */
 /*                                                                           */
@@ -1006,28 +1141,36 @@ void DAC_Ch1_Config(void)
 /*  History     : 10.09.2013  IO Created                                     */
 /*                                                                           */
 /*****************************************************************************/
-void ProcessBuffer(void)
+RAMFUNC void ProcessBuffer(void)
 {
     /* procedure data */
     int Buffer1;
     int Buffer2;
     int Buffer3;
     int Buffer4;
+    BlockBuffers Block;
 
     /* procedure code */
 
-    /* Clear Idle-Led (for time measurements) */
-	GPIO_ResetBits(GPIOD, GPIO_Pin_14);
-
 	/* Get active buffer of all channels */
-	Buffer1 = DMA_GetCurrentMemoryTarget(DMA2_Stream0) ;
-	Buffer3 = DMA_GetCurrentMemoryTarget(DMA1_Stream5) ;
+	Buffer1 = DMA_TARGET(DMA2_Stream0) ;
+	Buffer3 = DMA_TARGET(DMA1_Stream5) ;
 #if NUMBER_OF_CHANNELS == 2
-	Buffer2 = DMA_GetCurrentMemoryTarget(DMA2_Stream2) ;
-	Buffer4 = DMA_GetCurrentMemoryTarget(DMA1_Stream6) ;
+	Buffer2 = DMA_TARGET(DMA2_Stream2) ;
+	Buffer4 = DMA_TARGET(DMA1_Stream6) ;
 
 	/* check if all channels use the same active buffer */
-#if BLOCK_SIZE == 1
+#if DMA_HALF_BUFFER
+	/* The DACs run up to one sample apart from the ADCs, compare the */
+	/* positions (with BLOCK_SIZE 1 any position is that close)       */
+	if ((Buffer1 != Buffer2)||!DMA_NEAR(DMA1_Stream5)||
+			!DMA_NEAR(DMA1_Stream6)) {
+        /* We got Trouble, buffers are asynchron */
+        /* All leds on... */
+		      FatalError();
+
+	}
+#elif BLOCK_SIZE == 1
     if ((Buffer1 != Buffer2)||(Buffer1 == Buffer3)||(Buffer1 == Buffer4)) {
         /* We got Trouble, buffers are asynchron */
         /* All leds on... */
@@ -1043,6 +1186,7 @@ void ProcessBuffer(void)
 	}
 #endif
 #endif
+	Block.Target = Buffer1;
 
 	/* Determine which set of buffers to use */
 	if (Buffer1 == 1) {
@@ -1050,32 +1194,223 @@ void ProcessBuffer(void)
 	    GPIO_SetBits(GPIOD, GPIO_Pin_12);
 		GPIO_ResetBits(GPIOD, GPIO_Pin_13);
 
-		/* Call ProcessBlock() with the new buffers */
+		Block.pIn1 = &Buffer1_a[0];
+		Block.pOut1 = &TxBuffer1_a[0];
 #if NUMBER_OF_CHANNELS == 2
-	    ProcessBlock(Buffer1_a, Buffer2_a, TxBuffer1_a, TxBuffer2_a);
-#else
-	    ProcessBlock(Buffer1_a, TxBuffer1_a);
+		Block.pIn2 = &Buffer2_a[0];
+		Block.pOut2 = &TxBuffer2_a[0];
 #endif
 	} else {
         /* Signal active buffers */
 		GPIO_SetBits(GPIOD, GPIO_Pin_13);
 		GPIO_ResetBits(GPIOD, GPIO_Pin_12);
 
-	    /* Call ProcessBlock() with the new buffers */
+#if DMA_HALF_BUFFER
+		/* Second half */
+		Block.pIn1 = &Buffer1_a[BLOCK_SIZE];
+		Block.pOut1 = &TxBuffer1_a[BLOCK_SIZE];
 #if NUMBER_OF_CHANNELS == 2
-	    ProcessBlock(Buffer1_b, Buffer2_b, TxBuffer1_b, TxBuffer2_b);
+		Block.pIn2 = &Buffer2_a[BLOCK_SIZE];
+		Block.pOut2 = &TxBuffer2_a[BLOCK_SIZE];
+#endif
 #else
-	    ProcessBlock(Buffer1_b, TxBuffer1_b);
+		Block.pIn1 = Buffer1_b;
+		Block.pOut1 = TxBuffer1_b;
+#if NUMBER_OF_CHANNELS == 2
+		Block.pIn2 = Buffer2_b;
+		Block.pOut2 = TxBuffer2_b;
+#endif
 #endif
+	}
 
+#if PROCESS_DEFERRED
+	/* The previous block is still waiting or running: too late, */
+	/* its buffers are now used by the DMA                       */
+	if (BlockPending || BlockRunning) {
+		DeadlineMisses++;
 	}
+
+	/* Hand the block over and let PendSV process it as soon as no */
+	/* other interrupt is active                                   */
+	NextBlock = Block;
+	BlockPending = 1;
+	PendTime = DWT->CYCCNT;
+	SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+#else
+	ProcessBuffers(&Block);
+#endif
+}
+/*****************************************************************************/
+/*  End         : ProcessBuffer                                              */
+/*****************************************************************************/
+
+#if PROCESS_DEFERRED
+/*****************************************************************************/
+/*  Procedure   : ProcessDeferred                                            */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Is called from PendSV (lowest priority) after              */
+/*                ProcessBuffer() has selected a block. Checks the deadline  */
+/*                on entry: if the DMA has already moved on, the buffers     */
+/*                belong to the DMA again and the block is skipped (the DAC  */
+/*                repeats the old output). The DMA interrupts preempt the    */
+/*                processing, so their latency does not depend on the block  */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC void ProcessDeferred(void)
+{
+    /* procedure data */
+    BlockBuffers Block;
+    uint32_t Cycles = DWT->CYCCNT - PendTime;
+
+    /* procedure code */
+
+	/* Entry cost, changes with FPU_LAZY_STACKING */
+	ProcessEntryCycles = Cycles;
+	if (Cycles > ProcessEntryCyclesMax) {
+		ProcessEntryCyclesMax = Cycles;
+	}
+
+	/* Take the block, a DMA interrupt may replace it meanwhile */
+	__disable_irq();
+	if (!BlockPending) {
+		__enable_irq();
+		return;
+	}
+	Block = NextBlock;
+	BlockPending = 0;
+	BlockRunning = 1;
+	__enable_irq();
+
+	/* Deadline check: the DMA must still work on the other buffer */
+	if (DMA_TARGET(DMA2_Stream0) != Block.Target) {
+		DeadlineMisses++;
+	} else {
+		ProcessBuffers(&Block);
+	}
+
+	BlockRunning = 0;
+}
+/*****************************************************************************/
+/*  End         : ProcessDeferred                                            */
+/*****************************************************************************/
+#endif
+
+/*****************************************************************************/
+/*  Procedure   : ProcessBuffers                                             */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Converts the samples of a block and calls ProcessBlock()   */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pBlock     Buffers of the block                            */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC static void ProcessBuffers(const BlockBuffers *pBlock)
+{
+    /* procedure data */
+    uint32_t Start;
+    uint32_t Cycles;
+
+    /* procedure code */
+
+    /* Clear Idle-Led (for time measurements) */
+	GPIO_ResetBits(GPIOD, GPIO_Pin_14);
+	Start = DWT->CYCCNT;
+
+#if IO_Q15
+	/* ADC values to Q15, in place */
+	FlipSign(pBlock->pIn1);
+#if NUMBER_OF_CHANNELS == 2
+	FlipSign(pBlock->pIn2);
+#endif
+#endif
+
+	/* Call ProcessBlock() with the new buffers */
+#if NUMBER_OF_CHANNELS == 2
+	ProcessBlock(IO_SAMPLES(pBlock->pIn1), IO_SAMPLES(pBlock->pIn2),
+			IO_SAMPLES(pBlock->pOut1), IO_SAMPLES(pBlock->pOut2));
+#else
+	ProcessBlock(IO_SAMPLES(pBlock->pIn1), IO_SAMPLES(pBlock->pOut1));
+#endif
+
+#if IO_Q15
+	/* Q15 to DAC values, in place */
+	FlipSign(pBlock->pOut1);
+#if NUMBER_OF_CHANNELS == 2
+	FlipSign(pBlock->pOut2);
+#endif
+#endif
+
+	/* Cycles of this block (preemption by interrupts included) */
+	Cycles = DWT->CYCCNT - Start;
+	ProcessCycles = Cycles;
+	if (Cycles > ProcessCyclesMax) {
+		ProcessCyclesMax = Cycles;
+	}
+
 	/* Set Idle-Led (for time measurements) */
    GPIO_SetBits(GPIOD, GPIO_Pin_14);
 
 }
 /*****************************************************************************/
-/*  End         : ProcessBuffer                                              */
+/*  End         : ProcessBuffers                                             */
+/*****************************************************************************/
+
+#if IO_Q15
+/*****************************************************************************/
+/*  Procedure   : FlipSign                                                   */
 /*****************************************************************************/
+/*                                                                           */
+/*  Function    : Converts a buffer between left aligned unsigned ADC/DAC    */
+/*                values and Q15 by flipping the sign bits, two samples per  */
+/*                word                                                       */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pBuffer    Samples [BLOCK_SIZE]                            */
+/*                                                                           */
+/*  Output Para : pBuffer    Converted samples                               */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC static void FlipSign(uint16_t *pBuffer)
+{
+    /* procedure data */
+    uint32_t i;
+
+    /* procedure code */
+    for (i = 0; i < BLOCK_SIZE / 2; i++) {
+        *__SIMD32(pBuffer)++ ^= IO_SIGN;
+    }
+#if BLOCK_SIZE & 1
+    *pBuffer ^= (uint16_t) IO_SIGN;
+#endif
+}
+/*****************************************************************************/
+/*  End         : FlipSign                                                   */
+/*****************************************************************************/
+#endif
 
 /*****************************************************************************/
 /*  Procedure   : Delay                                                      */
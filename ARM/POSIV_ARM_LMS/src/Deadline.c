@@ -0,0 +1,146 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : Deadline                                       Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Real-time deadline monitor with a degradation ladder.       */
+/*                                                                           */
+/*               Every block is checked against the budget of one block      */
+/*               period (cycles of the core at FS). A block above            */
+/*               DEADLINE_LIMIT of the budget is late or close to it, a      */
+/*               block above the budget is counted as overrun. After         */
+/*               DEADLINE_DOWN_BLOCKS late blocks in a row the level is      */
+/*               stepped down (cheaper), a single spike does not step.       */
+/*                                                                           */
+/*               The cost of the level above is estimated from the cycles    */
+/*               of the current block and the relative costs of the levels.  */
+/*               When it fits below the limit for DEADLINE_UP_BLOCKS in a    */
+/*               row, the level is stepped up again. The estimate scales     */
+/*               the fixed part of the processing too, so it errs on the     */
+/*               safe side.                                                  */
+/*                                                                           */
+/*  Procedures : Deadline_init()                                             */
+/*               Deadline_update()                                           */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : Deadline.c                                                  */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "Deadline.h"
+
+/* module constant declaration */
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+
+/*****************************************************************************/
+/*  Procedure   : Deadline_init                                              */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Initializes a monitor at full quality (level 0)            */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Monitor to initialize                           */
+/*                Budget     Cycles of one block period                      */
+/*                pCost      Relative cost of each level [Levels],           */
+/*                           decreasing                                      */
+/*                Levels     Number of levels (1 ... DEADLINE_LEVELS)        */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void Deadline_init(DeadlineMonitor *S, uint32_t Budget, const uint32_t *pCost,
+		uint16_t Levels) {
+
+	/* procedure code */
+	if (Levels > DEADLINE_LEVELS) {
+		Levels = DEADLINE_LEVELS;
+	}
+	memset(S, 0, sizeof(*S));
+	memcpy(S->Cost, pCost, Levels * sizeof(uint32_t));
+	S->Budget = Budget;
+	S->Levels = Levels;
+}
+/*****************************************************************************/
+/*  End         : Deadline_init                                              */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Deadline_update                                            */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Checks the last block and returns the level of the next    */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Monitor                                         */
+/*                Cycles     Cycles of the last block                        */
+/*                                                                           */
+/*  Output Para : Level of the next block                                    */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC uint16_t Deadline_update(DeadlineMonitor *S, uint32_t Cycles) {
+
+	/* procedure data */
+	uint32_t Limit = S->Budget / 100u * DEADLINE_LIMIT;
+	uint16_t Level = S->Level;
+
+	/* procedure code */
+	if (Cycles > S->Budget) {
+		S->Overruns++;
+	}
+
+	if (Cycles > Limit) {
+		/* Late: step down when it lasts */
+		S->Up = 0;
+		if (++S->Down >= DEADLINE_DOWN_BLOCKS) {
+			S->Down = 0;
+			if (Level + 1u < S->Levels) {
+				S->Level = Level + 1u;
+				S->Steps++;
+			}
+		}
+	} else {
+		/* In time: step up when the level above fits for a while */
+		S->Down = 0;
+		if ((Level > 0) && ((uint64_t) Cycles * S->Cost[Level - 1u] <=
+				(uint64_t) Limit * S->Cost[Level])) {
+			if (++S->Up >= DEADLINE_UP_BLOCKS) {
+				S->Up = 0;
+				S->Level = Level - 1u;
+				S->Steps++;
+			}
+		} else {
+			S->Up = 0;
+		}
+	}
+	return S->Level;
+}
+/*****************************************************************************/
+/*  End         : Deadline_update                                            */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : Deadline                                                   */
+/*****************************************************************************/
@@ -0,0 +1,70 @@
+#ifndef DEADLINE_H
+#define DEADLINE_H
+/*****************************************************************************/
+/*  Header     : Deadline                                       Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Real-time deadline monitor: checks the cycles of every      */
+/*               block against the budget of one block period and steps a    */
+/*               degradation level down and up                               */
+/*                                                                           */
+/*  Procedures : Deadline_init()                                             */
+/*               Deadline_update()                                           */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : Deadline.h                                                  */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "config.h"
+#include "arm_math.h"
+
+/* module constant declaration  */
+
+/* Maximum number of levels */
+#define DEADLINE_LEVELS 4
+
+/* Usable part of the block period [%], the rest is left for the */
+/* interrupts and the idle loop                                  */
+#define DEADLINE_LIMIT 90
+
+/* Blocks in a row above the limit before stepping down one level */
+#define DEADLINE_DOWN_BLOCKS 4
+
+/* Blocks in a row with room for the level above before stepping up */
+/* (1s)                                                              */
+#define DEADLINE_UP_BLOCKS (FS / BLOCK_SIZE)
+
+/* module type declaration      */
+
+/* Monitor (watch it with the debugger) */
+typedef struct
+{
+	uint32_t Budget;                  /* Cycles of one block period       */
+	uint32_t Cost[DEADLINE_LEVELS];   /* Relative cost of each level      */
+	uint16_t Levels;                  /* Number of levels                 */
+	uint16_t Level;                   /* Current level, 0 = full quality  */
+	uint16_t Down;                    /* Blocks above the limit in a row  */
+	uint16_t Up;                      /* Blocks with headroom in a row    */
+	uint32_t Overruns;                /* Blocks longer than the budget    */
+	uint32_t Steps;                   /* Level changes                    */
+} DeadlineMonitor;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+void Deadline_init(DeadlineMonitor *S, uint32_t Budget, const uint32_t *pCost,
+		uint16_t Levels);
+RAMFUNC uint16_t Deadline_update(DeadlineMonitor *S, uint32_t Cycles);
+
+/*****************************************************************************/
+/*  End Header  : Deadline                                                   */
+/*****************************************************************************/
+#endif
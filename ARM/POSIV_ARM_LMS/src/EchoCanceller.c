@@ -0,0 +1,342 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : EchoCanceller                                  Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Instance based Q15 echo canceller.                          */
+/*                                                                           */
+/*               Bundles the adaptive filter (arm_lms_q15() or LMSSign) with */
+/*               the optional sparse execution, tail model, step size        */
+/*               control and metrics into one instance. Coefficients and     */
+/*               delay lines are placed in memory provided by the caller     */
+/*               (ECHO_CANCELLER_MEMORY(numTaps) q15_t), nothing is kept in  */
+/*               globals, so every procedure is reentrant for different      */
+/*               instances: several microphones on one board, or many        */
+/*               channels in one process.                                    */
+/*                                                                           */
+/*  Procedures : EchoCanceller_init_q15()                                    */
+/*               EchoCanceller_reset_q15()                                   */
+/*               EchoCanceller_q15()                                         */
+/*               EchoCanceller_skip_q15()                                    */
+/*               EchoCanceller_idle_q15()                                    */
+/*               EchoCanceller_report()                                      */
+/*               EchoCanceller_level_q15()                                   */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : EchoCanceller.c                                             */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "EchoCanceller.h"
+
+/* module constant declaration */
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+
+/*****************************************************************************/
+/*  Procedure   : EchoCanceller_init_q15                                     */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Initializes a canceller in the given memory and resets it  */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance to initialize                          */
+/*                numTaps    Number of coefficients                          */
+/*                Mu         Step size (Q15) without LMS_VSS                 */
+/*                pMemory    Memory for coefficients and delay lines         */
+/*                           [ECHO_CANCELLER_MEMORY(numTaps)]                */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void EchoCanceller_init_q15(EchoCancellerInstanceQ15 *S, uint16_t numTaps,
+		q15_t Mu, q15_t *pMemory) {
+
+	/* procedure code */
+	S->numTaps = numTaps;
+	S->Mu = Mu;
+
+	S->pCoeffs = pMemory;
+	pMemory += ECHO_CANCELLER_COEFFS(numTaps);
+	S->pState = pMemory;
+	pMemory += numTaps + BLOCK_SIZE - 1;
+	S->pUpdate = 0;
+	S->pSparseState = 0;
+#if LMS_UPDATE != LMS_UPDATE_FULL
+	S->pUpdate = pMemory;
+	pMemory += numTaps + BLOCK_SIZE - 1;
+#endif
+#if LMS_SPARSE
+	S->pSparseState = pMemory;
+#endif
+
+	EchoCanceller_reset_q15(S);
+}
+/*****************************************************************************/
+/*  End         : EchoCanceller_init_q15                                     */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : EchoCanceller_reset_q15                                    */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Clears coefficients, delay lines and all estimates, the    */
+/*                canceller starts adapting from scratch                     */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void EchoCanceller_reset_q15(EchoCancellerInstanceQ15 *S) {
+
+	/* procedure code */
+	memset(S->pCoeffs, 0, ECHO_CANCELLER_COEFFS(S->numTaps) * sizeof(q15_t));
+
+#if LMS_BFP
+	LMSBfp_init_q15(&S->Lms, S->numTaps, S->pCoeffs, S->pState, S->Mu,
+			BLOCK_SIZE, 0);
+#elif LMS_UPDATE == LMS_UPDATE_FULL
+	arm_lms_init_q15(&S->Lms, S->numTaps, S->pCoeffs, S->pState, S->Mu,
+			BLOCK_SIZE, 0);
+#else
+	LMSSign_init_q15(&S->Lms, S->numTaps, S->pCoeffs, S->pState, S->pUpdate,
+			LMS_UPDATE, LMS_MU_SHIFT, LMS_DELTA, BLOCK_SIZE, 0);
+#endif
+#if LMS_SPARSE
+	memset(S->pSparseState, 0, (S->numTaps - 1 + BLOCK_SIZE) * sizeof(q15_t));
+	LMSSparse_init_q15(&S->Sparse, &S->Lms, S->pSparseState);
+#endif
+#if LMS_HYBRID
+	LMSHybrid_init_q15(&S->Hybrid, &S->Lms);
+#endif
+#if LMS_VSS
+	LMSStep_init_q15(&S->Step, S->numTaps);
+#endif
+#if LMS_METRICS
+	LMSMetrics_init_q15(&S->Metrics);
+#endif
+#if LMS_DEGRADE
+	S->Level = LMS_DEGRADE_FULL;
+	S->Phase = 0;
+#endif
+}
+/*****************************************************************************/
+/*  End         : EchoCanceller_reset_q15                                    */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : EchoCanceller_q15                                          */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Cancels the echo of one block                              */
+/*                (blockSize must not exceed BLOCK_SIZE)                     */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Reference (far end) samples [blockSize]         */
+/*                pMic       Microphone samples [blockSize]                  */
+/*                blockSize  Number of samples                               */
+/*                                                                           */
+/*  Output Para : pErr       Microphone without echo [blockSize]             */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC void EchoCanceller_q15(EchoCancellerInstanceQ15 *S, q15_t *pSrc, q15_t *pMic,
+		q15_t *pErr, uint32_t blockSize) {
+
+	/* procedure data */
+	q15_t Out[BLOCK_SIZE];
+
+	/* procedure code */
+#if LMS_SPARSE
+	LMSSparse_q15(&S->Sparse, pSrc, pMic, Out, pErr, blockSize);
+#elif LMS_HYBRID
+	LMSHybrid_q15(&S->Hybrid, pSrc, pMic, Out, pErr, blockSize);
+#elif LMS_BFP
+	LMSBfp_q15(&S->Lms, pSrc, pMic, Out, pErr, blockSize);
+#elif LMS_DEGRADE
+	LMSDegrade_q15(&S->Lms, pSrc, pMic, Out, pErr, blockSize, S->Level,
+			&S->Phase);
+#elif LMS_UPDATE == LMS_UPDATE_FULL
+	arm_lms_q15(&S->Lms, pSrc, pMic, Out, pErr, blockSize);
+#else
+	LMSSign_q15(&S->Lms, pSrc, pMic, Out, pErr, blockSize);
+#endif
+
+#if LMS_VSS && (LMS_UPDATE == LMS_UPDATE_FULL)
+	S->Lms.mu = LMSStep_q15(&S->Step, pSrc, pMic, pErr, blockSize);
+#elif LMS_VSS
+	LMSStep_q15(&S->Step, pSrc, pMic, pErr, blockSize);
+	S->Lms.MuShift = S->Step.MuShift;
+#endif
+#if LMS_METRICS
+	LMSMetrics_q15(&S->Metrics, pSrc, pMic, pErr, blockSize);
+#endif
+}
+/*****************************************************************************/
+/*  End         : EchoCanceller_q15                                          */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : EchoCanceller_skip_q15                                     */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Puts one block of the reference into the delay lines       */
+/*                without filtering or adaptation (far end silent). The next */
+/*                EchoCanceller_q15() filters with the newest samples. The   */
+/*                tail model of LMS_HYBRID is not advanced.                  */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Reference (far end) samples [blockSize]         */
+/*                blockSize  Number of samples (at most BLOCK_SIZE)          */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC void EchoCanceller_skip_q15(EchoCancellerInstanceQ15 *S, q15_t *pSrc,
+		uint32_t blockSize) {
+
+	/* procedure code */
+#if LMS_SPARSE
+	LMSSparse_skip_q15(&S->Sparse, pSrc, blockSize);
+#elif LMS_UPDATE != LMS_UPDATE_FULL
+	LMSSign_skip_q15(&S->Lms, pSrc, blockSize);
+#else
+	/* Same delay line layout as arm_lms_q15(): the newest numTaps - 1 */
+	/* samples at the start, the block appended and shifted down       */
+	memcpy(&S->pState[S->numTaps - 1u], pSrc, blockSize * sizeof(q15_t));
+	memmove(S->pState, &S->pState[blockSize], (S->numTaps - 1u) * sizeof(q15_t));
+#endif
+}
+/*****************************************************************************/
+/*  End         : EchoCanceller_skip_q15                                     */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : EchoCanceller_idle_q15                                     */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Background work of the canceller, is called from           */
+/*                IdleFunction() (outside of the interrupt)                  */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void EchoCanceller_idle_q15(EchoCancellerInstanceQ15 *S) {
+
+	/* procedure code */
+#if LMS_SPARSE
+	/* Extract the sparse taps */
+	LMSSparse_idle_q15(&S->Sparse);
+#else
+	(void) S;
+#endif
+}
+/*****************************************************************************/
+/*  End         : EchoCanceller_idle_q15                                     */
+/*****************************************************************************/
+
+#if LMS_METRICS
+/*****************************************************************************/
+/*  Procedure   : EchoCanceller_report                                       */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Fills the metrics report of the canceller (see             */
+/*                LMSMetrics_report())                                       */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                                                                           */
+/*  Output Para : pReport    Report to fill                                  */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void EchoCanceller_report(EchoCancellerInstanceQ15 *S, LMSMetricsReport *pReport) {
+
+	/* procedure code */
+	LMSMetrics_report(&S->Metrics, pReport);
+}
+/*****************************************************************************/
+/*  End         : EchoCanceller_report                                       */
+/*****************************************************************************/
+#endif
+
+#if LMS_DEGRADE
+/*****************************************************************************/
+/*  Procedure   : EchoCanceller_level_q15                                    */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Sets the degradation level of the following blocks,        */
+/*                call between two blocks                                    */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                Level      LMS_DEGRADE_xxx                                 */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void EchoCanceller_level_q15(EchoCancellerInstanceQ15 *S, uint32_t Level) {
+
+	/* procedure code */
+	S->Level = Level;
+}
+/*****************************************************************************/
+/*  End         : EchoCanceller_level_q15                                    */
+/*****************************************************************************/
+#endif
+
+/*****************************************************************************/
+/*  End Module  : EchoCanceller                                              */
+/*****************************************************************************/
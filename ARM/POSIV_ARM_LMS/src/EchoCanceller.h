@@ -0,0 +1,165 @@
+#ifndef ECHOCANCELLER_H
+#define ECHOCANCELLER_H
+/*****************************************************************************/
+/*  Header     : EchoCanceller                                  Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Instance based Q15 echo canceller. All state of one         */
+/*               canceller is in its instance and in memory provided by the  */
+/*               caller, so any number of cancellers can run side by side.   */
+/*               The algorithm variant is selected at compile time below.    */
+/*                                                                           */
+/*  Procedures : EchoCanceller_init_q15()                                    */
+/*               EchoCanceller_reset_q15()                                   */
+/*               EchoCanceller_q15()                                         */
+/*               EchoCanceller_skip_q15()                                    */
+/*               EchoCanceller_idle_q15()                                    */
+/*               EchoCanceller_report()                                      */
+/*               EchoCanceller_level_q15()                                   */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : EchoCanceller.h                                             */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "config.h"
+#include "arm_math.h"
+#include "LMSSign.h"
+#include "LMSSparse.h"
+#include "LMSHybrid.h"
+#include "LMSMetrics.h"
+#include "LMSStep.h"
+#include "LMSBfp.h"
+#include "LMSDegrade.h"
+
+/* module constant declaration  */
+
+/* Select the coefficient update of the Q15 LMS                      */
+/* LMS_UPDATE_FULL uses arm_lms_q15(), LMS_SIGN_ERROR/LMS_SIGN_SIGN   */
+/* the multiplierfree kernels from LMSSign.c                         */
+#define LMS_UPDATE_FULL 0
+#define LMS_UPDATE LMS_UPDATE_FULL
+
+/* Step sizes of the sign variants (2^-LMS_MU_SHIFT, LMS_DELTA in Q15) */
+#define LMS_MU_SHIFT 12
+#define LMS_DELTA 1
+
+/* Variable step size (1) instead of Mu / LMS_MU_SHIFT (0), see LMSStep.c */
+/* (LMS_UPDATE_FULL and LMS_SIGN_ERROR only)                             */
+#define LMS_VSS 0
+
+/* Switch to a sparse filter after convergence (1) or adapt forever (0) */
+/* (only with LMS_UPDATE_FULL, see LMSSparse.c)                        */
+#define LMS_SPARSE 0
+
+/* Model the reverberant tail with resonators behind a short FIR (1)  */
+/* or with the full length FIR only (0), see LMSHybrid.c              */
+#define LMS_HYBRID 0
+
+/* Store the late taps in block floating point (1), about one byte per */
+/* late tap instead of two, or all taps in Q15 (0), see LMSBfp.c       */
+/* (only with LMS_UPDATE_FULL)                                         */
+#define LMS_BFP 0
+
+/* Measure ERLE and convergence online (1), see LMSMetrics.c */
+#define LMS_METRICS 1
+
+/* Cheaper levels under overload (1), chosen by the deadline monitor, */
+/* or always the full LMS (0), see LMSDegrade.c                       */
+/* (only with LMS_UPDATE_FULL, the other kernels keep a single level) */
+#define LMS_DEGRADE_ENABLE 1
+
+#if LMS_SPARSE && (LMS_UPDATE != LMS_UPDATE_FULL)
+#error "LMS_SPARSE requires LMS_UPDATE_FULL"
+#endif
+#if LMS_HYBRID && ((LMS_UPDATE != LMS_UPDATE_FULL) || LMS_SPARSE)
+#error "LMS_HYBRID requires LMS_UPDATE_FULL and no LMS_SPARSE"
+#endif
+#if LMS_BFP && ((LMS_UPDATE != LMS_UPDATE_FULL) || LMS_SPARSE || LMS_HYBRID)
+#error "LMS_BFP requires LMS_UPDATE_FULL and no LMS_SPARSE or LMS_HYBRID"
+#endif
+#if LMS_DEGRADE_ENABLE && (LMS_UPDATE == LMS_UPDATE_FULL) && !LMS_SPARSE && \
+		!LMS_HYBRID && !LMS_BFP
+#define LMS_DEGRADE 1
+#else
+#define LMS_DEGRADE 0
+#endif
+#if LMS_VSS && (LMS_UPDATE == LMS_SIGN_SIGN)
+#error "LMS_VSS does not support LMS_SIGN_SIGN"
+#endif
+
+/* Memory (number of q15_t) of the coefficients of numTaps taps */
+#define ECHO_CANCELLER_COEFFS(numTaps) \
+	(LMS_BFP ? LMS_BFP_MEMORY(numTaps) : (numTaps))
+
+/* Memory (number of q15_t) a canceller with numTaps coefficients needs */
+#define ECHO_CANCELLER_MEMORY(numTaps) \
+	(ECHO_CANCELLER_COEFFS(numTaps) + (numTaps) + BLOCK_SIZE - 1 + \
+	((LMS_UPDATE != LMS_UPDATE_FULL) ? (numTaps) + BLOCK_SIZE - 1 : 0) + \
+	(LMS_SPARSE ? (numTaps) - 1 + BLOCK_SIZE : 0))
+
+/* module type declaration      */
+
+/* Instance, only to be accessed through the procedures below */
+typedef struct
+{
+	uint16_t numTaps;
+	q15_t Mu;
+	q15_t *pCoeffs;
+	q15_t *pState;
+	q15_t *pUpdate;
+	q15_t *pSparseState;
+#if LMS_BFP
+	LMSBfpInstanceQ15 Lms;
+#elif LMS_UPDATE == LMS_UPDATE_FULL
+	arm_lms_instance_q15 Lms;
+#else
+	LMSSignInstanceQ15 Lms;
+#endif
+#if LMS_SPARSE
+	LMSSparseInstanceQ15 Sparse;
+#endif
+#if LMS_HYBRID
+	LMSHybridInstanceQ15 Hybrid;
+#endif
+#if LMS_VSS
+	LMSStepInstanceQ15 Step;
+#endif
+#if LMS_METRICS
+	LMSMetricsQ15 Metrics;
+#endif
+#if LMS_DEGRADE
+	uint32_t Level;            /* LMS_DEGRADE_xxx of the next block       */
+	uint32_t Phase;            /* Next segment of LMS_DEGRADE_PARTIAL     */
+#endif
+} EchoCancellerInstanceQ15;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+void EchoCanceller_init_q15(EchoCancellerInstanceQ15 *S, uint16_t numTaps,
+		q15_t Mu, q15_t *pMemory);
+void EchoCanceller_reset_q15(EchoCancellerInstanceQ15 *S);
+RAMFUNC void EchoCanceller_q15(EchoCancellerInstanceQ15 *S, q15_t *pSrc, q15_t *pMic,
+		q15_t *pErr, uint32_t blockSize);
+RAMFUNC void EchoCanceller_skip_q15(EchoCancellerInstanceQ15 *S, q15_t *pSrc,
+		uint32_t blockSize);
+void EchoCanceller_idle_q15(EchoCancellerInstanceQ15 *S);
+#if LMS_METRICS
+void EchoCanceller_report(EchoCancellerInstanceQ15 *S, LMSMetricsReport *pReport);
+#endif
+#if LMS_DEGRADE
+void EchoCanceller_level_q15(EchoCancellerInstanceQ15 *S, uint32_t Level);
+#endif
+
+/*****************************************************************************/
+/*  End Header  : EchoCanceller                                              */
+/*****************************************************************************/
+#endif
@@ -0,0 +1,619 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : EchoCancellerFormat                            Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Echo canceller with the number format chosen at runtime.    */
+/*                                                                           */
+/*               float32 and Q31 use arm_lms_f32() and arm_lms_q31(), Q15    */
+/*               is the EchoCanceller with all its options (LMS_UPDATE,      */
+/*               LMS_SPARSE, ...). All three are always linked, so a         */
+/*               deployment selects the format with the fastest or best      */
+/*               result on its hardware without a rebuild.                   */
+/*                                                                           */
+/*               Samples and Mu are Q15 for every format. float32 works on   */
+/*               samples scaled to [-1, 1) with mu = Mu / 32768, Q31 on the  */
+/*               samples shifted left by 16 with mu = Mu << 16, so all       */
+/*               formats adapt with the same nominal step.                   */
+/*                                                                           */
+/*               All formats share one memory, sized for the largest, so     */
+/*               changing the format only needs a new init call.             */
+/*                                                                           */
+/*  Procedures : EchoCancellerFormat_init()                                  */
+/*               EchoCancellerFormat_reset()                                 */
+/*               EchoCancellerFormat_q15()                                   */
+/*               EchoCancellerFormat_skip_q15()                              */
+/*               EchoCancellerFormat_idle()                                  */
+/*               EchoCancellerFormat_report()                                */
+/*               EchoCancellerFormat_coeffs()                                */
+/*               EchoCancellerFormat_delay()                                 */
+/*               EchoCancellerFormat_costs()                                 */
+/*               EchoCancellerFormat_level()                                 */
+/*               EchoCancellerFormat_transfer()                              */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : EchoCancellerFormat.c                                       */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "EchoCancellerFormat.h"
+
+/* module constant declaration */
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+static void Format_copy(void *pTo, uint32_t numTo, const void *pFrom,
+		uint32_t numFrom, uint32_t Size);
+
+/*****************************************************************************/
+/*  Procedure   : EchoCancellerFormat_init                                   */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Initializes a canceller of the given format in the given   */
+/*                memory, with all coefficients cleared                      */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance to initialize                          */
+/*                Format     ECHO_FORMAT_F32, ECHO_FORMAT_Q31 or             */
+/*                           ECHO_FORMAT_Q15                                 */
+/*                numTaps    Number of filter coefficients                   */
+/*                Mu         Step size (Q15)                                 */
+/*                pMemory    Memory [ECHO_CANCELLER_FORMAT_MEMORY(numTaps)]  */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void EchoCancellerFormat_init(EchoCancellerFormatInstance *S, uint8_t Format,
+		uint16_t numTaps, q15_t Mu, uint32_t *pMemory) {
+
+	/* procedure code */
+	S->Format = Format;
+	S->numTaps = numTaps;
+	S->Mu = Mu;
+	S->pMemory = pMemory;
+
+	if (Format == ECHO_FORMAT_Q15) {
+		EchoCanceller_init_q15(&S->Lms.Q15, numTaps, Mu, (q15_t *) pMemory);
+	} else {
+		EchoCancellerFormat_reset(S);
+	}
+}
+/*****************************************************************************/
+/*  End         : EchoCancellerFormat_init                                   */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : EchoCancellerFormat_reset                                  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Restarts the adaption, coefficients and state cleared      */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void EchoCancellerFormat_reset(EchoCancellerFormatInstance *S) {
+
+	/* procedure data */
+	float32_t *pCoeffsF32 = (float32_t *) S->pMemory;
+	q31_t *pCoeffsQ31 = (q31_t *) S->pMemory;
+
+	/* procedure code */
+	if (S->Format == ECHO_FORMAT_F32) {
+		memset(pCoeffsF32, 0, S->numTaps * sizeof(float32_t));
+		arm_lms_init_f32(&S->Lms.F32, S->numTaps, pCoeffsF32,
+				pCoeffsF32 + S->numTaps, S->Mu * (1.0f / 32768.0f), BLOCK_SIZE);
+	} else if (S->Format == ECHO_FORMAT_Q31) {
+		memset(pCoeffsQ31, 0, S->numTaps * sizeof(q31_t));
+		arm_lms_init_q31(&S->Lms.Q31, S->numTaps, pCoeffsQ31,
+				pCoeffsQ31 + S->numTaps, (q31_t) S->Mu << 16, BLOCK_SIZE, 0);
+	} else {
+		EchoCanceller_reset_q15(&S->Lms.Q15);
+	}
+#if LMS_METRICS
+	LMSMetrics_init_q15(&S->Metrics);
+#endif
+}
+/*****************************************************************************/
+/*  End         : EchoCancellerFormat_reset                                  */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : EchoCancellerFormat_q15                                    */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Cancels the echo of one block, in the format of the        */
+/*                instance                                                   */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Far end (reference) samples [blockSize]         */
+/*                pMic       Microphone samples [blockSize]                  */
+/*                blockSize  Number of samples (at most BLOCK_SIZE)          */
+/*                                                                           */
+/*  Output Para : pErr       Microphone without echo [blockSize]             */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC void EchoCancellerFormat_q15(EchoCancellerFormatInstance *S, q15_t *pSrc,
+		q15_t *pMic, q15_t *pErr, uint32_t blockSize) {
+
+	/* procedure data */
+	float32_t SrcF32[BLOCK_SIZE];
+	float32_t MicF32[BLOCK_SIZE];
+	float32_t OutF32[BLOCK_SIZE];
+	float32_t ErrF32[BLOCK_SIZE];
+	q31_t SrcQ31[BLOCK_SIZE];
+	q31_t MicQ31[BLOCK_SIZE];
+	q31_t OutQ31[BLOCK_SIZE];
+	q31_t ErrQ31[BLOCK_SIZE];
+
+	/* procedure code */
+	if (S->Format == ECHO_FORMAT_F32) {
+		arm_q15_to_float(pSrc, SrcF32, blockSize);
+		arm_q15_to_float(pMic, MicF32, blockSize);
+		arm_lms_f32(&S->Lms.F32, SrcF32, MicF32, OutF32, ErrF32, blockSize);
+		arm_float_to_q15(ErrF32, pErr, blockSize);
+	} else if (S->Format == ECHO_FORMAT_Q31) {
+		arm_q15_to_q31(pSrc, SrcQ31, blockSize);
+		arm_q15_to_q31(pMic, MicQ31, blockSize);
+		arm_lms_q31(&S->Lms.Q31, SrcQ31, MicQ31, OutQ31, ErrQ31, blockSize);
+		arm_q31_to_q15(ErrQ31, pErr, blockSize);
+	} else {
+		EchoCanceller_q15(&S->Lms.Q15, pSrc, pMic, pErr, blockSize);
+		return;
+	}
+
+#if LMS_METRICS
+	LMSMetrics_q15(&S->Metrics, pSrc, pMic, pErr, blockSize);
+#endif
+}
+/*****************************************************************************/
+/*  End         : EchoCancellerFormat_q15                                    */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : EchoCancellerFormat_skip_q15                               */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Puts one block of the reference into the delay line in the */
+/*                format of the instance, without filtering or adaptation    */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Far end (reference) samples [blockSize]         */
+/*                blockSize  Number of samples (at most BLOCK_SIZE)          */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC void EchoCancellerFormat_skip_q15(EchoCancellerFormatInstance *S,
+		q15_t *pSrc, uint32_t blockSize) {
+
+	/* procedure data */
+	uint32_t History = S->numTaps - 1u;
+
+	/* procedure code */
+
+	/* Appended behind the newest numTaps - 1 samples and shifted down, */
+	/* as arm_lms_f32() and arm_lms_q31() do                            */
+	if (S->Format == ECHO_FORMAT_F32) {
+		arm_q15_to_float(pSrc, &S->Lms.F32.pState[History], blockSize);
+		memmove(S->Lms.F32.pState, &S->Lms.F32.pState[blockSize],
+				History * sizeof(float32_t));
+	} else if (S->Format == ECHO_FORMAT_Q31) {
+		arm_q15_to_q31(pSrc, &S->Lms.Q31.pState[History], blockSize);
+		memmove(S->Lms.Q31.pState, &S->Lms.Q31.pState[blockSize],
+				History * sizeof(q31_t));
+	} else {
+		EchoCanceller_skip_q15(&S->Lms.Q15, pSrc, blockSize);
+	}
+}
+/*****************************************************************************/
+/*  End         : EchoCancellerFormat_skip_q15                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : EchoCancellerFormat_idle                                   */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Background work of the canceller, call from the idle loop  */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void EchoCancellerFormat_idle(EchoCancellerFormatInstance *S) {
+
+	/* procedure code */
+	if (S->Format == ECHO_FORMAT_Q15) {
+		EchoCanceller_idle_q15(&S->Lms.Q15);
+	}
+}
+/*****************************************************************************/
+/*  End         : EchoCancellerFormat_idle                                   */
+/*****************************************************************************/
+
+#if LMS_METRICS
+/*****************************************************************************/
+/*  Procedure   : EchoCancellerFormat_report                                 */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Copies the current metrics of the canceller                */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                                                                           */
+/*  Output Para : pReport    Metrics                                         */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void EchoCancellerFormat_report(EchoCancellerFormatInstance *S,
+		LMSMetricsReport *pReport) {
+
+	/* procedure code */
+	if (S->Format == ECHO_FORMAT_Q15) {
+		EchoCanceller_report(&S->Lms.Q15, pReport);
+	} else {
+		LMSMetrics_report(&S->Metrics, pReport);
+	}
+}
+/*****************************************************************************/
+/*  End         : EchoCancellerFormat_report                                 */
+/*****************************************************************************/
+#endif
+
+/*****************************************************************************/
+/*  Procedure   : EchoCancellerFormat_coeffs                                 */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Gives the coefficient memory of the canceller, to save     */
+/*                and restore it (see CoeffStore)                            */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                                                                           */
+/*  Output Para : ppCoeffs   Coefficients                                    */
+/*                Return     Size of the coefficients in bytes               */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+uint32_t EchoCancellerFormat_coeffs(EchoCancellerFormatInstance *S,
+		void **ppCoeffs) {
+
+	/* procedure code */
+	if (S->Format == ECHO_FORMAT_F32) {
+		*ppCoeffs = S->Lms.F32.pCoeffs;
+		return S->numTaps * sizeof(float32_t);
+	} else if (S->Format == ECHO_FORMAT_Q31) {
+		*ppCoeffs = S->Lms.Q31.pCoeffs;
+		return S->numTaps * sizeof(q31_t);
+	}
+	*ppCoeffs = S->Lms.Q15.pCoeffs;
+	return ECHO_CANCELLER_COEFFS(S->numTaps) * sizeof(q15_t);
+}
+/*****************************************************************************/
+/*  End         : EchoCancellerFormat_coeffs                                 */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : EchoCancellerFormat_delay                                  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Estimates the echo path delay as the position of the       */
+/*                largest coefficient. With LMS_BFP only the Q15 early taps  */
+/*                are searched, the direct path lies there.                  */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                                                                           */
+/*  Output Para : Return     Delay in samples                                */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+uint32_t EchoCancellerFormat_delay(EchoCancellerFormatInstance *S) {
+
+	/* procedure data */
+	uint32_t numTaps = S->numTaps;
+	uint32_t First = 0;
+	uint32_t Peak = 0;
+	float32_t Max = 0.0f;
+	float32_t Value;
+	q15_t *pCoeffs = S->Lms.Q15.pCoeffs;
+	uint32_t i;
+
+	/* procedure code */
+#if LMS_BFP
+	First = S->Lms.Q15.Lms.numLate;
+	pCoeffs = S->Lms.Q15.Lms.pEarly - First;
+#endif
+	for (i = 0; i < numTaps; i++) {
+		if (S->Format == ECHO_FORMAT_F32) {
+			Value = fabsf(S->Lms.F32.pCoeffs[i]);
+		} else if (S->Format == ECHO_FORMAT_Q31) {
+			Value = fabsf((float32_t) S->Lms.Q31.pCoeffs[i]);
+		} else if (i >= First) {
+			Value = fabsf((float32_t) pCoeffs[i]);
+		} else {
+			continue;
+		}
+		if (Value > Max) {
+			Max = Value;
+			Peak = i;
+		}
+	}
+
+	/* Coefficients are time reversed */
+	return numTaps - 1u - Peak;
+}
+/*****************************************************************************/
+/*  End         : EchoCancellerFormat_delay                                  */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : EchoCancellerFormat_costs                                  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Gives the degradation levels of the canceller and their    */
+/*                cost, for the deadline monitor. Only Q15 with LMS_DEGRADE  */
+/*                has more than the full level.                              */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                                                                           */
+/*  Output Para : pCost      Multiply-accumulates per sample of each level   */
+/*                           [LMS_DEGRADE_LEVELS]                            */
+/*                Return     Number of levels                                */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+uint16_t EchoCancellerFormat_costs(EchoCancellerFormatInstance *S,
+		uint32_t *pCost) {
+
+	/* procedure data */
+	uint16_t Level;
+
+	/* procedure code */
+	pCost[0] = 2u * S->numTaps;
+	if ((S->Format != ECHO_FORMAT_Q15) || !LMS_DEGRADE) {
+		return 1;
+	}
+	for (Level = 0; Level < LMS_DEGRADE_LEVELS; Level++) {
+		pCost[Level] = LMSDegrade_cost(S->numTaps, Level);
+	}
+	return LMS_DEGRADE_LEVELS;
+}
+/*****************************************************************************/
+/*  End         : EchoCancellerFormat_costs                                  */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : EchoCancellerFormat_level                                  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Sets the degradation level of the following blocks         */
+/*                (below EchoCancellerFormat_costs())                        */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                Level      Level, 0 = full                                 */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void EchoCancellerFormat_level(EchoCancellerFormatInstance *S, uint32_t Level) {
+
+	/* procedure code */
+#if LMS_DEGRADE
+	if (S->Format == ECHO_FORMAT_Q15) {
+		EchoCanceller_level_q15(&S->Lms.Q15, Level);
+	}
+#else
+	(void) S;
+	(void) Level;
+#endif
+}
+/*****************************************************************************/
+/*  End         : EchoCancellerFormat_level                                  */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : EchoCancellerFormat_transferable                           */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Tells whether EchoCancellerFormat_transfer can take the    */
+/*                state of a running canceller over into a new one: both     */
+/*                have the same format and the Q15 canceller keeps no state  */
+/*                besides coefficients and delay lines: not with the block   */
+/*                floating point (LMS_BFP), the active tap lists of          */
+/*                LMS_SPARSE or the resonators of LMS_HYBRID.                */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          New instance, just initialized                  */
+/*                pFrom      Running instance                                */
+/*                                                                           */
+/*  Output Para : Return     1 if transferable, 0 if not                     */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+uint8_t EchoCancellerFormat_transferable(const EchoCancellerFormatInstance *S,
+		const EchoCancellerFormatInstance *pFrom) {
+
+	/* procedure code */
+	if ((S->Format != pFrom->Format) || ((S->Format == ECHO_FORMAT_Q15) &&
+			(LMS_BFP || LMS_SPARSE || LMS_HYBRID))) {
+		return 0;
+	}
+	return 1;
+}
+/*****************************************************************************/
+/*  End         : EchoCancellerFormat_transferable                           */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : EchoCancellerFormat_transfer                               */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Copies the coefficients and the delay line of a running    */
+/*                canceller of the same format into a new one with another   */
+/*                number of taps, aligned at the newest sample: a longer     */
+/*                filter gets zero late taps, a shorter one loses the latest */
+/*                taps.                                                      */
+/*                                                                           */
+/*                pFrom must not run meanwhile: call it from the interrupt   */
+/*                that runs the cancellers, or from the idle loop with the   */
+/*                interrupts locked.                                         */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          New instance, just initialized                  */
+/*                pFrom      Running instance                                */
+/*                                                                           */
+/*  Output Para : Return     1 if transferred, 0 if not transferable         */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+uint8_t EchoCancellerFormat_transfer(EchoCancellerFormatInstance *S,
+		const EchoCancellerFormatInstance *pFrom) {
+
+	/* procedure data */
+	uint32_t numTo = S->numTaps;
+	uint32_t numFrom = pFrom->numTaps;
+
+	/* procedure code */
+	if (!EchoCancellerFormat_transferable(S, pFrom)) {
+		return 0;
+	}
+
+	/* The newest numTaps - 1 samples are at the end of the delay line */
+	if (S->Format == ECHO_FORMAT_F32) {
+		Format_copy(S->Lms.F32.pCoeffs, numTo, pFrom->Lms.F32.pCoeffs, numFrom,
+				sizeof(float32_t));
+		Format_copy(S->Lms.F32.pState, numTo - 1u, pFrom->Lms.F32.pState,
+				numFrom - 1u, sizeof(float32_t));
+	} else if (S->Format == ECHO_FORMAT_Q31) {
+		Format_copy(S->Lms.Q31.pCoeffs, numTo, pFrom->Lms.Q31.pCoeffs, numFrom,
+				sizeof(q31_t));
+		Format_copy(S->Lms.Q31.pState, numTo - 1u, pFrom->Lms.Q31.pState,
+				numFrom - 1u, sizeof(q31_t));
+	} else {
+		Format_copy(S->Lms.Q15.pCoeffs, numTo, pFrom->Lms.Q15.pCoeffs, numFrom,
+				sizeof(q15_t));
+		Format_copy(S->Lms.Q15.pState, numTo - 1u, pFrom->Lms.Q15.pState,
+				numFrom - 1u, sizeof(q15_t));
+#if LMS_UPDATE != LMS_UPDATE_FULL
+		Format_copy(S->Lms.Q15.pUpdate, numTo - 1u, pFrom->Lms.Q15.pUpdate,
+				numFrom - 1u, sizeof(q15_t));
+#endif
+	}
+	return 1;
+}
+/*****************************************************************************/
+/*  End         : EchoCancellerFormat_transfer                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Format_copy                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Copies the last elements of one array to the end of        */
+/*                another, as many as fit in both                            */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : numTo      Elements of the destination                     */
+/*                pFrom      Source                                          */
+/*                numFrom    Elements of the source                          */
+/*                Size       Bytes per element                               */
+/*                                                                           */
+/*  Output Para : pTo        Destination                                     */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Format_copy(void *pTo, uint32_t numTo, const void *pFrom,
+		uint32_t numFrom, uint32_t Size) {
+
+	/* procedure data */
+	uint32_t Count = (numTo < numFrom) ? numTo : numFrom;
+
+	/* procedure code */
+	memcpy((uint8_t *) pTo + (numTo - Count) * Size,
+			(const uint8_t *) pFrom + (numFrom - Count) * Size, Count * Size);
+}
+/*****************************************************************************/
+/*  End         : Format_copy                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : EchoCancellerFormat                                        */
+/*****************************************************************************/
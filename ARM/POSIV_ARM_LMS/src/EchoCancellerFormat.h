@@ -0,0 +1,101 @@
+#ifndef ECHOCANCELLERFORMAT_H
+#define ECHOCANCELLERFORMAT_H
+/*****************************************************************************/
+/*  Header     : EchoCancellerFormat                            Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Echo canceller with the number format (float32, Q31, Q15)   */
+/*               chosen at runtime. All formats are linked into the same     */
+/*               image, the interface is the same Q15 one for all of them.   */
+/*                                                                           */
+/*  Procedures : EchoCancellerFormat_init()                                  */
+/*               EchoCancellerFormat_reset()                                 */
+/*               EchoCancellerFormat_q15()                                   */
+/*               EchoCancellerFormat_skip_q15()                              */
+/*               EchoCancellerFormat_idle()                                  */
+/*               EchoCancellerFormat_report()                                */
+/*               EchoCancellerFormat_coeffs()                                */
+/*               EchoCancellerFormat_delay()                                 */
+/*               EchoCancellerFormat_costs()                                 */
+/*               EchoCancellerFormat_level()                                 */
+/*               EchoCancellerFormat_transfer()                              */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : EchoCancellerFormat.h                                       */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "config.h"
+#include "arm_math.h"
+#include "EchoCanceller.h"
+
+/* module constant declaration  */
+
+/* Number formats of the canceller */
+#define ECHO_FORMAT_F32 0
+#define ECHO_FORMAT_Q31 1
+#define ECHO_FORMAT_Q15 2
+
+/* Memory (number of uint32_t) for numTaps coefficients, enough for every */
+/* format, so the format can be changed without new memory               */
+#define ECHO_CANCELLER_FORMAT_MEMORY(numTaps) \
+	((2 * (numTaps) + BLOCK_SIZE - 1 > (ECHO_CANCELLER_MEMORY(numTaps) + 1) / 2) ? \
+	2 * (numTaps) + BLOCK_SIZE - 1 : (ECHO_CANCELLER_MEMORY(numTaps) + 1) / 2)
+
+/* module type declaration      */
+
+/* Instance, only to be accessed through the procedures below */
+typedef struct
+{
+	uint8_t Format;
+	uint16_t numTaps;
+	q15_t Mu;
+	uint32_t *pMemory;
+	union
+	{
+		arm_lms_instance_f32 F32;
+		arm_lms_instance_q31 Q31;
+		EchoCancellerInstanceQ15 Q15;
+	} Lms;
+#if LMS_METRICS
+	LMSMetricsQ15 Metrics;    /* float32 and Q31, Q15 has its own */
+#endif
+} EchoCancellerFormatInstance;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+void EchoCancellerFormat_init(EchoCancellerFormatInstance *S, uint8_t Format,
+		uint16_t numTaps, q15_t Mu, uint32_t *pMemory);
+void EchoCancellerFormat_reset(EchoCancellerFormatInstance *S);
+RAMFUNC void EchoCancellerFormat_q15(EchoCancellerFormatInstance *S, q15_t *pSrc,
+		q15_t *pMic, q15_t *pErr, uint32_t blockSize);
+RAMFUNC void EchoCancellerFormat_skip_q15(EchoCancellerFormatInstance *S,
+		q15_t *pSrc, uint32_t blockSize);
+void EchoCancellerFormat_idle(EchoCancellerFormatInstance *S);
+#if LMS_METRICS
+void EchoCancellerFormat_report(EchoCancellerFormatInstance *S,
+		LMSMetricsReport *pReport);
+#endif
+uint32_t EchoCancellerFormat_coeffs(EchoCancellerFormatInstance *S,
+		void **ppCoeffs);
+uint32_t EchoCancellerFormat_delay(EchoCancellerFormatInstance *S);
+uint16_t EchoCancellerFormat_costs(EchoCancellerFormatInstance *S,
+		uint32_t *pCost);
+void EchoCancellerFormat_level(EchoCancellerFormatInstance *S, uint32_t Level);
+uint8_t EchoCancellerFormat_transferable(const EchoCancellerFormatInstance *S,
+		const EchoCancellerFormatInstance *pFrom);
+uint8_t EchoCancellerFormat_transfer(EchoCancellerFormatInstance *S,
+		const EchoCancellerFormatInstance *pFrom);
+
+/*****************************************************************************/
+/*  End Header  : EchoCancellerFormat                                        */
+/*****************************************************************************/
+#endif
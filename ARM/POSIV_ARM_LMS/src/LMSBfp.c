@@ -0,0 +1,254 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : LMSBfp                                         Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Q15 LMS with compressed late taps.                          */
+/*               The late part of an echo path is small, so the late taps    */
+/*               are stored in block floating point: an 8 bit mantissa per   */
+/*               tap and one exponent per LMS_BFP_BLOCK taps, about one byte */
+/*               per tap instead of two. The first taps (LMS_BFP_EARLY,      */
+/*               direct path and first reflections) stay Q15.                */
+/*                                                                           */
+/*               Filter: four mantissas are loaded with one word and split   */
+/*               with __SXTB16 into two pairs for __SMLAD, the sum of a      */
+/*               block is shifted by its exponent. The early taps are        */
+/*               filtered as by arm_lms_q15().                               */
+/*                                                                           */
+/*               Update: the taps of a block are expanded to Q15, updated    */
+/*               and stored again with the smallest exponent that holds the  */
+/*               largest tap. Update term and mantissas are rounded, not     */
+/*               truncated as in arm_lms_q15(): the truncation adds a bias   */
+/*               of -1/2 LSB per tap and sample, which the coarse late taps  */
+/*               would otherwise collect until they saturate. Mantissas are  */
+/*               rounded stochastically (random offset below one step), so   */
+/*               updates smaller than the step of a block still count in     */
+/*               the mean instead of being lost.                             */
+/*                                                                           */
+/*  Procedures : LMSBfp_init_q15()                                           */
+/*               LMSBfp_q15()                                                */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSBfp.c                                                    */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "LMSBfp.h"
+
+/* module constant declaration */
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+
+/*****************************************************************************/
+/*  Procedure   : LMSBfp_init_q15                                            */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Initializes an instance. The state is cleared, the         */
+/*                coefficients are left as they are (as arm_lms_init_q15)    */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance to initialize                          */
+/*                numTaps    Number of filter coefficients                   */
+/*                pCoeffs    Coefficient memory [LMS_BFP_MEMORY(numTaps)],   */
+/*                           32 bit aligned                                  */
+/*                pState     State buffer [numTaps + blockSize - 1]          */
+/*                mu         Step size (Q15)                                 */
+/*                blockSize  Number of samples per call                      */
+/*                postShift  Shift of filter output, as for arm_lms_q15      */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void LMSBfp_init_q15(LMSBfpInstanceQ15 *S, uint16_t numTaps, q15_t *pCoeffs,
+		q15_t *pState, q15_t mu, uint32_t blockSize, uint32_t postShift) {
+
+	/* procedure data */
+	uint32_t numLate = LMS_BFP_LATE(numTaps);
+
+	/* procedure code */
+	S->numTaps = numTaps;
+	S->numLate = (uint16_t) numLate;
+	S->pState = pState;
+	S->mu = mu;
+	S->postShift = postShift;
+	S->Seed = 1u;
+
+	S->pMantissa = (q7_t *) pCoeffs;
+	S->pExponent = (uint8_t *) pCoeffs + numLate;
+	S->pEarly = pCoeffs + (numLate + numLate / LMS_BFP_BLOCK + 1u) / 2u;
+
+	memset(pState, 0, (numTaps + (blockSize - 1u)) * sizeof(q15_t));
+}
+/*****************************************************************************/
+/*  End         : LMSBfp_init_q15                                            */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSBfp_q15                                                 */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Filters one block and adapts the coefficients              */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Input (reference) samples [blockSize]           */
+/*                pRef       Desired samples [blockSize]                     */
+/*                blockSize  Number of samples to process                    */
+/*                                                                           */
+/*  Output Para : pOut       Filter output [blockSize]                       */
+/*                pErr       Error (pRef - pOut) [blockSize]                 */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC void LMSBfp_q15(LMSBfpInstanceQ15 *S, q15_t *pSrc, q15_t *pRef, q15_t *pOut,
+		q15_t *pErr, uint32_t blockSize) {
+
+	/* procedure data */
+	q15_t *pState = S->pState;
+	uint32_t numTaps = S->numTaps;
+	uint32_t numLate = S->numLate;
+	uint32_t numEarly = numTaps - numLate;
+	q15_t *pStateCurnt = &pState[numTaps - 1u];
+	int32_t lShift = (15 - (int32_t) S->postShift);
+	int32_t uShift = (32 - lShift);
+	q31_t Tap[LMS_BFP_BLOCK];
+	q15_t *px;
+	q15_t *pb;
+	q7_t *pm;
+	uint8_t *pExp;
+	uint32_t tapCnt;
+	uint32_t blkCnt;
+	uint32_t Block;
+	uint32_t Mantissas;
+	q31_t x01;
+	q31_t x23;
+	q31_t Sum;
+	q31_t Magnitude;
+	q31_t coef;
+	uint32_t Exp;
+	uint32_t Seed = S->Seed;
+	q63_t acc;
+	q31_t acc_l;
+	q31_t acc_h;
+	q15_t e;
+	q15_t alpha;
+
+	/* procedure code */
+
+	for (blkCnt = blockSize; blkCnt > 0u; blkCnt--) {
+
+		*pStateCurnt++ = *pSrc++;
+
+		/* Filter the late taps, one word of mantissas per 4 taps */
+		px = pState;
+		pm = S->pMantissa;
+		pExp = S->pExponent;
+		acc = 0;
+		for (Block = numLate / LMS_BFP_BLOCK; Block > 0u; Block--) {
+			Sum = 0;
+			for (tapCnt = LMS_BFP_BLOCK >> 2u; tapCnt > 0u; tapCnt--) {
+				Mantissas = *__SIMD32(pm)++;
+				x01 = *__SIMD32(px)++;
+				x23 = *__SIMD32(px)++;
+				Sum = __SMLAD(__SXTB16(Mantissas), __PKHBT(x01, x23, 16), Sum);
+				Sum = __SMLAD(__SXTB16(__ROR(Mantissas, 8)), __PKHTB(x23, x01, 16), Sum);
+			}
+			acc += (q63_t) Sum << *pExp++;
+		}
+
+		/* Filter the early taps (as arm_lms_q15) */
+		pb = S->pEarly;
+		for (tapCnt = numEarly >> 2u; tapCnt > 0u; tapCnt--) {
+			acc = __SMLALD(*__SIMD32(px)++, *__SIMD32(pb)++, acc);
+			acc = __SMLALD(*__SIMD32(px)++, *__SIMD32(pb)++, acc);
+		}
+		for (tapCnt = numEarly & 3u; tapCnt > 0u; tapCnt--) {
+			acc += (q63_t) ((q31_t) (*px++) * (*pb++));
+		}
+
+		/* Scale to 1.15 and saturate */
+		acc_l = acc & 0xffffffff;
+		acc_h = (acc >> 32) & 0xffffffff;
+		acc = (uint32_t) acc_l >> lShift | acc_h << uShift;
+		acc = __SSAT(acc, 16);
+
+		*pOut++ = (q15_t) acc;
+		e = *pRef++ - (q15_t) acc;
+		*pErr++ = e;
+		alpha = (q15_t) (((q31_t) e * (S->mu)) >> 15);
+
+		/* Update the late taps, block by block */
+		px = pState;
+		pm = S->pMantissa;
+		pExp = S->pExponent;
+		for (Block = numLate / LMS_BFP_BLOCK; Block > 0u; Block--) {
+			Magnitude = 0;
+			for (tapCnt = 0; tapCnt < LMS_BFP_BLOCK; tapCnt++) {
+				coef = ((q31_t) pm[tapCnt] << *pExp) +
+						(((q31_t) alpha * (*px++) + 0x4000) >> 15);
+				coef = __SSAT(coef, 16);
+				Tap[tapCnt] = coef;
+				Magnitude |= coef ^ (coef >> 31);
+			}
+
+			/* Smallest exponent with all mantissas in -128 ... 127 */
+			Exp = 32u - __CLZ((uint32_t) Magnitude);
+			Exp = (Exp > 7u) ? Exp - 7u : 0u;
+			*pExp++ = (uint8_t) Exp;
+
+			/* Stochastic rounding: a random offset in 0 ... 2^Exp - 1 keeps */
+			/* updates below the quantization step in the mean             */
+			for (tapCnt = 0; tapCnt < LMS_BFP_BLOCK; tapCnt++) {
+				coef = Tap[tapCnt];
+				if (Exp > 0u) {
+					Seed = Seed * 1664525u + 1013904223u;
+					coef = (coef + (q31_t) (Seed >> (32u - Exp))) >> Exp;
+				}
+				*pm++ = (q7_t) __SSAT(coef, 8);
+			}
+		}
+
+		/* Update the early taps, rounded as the late ones */
+		pb = S->pEarly;
+		for (tapCnt = numEarly; tapCnt > 0u; tapCnt--) {
+			coef = (q31_t) *pb + (((q31_t) alpha * (*px++) + 0x4000) >> 15);
+			*pb++ = (q15_t) __SSAT(coef, 16);
+		}
+
+		/* Advance window by one sample */
+		pState++;
+	}
+
+	S->Seed = Seed;
+
+	/* Copy the last numTaps - 1 samples to the start of the state buffer */
+	memmove(S->pState, pState, (numTaps - 1u) * sizeof(q15_t));
+}
+/*****************************************************************************/
+/*  End         : LMSBfp_q15                                                 */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : LMSBfp                                                     */
+/*****************************************************************************/
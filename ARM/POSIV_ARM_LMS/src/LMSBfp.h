@@ -0,0 +1,78 @@
+#ifndef LMSBFP_H
+#define LMSBFP_H
+/*****************************************************************************/
+/*  Header     : LMSBfp                                         Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Q15 LMS with the late taps stored in block floating point   */
+/*               (8 bit mantissa, one exponent per LMS_BFP_BLOCK taps)       */
+/*                                                                           */
+/*  Procedures : LMSBfp_init_q15()                                           */
+/*               LMSBfp_q15()                                                */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSBfp.h                                                    */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "config.h"
+#include "arm_math.h"
+
+/* module constant declaration  */
+
+/* Taps of the early region kept in Q15 (direct path and first reflections, */
+/* 32ms at 8kHz). Taps that do not fill a whole late block are added to it. */
+#define LMS_BFP_EARLY 256
+
+/* Taps sharing one exponent (multiple of 4) */
+#define LMS_BFP_BLOCK 16
+
+/* Number of late (block floating point) taps of a filter with numTaps */
+#define LMS_BFP_LATE(numTaps) \
+	(((numTaps) > LMS_BFP_EARLY) ? \
+	(((numTaps) - LMS_BFP_EARLY) / LMS_BFP_BLOCK) * LMS_BFP_BLOCK : 0)
+
+/* Coefficient memory (number of q15_t) of a filter with numTaps:        */
+/* mantissas and exponents of the late taps (bytes), then the early taps  */
+#define LMS_BFP_MEMORY(numTaps) \
+	((numTaps) - LMS_BFP_LATE(numTaps) + \
+	(LMS_BFP_LATE(numTaps) + LMS_BFP_LATE(numTaps) / LMS_BFP_BLOCK + 1) / 2)
+
+/* module type declaration      */
+
+/* Instance. The taps are in the order of arm_lms_q15() (time reversed),   */
+/* so the late taps pair with the oldest samples of the state and come    */
+/* first: coefficient k < numLate is pMantissa[k] << pExponent[k / BLOCK], */
+/* coefficient k >= numLate is pEarly[k - numLate]                         */
+typedef struct
+{
+	uint16_t numTaps;
+	uint16_t numLate;
+	q15_t *pState;
+	q15_t *pEarly;
+	q7_t *pMantissa;
+	uint8_t *pExponent;
+	q15_t mu;
+	uint32_t postShift;
+	uint32_t Seed;            /* Random generator of the rounding */
+} LMSBfpInstanceQ15;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+void LMSBfp_init_q15(LMSBfpInstanceQ15 *S, uint16_t numTaps, q15_t *pCoeffs,
+		q15_t *pState, q15_t mu, uint32_t blockSize, uint32_t postShift);
+RAMFUNC void LMSBfp_q15(LMSBfpInstanceQ15 *S, q15_t *pSrc, q15_t *pRef, q15_t *pOut,
+		q15_t *pErr, uint32_t blockSize);
+
+/*****************************************************************************/
+/*  End Header  : LMSBfp                                                     */
+/*****************************************************************************/
+#endif
@@ -0,0 +1,261 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : LMSDegrade                                     Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Q15 LMS with levels of reduced cost, chosen block by block  */
+/*               by the deadline monitor (Deadline.c) under overload.        */
+/*                                                                           */
+/*               All levels work on the instance and delay line of           */
+/*               arm_lms_q15() with its arithmetic, so the level can change  */
+/*               between any two blocks without a transient and without      */
+/*               losing the converged coefficients:                          */
+/*               - PARTIAL updates one of LMS_DEGRADE_SHARE segments of the  */
+/*                 taps per sample, round robin (sequential partial update). */
+/*                 The filter output is exact, convergence is slower.        */
+/*               - FREEZE filters with the coefficients as they are.         */
+/*               - SHORT filters with the newest LMS_DEGRADE_SHORT_TAPS taps */
+/*                 only, the late echo is left in the output.                */
+/*                                                                           */
+/*  Procedures : LMSDegrade_q15()                                            */
+/*               LMSDegrade_cost()                                           */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSDegrade.c                                                */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "LMSDegrade.h"
+
+/* module constant declaration */
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+RAMFUNC static q15_t Degrade_filter(q15_t *px, q15_t *pb, uint32_t numTaps,
+		uint32_t postShift);
+RAMFUNC static void Degrade_update(q15_t *px, q15_t *pb, uint32_t numTaps,
+		q15_t alpha);
+
+/*****************************************************************************/
+/*  Procedure   : LMSDegrade_q15                                             */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Filters one block and adapts the coefficients as far as    */
+/*                the level allows                                           */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance (see arm_lms_init_q15())               */
+/*                pSrc       Input (reference) samples [blockSize]           */
+/*                pRef       Desired samples [blockSize]                     */
+/*                blockSize  Number of samples to process                    */
+/*                Level      LMS_DEGRADE_xxx                                 */
+/*                pPhase     Next segment of LMS_DEGRADE_PARTIAL             */
+/*                                                                           */
+/*  Output Para : pOut       Filter output [blockSize]                       */
+/*                pErr       Error (pRef - pOut) [blockSize]                 */
+/*                pPhase     Updated segment                                 */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC void LMSDegrade_q15(arm_lms_instance_q15 *S, q15_t *pSrc, q15_t *pRef,
+		q15_t *pOut, q15_t *pErr, uint32_t blockSize, uint32_t Level,
+		uint32_t *pPhase) {
+
+	/* procedure data */
+	q15_t *pState = S->pState;
+	q15_t *pCoeffs = S->pCoeffs;
+	uint32_t numTaps = S->numTaps;
+	uint32_t numShort = (numTaps < LMS_DEGRADE_SHORT_TAPS) ?
+			numTaps : LMS_DEGRADE_SHORT_TAPS;
+	q15_t *pStateCurnt = &pState[numTaps - 1u];
+	uint32_t blkCnt;
+	uint32_t Start;
+	uint32_t End;
+	q15_t y;
+	q15_t e;
+	q15_t alpha;
+
+	/* procedure code */
+	if (Level == LMS_DEGRADE_FULL) {
+		arm_lms_q15(S, pSrc, pRef, pOut, pErr, blockSize);
+		return;
+	}
+
+	for (blkCnt = blockSize; blkCnt > 0u; blkCnt--) {
+
+		*pStateCurnt++ = *pSrc++;
+
+		/* The coefficients are time reversed, the newest taps are last */
+		if (Level >= LMS_DEGRADE_SHORT) {
+			y = Degrade_filter(&pState[numTaps - numShort],
+					&pCoeffs[numTaps - numShort], numShort, S->postShift);
+		} else {
+			y = Degrade_filter(pState, pCoeffs, numTaps, S->postShift);
+		}
+
+		*pOut++ = y;
+		e = *pRef++ - y;
+		*pErr++ = e;
+
+		/* Update one segment of the taps */
+		if (Level == LMS_DEGRADE_PARTIAL) {
+			alpha = (q15_t) (((q31_t) e * (S->mu)) >> 15);
+			Start = *pPhase * numTaps / LMS_DEGRADE_SHARE;
+			End = (*pPhase + 1u) * numTaps / LMS_DEGRADE_SHARE;
+			Degrade_update(&pState[Start], &pCoeffs[Start], End - Start, alpha);
+			*pPhase = (*pPhase + 1u) % LMS_DEGRADE_SHARE;
+		}
+
+		/* Advance window by one sample */
+		pState++;
+	}
+
+	/* Copy the last numTaps - 1 samples to the start of the state buffer */
+	memmove(S->pState, pState, (numTaps - 1u) * sizeof(q15_t));
+}
+/*****************************************************************************/
+/*  End         : LMSDegrade_q15                                             */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSDegrade_cost                                            */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Cost of a level, for the deadline monitor                  */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : numTaps    Number of filter coefficients                   */
+/*                Level      LMS_DEGRADE_xxx                                 */
+/*                                                                           */
+/*  Output Para : Multiply-accumulates per sample                            */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+uint32_t LMSDegrade_cost(uint32_t numTaps, uint32_t Level) {
+
+	/* procedure code */
+	switch (Level) {
+	case LMS_DEGRADE_FULL:
+		return 2u * numTaps;
+	case LMS_DEGRADE_PARTIAL:
+		return numTaps + (numTaps + LMS_DEGRADE_SHARE - 1u) / LMS_DEGRADE_SHARE;
+	case LMS_DEGRADE_FREEZE:
+		return numTaps;
+	default:
+		return (numTaps < LMS_DEGRADE_SHORT_TAPS) ?
+				numTaps : LMS_DEGRADE_SHORT_TAPS;
+	}
+}
+/*****************************************************************************/
+/*  End         : LMSDegrade_cost                                            */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Degrade_filter                                             */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : One output sample, as computed by arm_lms_q15()            */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : px         Oldest state sample of the taps                 */
+/*                pb         First coefficient                               */
+/*                numTaps    Number of taps                                  */
+/*                postShift  Shift of the output                             */
+/*                                                                           */
+/*  Output Para : Output sample (1.15, saturated)                            */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC static q15_t Degrade_filter(q15_t *px, q15_t *pb, uint32_t numTaps,
+		uint32_t postShift) {
+
+	/* procedure data */
+	int32_t lShift = (15 - (int32_t) postShift);
+	int32_t uShift = (32 - lShift);
+	uint32_t tapCnt;
+	q63_t acc = 0;
+	q31_t acc_l;
+	q31_t acc_h;
+
+	/* procedure code */
+	for (tapCnt = numTaps >> 2u; tapCnt > 0u; tapCnt--) {
+		acc = __SMLALD(*__SIMD32(px)++, *__SIMD32(pb)++, acc);
+		acc = __SMLALD(*__SIMD32(px)++, *__SIMD32(pb)++, acc);
+	}
+	for (tapCnt = numTaps & 3u; tapCnt > 0u; tapCnt--) {
+		acc += (q63_t) ((q31_t) (*px++) * (*pb++));
+	}
+
+	/* Scale to 1.15 and saturate */
+	acc_l = acc & 0xffffffff;
+	acc_h = (acc >> 32) & 0xffffffff;
+	acc = (uint32_t) acc_l >> lShift | acc_h << uShift;
+	return (q15_t) __SSAT(acc, 16);
+}
+/*****************************************************************************/
+/*  End         : Degrade_filter                                             */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Degrade_update                                             */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Adapts a range of taps, as arm_lms_q15()                   */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : px         State sample of the first tap                   */
+/*                pb         First coefficient                               */
+/*                numTaps    Number of taps                                  */
+/*                alpha      Error times step size                           */
+/*                                                                           */
+/*  Output Para : pb         Updated coefficients                            */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC static void Degrade_update(q15_t *px, q15_t *pb, uint32_t numTaps,
+		q15_t alpha) {
+
+	/* procedure data */
+	uint32_t tapCnt;
+	q31_t coef;
+
+	/* procedure code */
+	for (tapCnt = numTaps; tapCnt > 0u; tapCnt--) {
+		coef = (q31_t) *pb + (((q31_t) alpha * (*px++)) >> 15);
+		*pb++ = (q15_t) __SSAT(coef, 16);
+	}
+}
+/*****************************************************************************/
+/*  End         : Degrade_update                                             */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : LMSDegrade                                                 */
+/*****************************************************************************/
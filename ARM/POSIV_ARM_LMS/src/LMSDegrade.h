@@ -0,0 +1,62 @@
+#ifndef LMSDEGRADE_H
+#define LMSDEGRADE_H
+/*****************************************************************************/
+/*  Header     : LMSDegrade                                     Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Q15 LMS (arm_lms_q15() instance) with reduced cost levels   */
+/*               for overload                                                */
+/*                                                                           */
+/*  Procedures : LMSDegrade_q15()                                            */
+/*               LMSDegrade_cost()                                           */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSDegrade.h                                                */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "config.h"
+#include "arm_math.h"
+
+/* module constant declaration  */
+
+/* Levels, in order of decreasing cost                                  */
+/* FULL:    arm_lms_q15()                                               */
+/* PARTIAL: all taps filtered, 1/LMS_DEGRADE_SHARE of them updated per  */
+/*          sample (round robin)                                        */
+/* FREEZE:  all taps filtered, no update                                */
+/* SHORT:   the LMS_DEGRADE_SHORT_TAPS newest taps filtered, no update  */
+#define LMS_DEGRADE_FULL 0
+#define LMS_DEGRADE_PARTIAL 1
+#define LMS_DEGRADE_FREEZE 2
+#define LMS_DEGRADE_SHORT 3
+#define LMS_DEGRADE_LEVELS 4
+
+/* Share of the taps updated per sample in LMS_DEGRADE_PARTIAL (1/4) */
+#define LMS_DEGRADE_SHARE 4
+
+/* Taps of LMS_DEGRADE_SHORT (direct path and first reflections, */
+/* 32ms at 8kHz)                                                 */
+#define LMS_DEGRADE_SHORT_TAPS 256
+
+/* module type declaration      */
+
+/* module data declaration      */
+
+/* module procedure declaration */
+RAMFUNC void LMSDegrade_q15(arm_lms_instance_q15 *S, q15_t *pSrc, q15_t *pRef,
+		q15_t *pOut, q15_t *pErr, uint32_t blockSize, uint32_t Level,
+		uint32_t *pPhase);
+uint32_t LMSDegrade_cost(uint32_t numTaps, uint32_t Level);
+
+/*****************************************************************************/
+/*  End Header  : LMSDegrade                                                 */
+/*****************************************************************************/
+#endif
@@ -0,0 +1,202 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : LMSHybrid                                      Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Hybrid echo canceller for reverberant rooms.                */
+/*                                                                           */
+/*               The early reflections are cancelled by a short adaptive     */
+/*               FIR (arm_lms_q15). The exponentially decaying tail behind   */
+/*               the FIR is modelled by LMS_HYBRID_SECTIONS resonators       */
+/*               (arm_biquad_cascade_df1_fast_q15, one section each), fed    */
+/*               with the reference delayed by the FIR length.               */
+/*               Their outputs are weighted with adaptive gains, updated     */
+/*               with the LMS gradient of the common error.                  */
+/*                                                                           */
+/*               The poles are fixed (resonance frequencies and decay from   */
+/*               LMS_HYBRID_FREQUENCIES and LMS_HYBRID_T60), so the tail     */
+/*               model can never get unstable; only the linear gains adapt.  */
+/*               A tail of several thousand samples thus costs about         */
+/*               7 MACs per section and sample.                              */
+/*                                                                           */
+/*  Procedures : LMSHybrid_init_q15()                                        */
+/*               LMSHybrid_q15()                                             */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSHybrid.c                                                 */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "LMSHybrid.h"
+#include <math.h>
+
+/* module constant declaration */
+
+/* The fast biquad needs the input scaled down by 2 bits */
+#define TAIL_INPUT_SHIFT 2
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+
+/*****************************************************************************/
+/*  Procedure   : LMSHybrid_init_q15                                         */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Initializes the tail model for an already initialized      */
+/*                LMS instance (the FIR part). Computes the resonator        */
+/*                coefficients, each section is normalized to unit power     */
+/*                gain for white noise. All gains start at 0.                */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance to initialize                          */
+/*                pLms       Initialized LMS instance for the FIR part       */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void LMSHybrid_init_q15(LMSHybridInstanceQ15 *S, arm_lms_instance_q15 *pLms) {
+
+	/* procedure data */
+	const float32_t Frequencies[LMS_HYBRID_SECTIONS] = LMS_HYBRID_FREQUENCIES;
+	float32_t r;
+	float32_t c;
+	float32_t Variance;
+	int k;
+
+	/* procedure code */
+	S->pLms = pLms;
+	S->Mu = LMS_HYBRID_MU;
+
+	/* Pole radius for a decay of 60dB in T60 */
+	r = powf(10.0f, -3.0f / (LMS_HYBRID_T60 * 0.001f * FS));
+
+	for (k = 0; k < LMS_HYBRID_SECTIONS; k++) {
+
+		/* Power gain of 1/(1 - 2r cos(w) z^-1 + r^2 z^-2) */
+		c = cosf(2.0f * PI * Frequencies[k] / FS);
+		Variance = (1.0f + r * r) /
+				((1.0f - r * r) * ((1.0f + r * r) * (1.0f + r * r) - 4.0f * r * r * c * c));
+
+		/* {b0, 0, b1, b2, a1, a2}, halved for postShift 1. b0 = 0, so the */
+		/* tail starts one sample after the last FIR tap                   */
+		S->SectionCoeffs[k][0] = 0;
+		S->SectionCoeffs[k][1] = 0;
+		S->SectionCoeffs[k][2] = (q15_t) (16384.0f / sqrtf(Variance));
+		S->SectionCoeffs[k][3] = 0;
+		S->SectionCoeffs[k][4] = (q15_t) (16384.0f * 2.0f * r * c);
+		S->SectionCoeffs[k][5] = (q15_t) (-16384.0f * r * r);
+
+		arm_biquad_cascade_df1_init_q15(&S->Section[k], 1, S->SectionCoeffs[k],
+				S->SectionState[k], 1);
+
+		S->V[k][0] = 0;
+		S->Gains[2 * k] = 0;
+		S->Gains[2 * k + 1] = 0;
+	}
+}
+/*****************************************************************************/
+/*  End         : LMSHybrid_init_q15                                         */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSHybrid_q15                                              */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Processes one block. The tail estimate is removed from     */
+/*                the desired signal, the FIR adapts to the rest, and the    */
+/*                tail gains adapt with the resulting error.                 */
+/*                Arguments are the same as for arm_lms_q15()                */
+/*                (blockSize must not exceed BLOCK_SIZE)                     */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Input (reference) samples [blockSize]           */
+/*                pRef       Desired samples [blockSize]                     */
+/*                blockSize  Number of samples to process                    */
+/*                                                                           */
+/*  Output Para : pOut       Echo estimate, FIR plus tail [blockSize]        */
+/*                pErr       Error (pRef - pOut) [blockSize]                 */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC void LMSHybrid_q15(LMSHybridInstanceQ15 *S, q15_t *pSrc, q15_t *pRef,
+		q15_t *pOut, q15_t *pErr, uint32_t blockSize) {
+
+	/* procedure data */
+	q15_t *pState = S->pLms->pState;
+	q31_t acc;
+	q31_t Step;
+	uint32_t i;
+	int k;
+
+	/* procedure code */
+
+	/* Before the FIR runs, the first samples of its state are the      */
+	/* reference delayed by numTaps - 1, this is the input of the tail  */
+	for (i = 0; i < blockSize; i++) {
+		S->TailIn[i] = pState[i] >> TAIL_INPUT_SHIFT;
+	}
+
+	/* Resonator outputs, V[k][0] holds the last one of the previous block */
+	for (k = 0; k < LMS_HYBRID_SECTIONS; k++) {
+		arm_biquad_cascade_df1_fast_q15(&S->Section[k], S->TailIn, &S->V[k][1], blockSize);
+	}
+
+	/* Tail estimate and residual for the FIR */
+	for (i = 0; i < blockSize; i++) {
+		acc = 0;
+		for (k = 0; k < LMS_HYBRID_SECTIONS; k++) {
+			acc += (q31_t) S->Gains[2 * k] * S->V[k][i + 1];
+			acc += (q31_t) S->Gains[2 * k + 1] * S->V[k][i];
+		}
+		S->Tail[i] = (q15_t) __SSAT(acc >> (15 - TAIL_INPUT_SHIFT), 16);
+		S->Residual[i] = (q15_t) __SSAT((q31_t) pRef[i] - S->Tail[i], 16);
+	}
+
+	/* Early reflections */
+	arm_lms_q15(S->pLms, pSrc, S->Residual, pOut, pErr, blockSize);
+
+	/* Tail gains, g += mu * e * v (rounded, truncation would drift) */
+	for (i = 0; i < blockSize; i++) {
+		pOut[i] = (q15_t) __SSAT((q31_t) pOut[i] + S->Tail[i], 16);
+		for (k = 0; k < LMS_HYBRID_SECTIONS; k++) {
+			Step = ((q31_t) pErr[i] * S->V[k][i + 1]) >> 15;
+			Step = (Step * S->Mu + 0x4000) >> 15;
+			S->Gains[2 * k] = (q15_t) __SSAT(S->Gains[2 * k] + Step, 16);
+			Step = ((q31_t) pErr[i] * S->V[k][i]) >> 15;
+			Step = (Step * S->Mu + 0x4000) >> 15;
+			S->Gains[2 * k + 1] = (q15_t) __SSAT(S->Gains[2 * k + 1] + Step, 16);
+		}
+	}
+
+	for (k = 0; k < LMS_HYBRID_SECTIONS; k++) {
+		S->V[k][0] = S->V[k][blockSize];
+	}
+}
+/*****************************************************************************/
+/*  End         : LMSHybrid_q15                                              */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : LMSHybrid                                                  */
+/*****************************************************************************/
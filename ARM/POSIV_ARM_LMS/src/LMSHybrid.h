@@ -0,0 +1,73 @@
+#ifndef LMSHYBRID_H
+#define LMSHYBRID_H
+/*****************************************************************************/
+/*  Header     : LMSHybrid                                      Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Hybrid echo canceller, a short adaptive FIR (arm_lms_q15)   */
+/*               for the early reflections plus a low order IIR model of     */
+/*               the reverberant tail behind it                              */
+/*                                                                           */
+/*  Procedures : LMSHybrid_init_q15()                                        */
+/*               LMSHybrid_q15()                                             */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSHybrid.h                                                 */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "config.h"
+#include "arm_math.h"
+
+/* module constant declaration  */
+
+/* Number of resonators (biquad sections) of the tail model */
+#define LMS_HYBRID_SECTIONS 4
+
+/* Resonance frequencies of the sections in Hz */
+#define LMS_HYBRID_FREQUENCIES {300, 700, 1500, 2500}
+
+/* Reverberation time (60dB decay) of the sections in ms */
+#define LMS_HYBRID_T60 400
+
+/* Step size of the tail gains (Q15) */
+#define LMS_HYBRID_MU 256
+
+/* module type declaration      */
+
+/* The tail is modelled as a weighted sum of decaying resonators, fed   */
+/* with the reference delayed by the FIR length. The poles are fixed    */
+/* (always stable), the two gains per section (for output and delayed  */
+/* output, thus any phase) are adapted with the LMS gradient            */
+typedef struct
+{
+	arm_lms_instance_q15 *pLms;
+	arm_biquad_casd_df1_inst_q15 Section[LMS_HYBRID_SECTIONS];
+	q15_t SectionCoeffs[LMS_HYBRID_SECTIONS][6];
+	q15_t SectionState[LMS_HYBRID_SECTIONS][4];
+	q15_t V[LMS_HYBRID_SECTIONS][BLOCK_SIZE + 1];
+	q15_t Gains[2 * LMS_HYBRID_SECTIONS];
+	q15_t TailIn[BLOCK_SIZE];
+	q15_t Residual[BLOCK_SIZE];
+	q15_t Tail[BLOCK_SIZE];
+	q15_t Mu;
+} LMSHybridInstanceQ15;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+void LMSHybrid_init_q15(LMSHybridInstanceQ15 *S, arm_lms_instance_q15 *pLms);
+RAMFUNC void LMSHybrid_q15(LMSHybridInstanceQ15 *S, q15_t *pSrc, q15_t *pRef,
+		q15_t *pOut, q15_t *pErr, uint32_t blockSize);
+
+/*****************************************************************************/
+/*  End Header  : LMSHybrid                                                  */
+/*****************************************************************************/
+#endif
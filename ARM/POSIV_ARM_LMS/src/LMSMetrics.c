@@ -0,0 +1,263 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : LMSMetrics                                     Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Online quality metrics of the echo canceller.               */
+/*                                                                           */
+/*               Short and long term first order power estimates of the      */
+/*               reference (far end), the microphone and the error signal    */
+/*               are updated for every sample (3 squares and 6 shifts).      */
+/*               The estimates are kept scaled by 2^SHIFT in 64 bit: a step  */
+/*               of (Power - Estimate) >> SHIFT on Q30 would drop every      */
+/*               change below 2^SHIFT, levels below about -55dBFS would      */
+/*               read far too low and the ERLE far too high.                 */
+/*               Out of these, the following are derived:                    */
+/*               - ERLE, short and long term (microphone / error power)      */
+/*               - Echo path change events: after convergence, the short     */
+/*                 term error power rises above the long term one, but the   */
+/*                 microphone power does not (else it is rather near end     */
+/*                 speech). There is no double talk detector, a long near    */
+/*                 end talk may still be counted once.                       */
+/*               - Convergence time: active far end time from start (or from */
+/*                 the last echo path change) until the long term ERLE       */
+/*                 reaches LMS_METRICS_TARGET                                */
+/*               All estimates are frozen while the far end is silent.       */
+/*                                                                           */
+/*               The ratios are compared by multiplication, a 64 bit         */
+/*               division would be a library call for every sample.          */
+/*                                                                           */
+/*               The conversion to dB is done by LMSMetrics_report() in      */
+/*               IdleFunction(), the same recursions are implemented in      */
+/*               Matlab/lms_metrics.m for the simulations. The report copies */
+/*               the state again if a block was processed meanwhile, the 64  */
+/*               bit estimates take two loads each and may tear otherwise.   */
+/*                                                                           */
+/*  Procedures : LMSMetrics_init_q15()                                       */
+/*               LMSMetrics_q15()                                            */
+/*               LMSMetrics_report()                                         */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSMetrics.c                                                */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "LMSMetrics.h"
+#include <math.h>
+
+/* module constant declaration */
+
+/* Scaled estimate: S += Power - S / 2^SHIFT, S / 2^SHIFT is the power */
+#define METRICS_UPDATE(S, Power, Shift) ((S) += (Power) - ((S) >> (Shift)))
+
+/* Short term estimate scaled like a long term one, for comparisons */
+#define METRICS_AS_LONG(S) ((S) << (LMS_METRICS_LONG_SHIFT - LMS_METRICS_SHORT_SHIFT))
+
+#if LMS_METRICS_LONG_SHIFT < LMS_METRICS_SHORT_SHIFT
+#error "LMS_METRICS_LONG_SHIFT must not be shorter than LMS_METRICS_SHORT_SHIFT"
+#endif
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+static float32_t PowerToDB(q63_t Power, uint32_t Shift);
+
+/*****************************************************************************/
+/*  Procedure   : LMSMetrics_init_q15                                        */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Resets all estimates and counters                          */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance to initialize                          */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void LMSMetrics_init_q15(LMSMetricsQ15 *S) {
+
+	/* procedure code */
+	memset(S, 0, sizeof(LMSMetricsQ15));
+}
+/*****************************************************************************/
+/*  End         : LMSMetrics_init_q15                                        */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSMetrics_q15                                             */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Updates the metrics with one block of samples. Is called   */
+/*                from ProcessBlock() after the echo canceller.              */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Reference (far end) samples [blockSize]         */
+/*                pMic       Microphone (desired) samples [blockSize]        */
+/*                pErr       Error samples [blockSize]                       */
+/*                blockSize  Number of samples                               */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC void LMSMetrics_q15(LMSMetricsQ15 *S, q15_t *pSrc, q15_t *pMic, q15_t *pErr,
+		uint32_t blockSize) {
+
+	/* procedure data */
+	q31_t Power;
+	uint16_t Changing;
+	uint32_t i;
+
+	/* procedure code */
+	for (i = 0; i < blockSize; i++) {
+
+		S->SampleCount++;
+
+		Power = (q31_t) pSrc[i] * pSrc[i];
+		METRICS_UPDATE(S->RefShort, Power, LMS_METRICS_SHORT_SHIFT);
+		METRICS_UPDATE(S->RefLong, Power, LMS_METRICS_LONG_SHIFT);
+
+		/* Nothing to measure while the far end is silent */
+		if (S->RefLong < ((q63_t) LMS_METRICS_ACTIVE << LMS_METRICS_LONG_SHIFT)) {
+			continue;
+		}
+
+		Power = (q31_t) pMic[i] * pMic[i];
+		METRICS_UPDATE(S->MicShort, Power, LMS_METRICS_SHORT_SHIFT);
+		METRICS_UPDATE(S->MicLong, Power, LMS_METRICS_LONG_SHIFT);
+
+		Power = (q31_t) pErr[i] * pErr[i];
+		METRICS_UPDATE(S->ErrShort, Power, LMS_METRICS_SHORT_SHIFT);
+		METRICS_UPDATE(S->ErrLong, Power, LMS_METRICS_LONG_SHIFT);
+
+		S->ActiveCount++;
+
+		/* Long term ERLE reached the target for the first time? */
+		if ((S->ConvergenceTime == 0) &&
+				(S->MicLong > S->ErrLong * LMS_METRICS_TARGET)) {
+			S->ConvergenceTime = S->ActiveCount;
+		}
+
+		/* Echo path change, only detected once converged and counted */
+		/* once per rising edge. Restarts the convergence time, and    */
+		/* the long term error estimate at 0dB ERLE (else the old, low */
+		/* error power would count as converged immediately)           */
+		Changing = (METRICS_AS_LONG(S->ErrShort) >
+				S->ErrLong * LMS_METRICS_CHANGE_RISE) &&
+				(METRICS_AS_LONG(S->MicShort) <=
+				S->MicLong * LMS_METRICS_CHANGE_RISE);
+		if (Changing && !S->Changing && (S->ConvergenceTime != 0)) {
+			S->PathChanges++;
+			S->ActiveCount = 0;
+			S->ConvergenceTime = 0;
+			S->ErrLong = S->MicLong;
+		}
+		S->Changing = Changing;
+	}
+	S->Sequence++;
+}
+/*****************************************************************************/
+/*  End         : LMSMetrics_q15                                             */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSMetrics_report                                          */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Converts the current state into the report (dB and s).     */
+/*                Is called from IdleFunction(), the state is copied until   */
+/*                no block was processed during the copy.                    */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                                                                           */
+/*  Output Para : pReport    Report to fill                                  */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void LMSMetrics_report(LMSMetricsQ15 *S, LMSMetricsReport *pReport) {
+
+	/* procedure data */
+	const volatile LMSMetricsQ15 *pState = S;
+	LMSMetricsQ15 State;
+	uint32_t Sequence;
+
+	/* procedure code */
+	do {
+		Sequence = pState->Sequence;
+		State = *pState;
+	} while (Sequence != pState->Sequence);
+
+	pReport->ErleShort = PowerToDB(State.MicShort, LMS_METRICS_SHORT_SHIFT) -
+			PowerToDB(State.ErrShort, LMS_METRICS_SHORT_SHIFT);
+	pReport->ErleLong = PowerToDB(State.MicLong, LMS_METRICS_LONG_SHIFT) -
+			PowerToDB(State.ErrLong, LMS_METRICS_LONG_SHIFT);
+	pReport->ReferenceLevel = PowerToDB(State.RefLong, LMS_METRICS_LONG_SHIFT);
+	pReport->ErrorLevel = PowerToDB(State.ErrLong, LMS_METRICS_LONG_SHIFT);
+	pReport->ConvergenceTime = (State.ConvergenceTime != 0) ?
+			(float32_t) State.ConvergenceTime / FS : -1.0f;
+	pReport->PathChanges = State.PathChanges;
+	pReport->Runtime = (float32_t) State.SampleCount / FS;
+}
+/*****************************************************************************/
+/*  End         : LMSMetrics_report                                          */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : PowerToDB                                                  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Converts a scaled Q30 power into dB full scale             */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : Power      Power in Q30, scaled by 2^Shift                 */
+/*                Shift      Scale of the estimate                           */
+/*                                                                           */
+/*  Output Para : Return     Power in dBFS (-100 for 0)                      */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static float32_t PowerToDB(q63_t Power, uint32_t Shift) {
+
+	/* procedure code */
+	if (Power <= 0) {
+		return -100.0f;
+	}
+	return 10.0f * log10f((float32_t) Power /
+			(1073741824.0f * (float32_t) (1u << Shift)));
+}
+/*****************************************************************************/
+/*  End         : PowerToDB                                                  */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : LMSMetrics                                                 */
+/*****************************************************************************/
@@ -0,0 +1,95 @@
+#ifndef LMSMETRICS_H
+#define LMSMETRICS_H
+/*****************************************************************************/
+/*  Header     : LMSMetrics                                     Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Online quality metrics of the echo canceller: ERLE,         */
+/*               echo path change events and time to LMS_METRICS_TARGET.     */
+/*               Updated from ProcessBlock() with O(1) cost per sample,      */
+/*               converted to dB in IdleFunction()                           */
+/*                                                                           */
+/*  Procedures : LMSMetrics_init_q15()                                       */
+/*               LMSMetrics_q15()                                            */
+/*               LMSMetrics_report()                                         */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSMetrics.h                                                */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "config.h"
+#include "arm_math.h"
+
+/* module constant declaration  */
+
+/* Time constants of the power estimates, 2^-SHIFT per sample         */
+/* (short 2^7 = 16ms, long 2^12 = 0.5s at 8kHz)                        */
+#define LMS_METRICS_SHORT_SHIFT 7
+#define LMS_METRICS_LONG_SHIFT 12
+
+/* Minimum long term reference power (Q30) for the far end to count as */
+/* active, metrics are frozen while the reference is silent (-50dBFS)  */
+#define LMS_METRICS_ACTIVE 10737
+
+/* Convergence target, ERLE as power ratio (20dB) */
+#define LMS_METRICS_TARGET 100
+
+/* Echo path change: short term error power above the long term one by */
+/* this factor (6dB) without a similar rise of the microphone power    */
+#define LMS_METRICS_CHANGE_RISE 4
+
+/* module type declaration      */
+
+/* Raw state, written by ProcessBlock() only. Powers in Q30, scaled by   */
+/* 2^LMS_METRICS_SHORT_SHIFT or 2^LMS_METRICS_LONG_SHIFT, so the steps of  */
+/* the recursions are not truncated and low levels are not lost            */
+typedef struct
+{
+	q63_t RefShort;
+	q63_t RefLong;
+	q63_t MicShort;
+	q63_t MicLong;
+	q63_t ErrShort;
+	q63_t ErrLong;
+	uint32_t SampleCount;
+	uint32_t ActiveCount;      /* Active samples since start / last change */
+	uint32_t ConvergenceTime;  /* Active samples to reach the target, 0 = */
+	                           /* not (yet) reached                        */
+	uint32_t PathChanges;
+	uint16_t Changing;
+	uint32_t Sequence;         /* Blocks processed, for LMSMetrics_report() */
+} LMSMetricsQ15;
+
+/* Report, filled in IdleFunction() (watch it with the debugger) */
+typedef struct
+{
+	float32_t ErleShort;        /* [dB]                              */
+	float32_t ErleLong;         /* [dB]                              */
+	float32_t ReferenceLevel;   /* Long term reference power [dBFS]  */
+	float32_t ErrorLevel;       /* Long term error power [dBFS]      */
+	float32_t ConvergenceTime;  /* Time to LMS_METRICS_TARGET [s],   */
+	                            /* negative if not reached           */
+	uint32_t PathChanges;       /* Number of echo path change events */
+	float32_t Runtime;          /* [s]                               */
+} LMSMetricsReport;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+void LMSMetrics_init_q15(LMSMetricsQ15 *S);
+RAMFUNC void LMSMetrics_q15(LMSMetricsQ15 *S, q15_t *pSrc, q15_t *pMic, q15_t *pErr,
+		uint32_t blockSize);
+void LMSMetrics_report(LMSMetricsQ15 *S, LMSMetricsReport *pReport);
+
+/*****************************************************************************/
+/*  End Header  : LMSMetrics                                                 */
+/*****************************************************************************/
+#endif
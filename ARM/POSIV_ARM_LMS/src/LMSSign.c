@@ -0,0 +1,271 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : LMSSign                                        Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Sign-error and sign-sign LMS for Q15 samples.               */
+/*               The filtering is identical to arm_lms_q15() (__SMLALD, two  */
+/*               taps per instruction), the coefficient update replaces the  */
+/*               multiply, shift and saturate per tap by one __QADD16 or     */
+/*               __QSUB16 per two taps.                                      */
+/*                                                                           */
+/*               Trades a higher steady state misadjustment for a much       */
+/*               cheaper update loop.                                        */
+/*                                                                           */
+/*  Procedures : LMSSign_init_q15()                                          */
+/*               LMSSign_q15()                                               */
+/*               LMSSign_skip_q15()                                          */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSSign.c                                                   */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "LMSSign.h"
+
+/* module constant declaration */
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+
+/*****************************************************************************/
+/*  Procedure   : LMSSign_init_q15                                           */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Initializes a sign LMS instance. The state and the update  */
+/*                delay line are cleared, the coefficients are left as they  */
+/*                are (so a previous filter may be continued)                */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance to initialize                          */
+/*                numTaps    Number of filter coefficients                   */
+/*                pCoeffs    Coefficient buffer [numTaps]                    */
+/*                pState     State buffer [numTaps + blockSize - 1]          */
+/*                pUpdate    Update delay line [numTaps + blockSize - 1]     */
+/*                Mode       LMS_SIGN_ERROR or LMS_SIGN_SIGN                 */
+/*                MuShift    Step size 2^-MuShift (sign-error only)          */
+/*                Delta      Step size in Q15 (sign-sign only)               */
+/*                blockSize  Number of samples per call                      */
+/*                postShift  Shift of filter output, as for arm_lms_q15      */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void LMSSign_init_q15(LMSSignInstanceQ15 *S, uint16_t numTaps, q15_t *pCoeffs,
+		q15_t *pState, q15_t *pUpdate, uint16_t Mode, uint16_t MuShift,
+		q15_t Delta, uint32_t blockSize, uint32_t postShift) {
+
+	/* procedure code */
+
+	/* mu is not used by the sign variants, the rest is shared */
+	arm_lms_init_q15(&S->Lms, numTaps, pCoeffs, pState, 0, blockSize, postShift);
+
+	/* Clear update delay line */
+	memset(pUpdate, 0, (numTaps + (blockSize - 1u)) * sizeof(q15_t));
+
+	S->pUpdate = pUpdate;
+	S->Mode = Mode;
+	S->MuShift = MuShift;
+	S->Delta = Delta;
+}
+/*****************************************************************************/
+/*  End         : LMSSign_init_q15                                           */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSSign_q15                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Filters one block of samples and adapts the coefficients   */
+/*                with the sign-error or the sign-sign rule.                 */
+/*                Arguments and data formats are the same as for             */
+/*                arm_lms_q15()                                              */
+/*                                                                           */
+/*                For every new input sample its update term is computed     */
+/*                once and stored in the update delay line, the update loop  */
+/*                then only adds or subtracts (depending on the sign of the  */
+/*                error) this delay line to the coefficients, two taps at a  */
+/*                time. With an error of 0 the update is skipped.            */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Input (reference) samples [blockSize]           */
+/*                pRef       Desired samples [blockSize]                     */
+/*                blockSize  Number of samples to process                    */
+/*                                                                           */
+/*  Output Para : pOut       Filter output [blockSize]                       */
+/*                pErr       Error (pRef - pOut) [blockSize]                 */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC void LMSSign_q15(LMSSignInstanceQ15 *S, q15_t *pSrc, q15_t *pRef,
+		q15_t *pOut, q15_t *pErr, uint32_t blockSize) {
+
+	/* procedure data */
+	q15_t *pState = S->Lms.pState;
+	q15_t *pUpdate = S->pUpdate;
+	q15_t *pCoeffs = S->Lms.pCoeffs;
+	uint32_t numTaps = S->Lms.numTaps;
+	q15_t *pStateCurnt = &pState[numTaps - 1u];
+	q15_t *pUpdateCurnt = &pUpdate[numTaps - 1u];
+	int32_t lShift = (15 - (int32_t) S->Lms.postShift);
+	int32_t uShift = (32 - lShift);
+	q15_t *px;
+	q15_t *pu;
+	q15_t *pb;
+	uint32_t tapCnt;
+	uint32_t blkCnt;
+	q63_t acc;
+	q31_t acc_l;
+	q31_t acc_h;
+	q15_t x;
+	q15_t e;
+
+	/* procedure code */
+
+	for (blkCnt = blockSize; blkCnt > 0u; blkCnt--) {
+
+		/* Put new sample and its update term into the delay lines */
+		x = *pSrc++;
+		*pStateCurnt++ = x;
+		if (S->Mode == LMS_SIGN_ERROR) {
+			*pUpdateCurnt++ = x >> S->MuShift;
+		} else {
+			*pUpdateCurnt++ = (x < 0) ? -S->Delta : S->Delta;
+		}
+
+		/* Filter, two taps per __SMLALD (as arm_lms_q15) */
+		px = pState;
+		pb = pCoeffs;
+		acc = 0;
+		for (tapCnt = numTaps >> 2u; tapCnt > 0u; tapCnt--) {
+			acc = __SMLALD(*__SIMD32(px)++, *__SIMD32(pb)++, acc);
+			acc = __SMLALD(*__SIMD32(px)++, *__SIMD32(pb)++, acc);
+		}
+		for (tapCnt = numTaps & 3u; tapCnt > 0u; tapCnt--) {
+			acc += (q63_t) ((q31_t) (*px++) * (*pb++));
+		}
+
+		/* Scale to 1.15 and saturate */
+		acc_l = acc & 0xffffffff;
+		acc_h = (acc >> 32) & 0xffffffff;
+		acc = (uint32_t) acc_l >> lShift | acc_h << uShift;
+		acc = __SSAT(acc, 16);
+
+		*pOut++ = (q15_t) acc;
+		e = *pRef++ - (q15_t) acc;
+		*pErr++ = e;
+
+		/* Update coefficients, w = w +/- u, two taps per instruction */
+		pu = pUpdate;
+		pb = pCoeffs;
+		if (e > 0) {
+			for (tapCnt = numTaps >> 2u; tapCnt > 0u; tapCnt--) {
+				*__SIMD32(pb) = __QADD16(*__SIMD32(pb), *__SIMD32(pu)++);
+				pb += 2;
+				*__SIMD32(pb) = __QADD16(*__SIMD32(pb), *__SIMD32(pu)++);
+				pb += 2;
+			}
+			for (tapCnt = numTaps & 3u; tapCnt > 0u; tapCnt--) {
+				*pb = (q15_t) __SSAT((q31_t) *pb + *pu++, 16);
+				pb++;
+			}
+		} else if (e < 0) {
+			for (tapCnt = numTaps >> 2u; tapCnt > 0u; tapCnt--) {
+				*__SIMD32(pb) = __QSUB16(*__SIMD32(pb), *__SIMD32(pu)++);
+				pb += 2;
+				*__SIMD32(pb) = __QSUB16(*__SIMD32(pb), *__SIMD32(pu)++);
+				pb += 2;
+			}
+			for (tapCnt = numTaps & 3u; tapCnt > 0u; tapCnt--) {
+				*pb = (q15_t) __SSAT((q31_t) *pb - *pu++, 16);
+				pb++;
+			}
+		}
+
+		/* Advance window by one sample */
+		pState++;
+		pUpdate++;
+	}
+
+	/* Copy the last numTaps - 1 samples to the start of both delay lines */
+	/* for the next call (pState/pUpdate point to the oldest kept sample)  */
+	memmove(S->Lms.pState, pState, (numTaps - 1u) * sizeof(q15_t));
+	memmove(S->pUpdate, pUpdate, (numTaps - 1u) * sizeof(q15_t));
+}
+/*****************************************************************************/
+/*  End         : LMSSign_q15                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSSign_skip_q15                                           */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Puts one block into both delay lines without filtering or  */
+/*                adaptation, so the next LMSSign_q15() sees the newest      */
+/*                samples                                                    */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Input (reference) samples [blockSize]           */
+/*                blockSize  Number of samples                               */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC void LMSSign_skip_q15(LMSSignInstanceQ15 *S, q15_t *pSrc,
+		uint32_t blockSize) {
+
+	/* procedure data */
+	uint32_t numTaps = S->Lms.numTaps;
+	q15_t *pStateCurnt = &S->Lms.pState[numTaps - 1u];
+	q15_t *pUpdateCurnt = &S->pUpdate[numTaps - 1u];
+	q15_t x;
+	uint32_t i;
+
+	/* procedure code */
+	for (i = 0; i < blockSize; i++) {
+		x = pSrc[i];
+		pStateCurnt[i] = x;
+		if (S->Mode == LMS_SIGN_ERROR) {
+			pUpdateCurnt[i] = x >> S->MuShift;
+		} else {
+			pUpdateCurnt[i] = (x < 0) ? -S->Delta : S->Delta;
+		}
+	}
+	memmove(S->Lms.pState, &S->Lms.pState[blockSize],
+			(numTaps - 1u) * sizeof(q15_t));
+	memmove(S->pUpdate, &S->pUpdate[blockSize], (numTaps - 1u) * sizeof(q15_t));
+}
+/*****************************************************************************/
+/*  End         : LMSSign_skip_q15                                           */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : LMSSign                                                    */
+/*****************************************************************************/
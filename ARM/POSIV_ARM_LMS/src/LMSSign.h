@@ -0,0 +1,67 @@
+#ifndef LMSSIGN_H
+#define LMSSIGN_H
+/*****************************************************************************/
+/*  Header     : LMSSign                                        Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Multiplierfree sign-error and sign-sign LMS for Q15.        */
+/*               Same filter as arm_lms_q15(), but the coefficient update    */
+/*               is done with packed saturating adds (__QADD16/__QSUB16),    */
+/*               two taps per instruction                                    */
+/*                                                                           */
+/*  Procedures : LMSSign_init_q15()                                          */
+/*               LMSSign_q15()                                               */
+/*               LMSSign_skip_q15()                                          */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSSign.h                                                   */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "config.h"
+#include "arm_math.h"
+
+/* module constant declaration  */
+
+/* Update rules */
+#define LMS_SIGN_ERROR 1   /* w += 2^-MuShift * sign(e) * x      */
+#define LMS_SIGN_SIGN  2   /* w += Delta * sign(e) * sign(x)     */
+
+/* module type declaration      */
+
+/* Instance of a sign LMS filter. Lms holds taps, state and coefficients    */
+/* exactly as for arm_lms_q15(), so both kernels may work on the same data  */
+/* pUpdate is a second delay line (same size as the state buffer) holding   */
+/* the preconditioned update term of each input sample (x >> MuShift or     */
+/* +/-Delta), thus the update loop needs no multiplication at all           */
+typedef struct
+{
+	arm_lms_instance_q15 Lms;
+	q15_t *pUpdate;
+	uint16_t Mode;
+	uint16_t MuShift;
+	q15_t Delta;
+} LMSSignInstanceQ15;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+void LMSSign_init_q15(LMSSignInstanceQ15 *S, uint16_t numTaps, q15_t *pCoeffs,
+		q15_t *pState, q15_t *pUpdate, uint16_t Mode, uint16_t MuShift,
+		q15_t Delta, uint32_t blockSize, uint32_t postShift);
+RAMFUNC void LMSSign_q15(LMSSignInstanceQ15 *S, q15_t *pSrc, q15_t *pRef,
+		q15_t *pOut, q15_t *pErr, uint32_t blockSize);
+RAMFUNC void LMSSign_skip_q15(LMSSignInstanceQ15 *S, q15_t *pSrc,
+		uint32_t blockSize);
+
+/*****************************************************************************/
+/*  End Header  : LMSSign                                                    */
+/*****************************************************************************/
+#endif
@@ -0,0 +1,351 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : LMSSparse                                      Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Post convergence sparse execution of a Q15 LMS.             */
+/*                                                                           */
+/*               A converged echo path (a direct delay plus few reflections) */
+/*               has only few significant coefficients. Once the LMS has     */
+/*               reached LMS_SPARSE_MIN_ERLE, IdleFunction() extracts all    */
+/*               coefficients above a threshold into a tap list and the      */
+/*               echo estimate is computed with arm_fir_sparse_q15() only,   */
+/*               which costs a few dozen instead of FILTER_LENGTH MACs and   */
+/*               no update at all.                                           */
+/*               Full adaptation is resumed (with the unchanged full         */
+/*               coefficient set) when the error power rises by              */
+/*               LMS_SPARSE_ERR_RISE or after LMS_SPARSE_READAPT_BLOCKS.     */
+/*                                                                           */
+/*               The delay line history is handed over between the two       */
+/*               filters on every switch, so no transient is produced.       */
+/*                                                                           */
+/*  Procedures : LMSSparse_init_q15()                                        */
+/*               LMSSparse_q15()                                             */
+/*               LMSSparse_skip_q15()                                        */
+/*               LMSSparse_idle_q15()                                        */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSSparse.c                                                 */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "LMSSparse.h"
+
+/* module constant declaration */
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+static void UpdatePowers(LMSSparseInstanceQ15 *S, q15_t *pRef, q15_t *pErr,
+		uint32_t blockSize);
+
+/*****************************************************************************/
+/*  Procedure   : LMSSparse_init_q15                                         */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Initializes the sparse execution for an already            */
+/*                initialized LMS instance. Starts in full adaptation.       */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S             Instance to initialize                       */
+/*                pLms          Initialized LMS instance                     */
+/*                pSparseState  State of the sparse filter                   */
+/*                              [numTaps - 1 + BLOCK_SIZE]                   */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void LMSSparse_init_q15(LMSSparseInstanceQ15 *S, arm_lms_instance_q15 *pLms,
+		q15_t *pSparseState) {
+
+	/* procedure code */
+	S->pLms = pLms;
+	S->pSparseState = pSparseState;
+	S->Mode = LMS_SPARSE_ADAPT;
+	S->BlockCount = 0;
+	S->DesPower = 0;
+	S->ErrPower = 0;
+	S->ErrPowerConverged = 0;
+}
+/*****************************************************************************/
+/*  End         : LMSSparse_init_q15                                         */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSSparse_q15                                              */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Processes one block, either with the full LMS or with the  */
+/*                sparse filter, and switches between the two.               */
+/*                Arguments are the same as for arm_lms_q15()                */
+/*                (blockSize must not exceed BLOCK_SIZE)                     */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Input (reference) samples [blockSize]           */
+/*                pRef       Desired samples [blockSize]                     */
+/*                blockSize  Number of samples to process                    */
+/*                                                                           */
+/*  Output Para : pOut       Filter output [blockSize]                       */
+/*                pErr       Error (pRef - pOut) [blockSize]                 */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC void LMSSparse_q15(LMSSparseInstanceQ15 *S, q15_t *pSrc, q15_t *pRef,
+		q15_t *pOut, q15_t *pErr, uint32_t blockSize) {
+
+	/* procedure data */
+	uint32_t HistoryLength = S->pLms->numTaps - 1u;
+	uint32_t DelaySize = HistoryLength + blockSize;
+	uint32_t Start;
+	uint32_t First;
+	uint32_t i;
+
+	/* procedure code */
+
+	if (S->Mode == LMS_SPARSE_SPARSE) {
+
+		/* Sparse filter only, no adaptation */
+		arm_fir_sparse_q15(&S->Fir, pSrc, pOut, S->ScratchIn, S->ScratchOut, blockSize);
+		for (i = 0; i < blockSize; i++) {
+			pErr[i] = (q15_t) __SSAT((q31_t) pRef[i] - pOut[i], 16);
+		}
+		UpdatePowers(S, pRef, pErr, blockSize);
+		S->BlockCount++;
+
+		/* Reference is the best error power reached with the sparse filter */
+		if (S->ErrPower < S->ErrPowerConverged) {
+			S->ErrPowerConverged = S->ErrPower;
+		}
+
+		/* Echo path changed or time for a refresh? */
+		if ((S->ErrPower / LMS_SPARSE_ERR_RISE > S->ErrPowerConverged) ||
+				(S->BlockCount >= LMS_SPARSE_READAPT_BLOCKS)) {
+
+			/* Hand the history back to the LMS. The oldest sample in the */
+			/* sparse state is at stateIndex, the LMS needs the newest    */
+			/* numTaps - 1 ones in chronological order                    */
+			Start = S->Fir.stateIndex + blockSize;
+			if (Start >= DelaySize) {
+				Start -= DelaySize;
+			}
+			First = DelaySize - Start;
+			if (First > HistoryLength) {
+				First = HistoryLength;
+			}
+			memcpy(S->pLms->pState, &S->pSparseState[Start], First * sizeof(q15_t));
+			memcpy(&S->pLms->pState[First], S->pSparseState,
+					(HistoryLength - First) * sizeof(q15_t));
+
+			S->BlockCount = 0;
+			S->Mode = LMS_SPARSE_ADAPT;
+		}
+		return;
+	}
+
+	/* Full adaptation */
+	arm_lms_q15(S->pLms, pSrc, pRef, pOut, pErr, blockSize);
+	UpdatePowers(S, pRef, pErr, blockSize);
+	S->BlockCount++;
+
+	if (S->Mode == LMS_SPARSE_READY) {
+
+		/* Tap list is ready, hand the history over to the sparse filter */
+		/* (written as if it had been filtered, next write at index 0)   */
+		memcpy(&S->pSparseState[blockSize], S->pLms->pState,
+				HistoryLength * sizeof(q15_t));
+		S->Fir.stateIndex = 0;
+
+		S->ErrPowerConverged = S->ErrPower;
+		S->BlockCount = 0;
+		S->Mode = LMS_SPARSE_SPARSE;
+
+	} else if ((S->Mode == LMS_SPARSE_ADAPT) &&
+			(S->BlockCount >= LMS_SPARSE_ADAPT_BLOCKS) &&
+			(S->ErrPower < S->DesPower / LMS_SPARSE_MIN_ERLE)) {
+
+		/* Converged, let IdleFunction() extract the taps */
+		S->Mode = LMS_SPARSE_EXTRACT;
+	}
+}
+/*****************************************************************************/
+/*  End         : LMSSparse_q15                                              */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSSparse_skip_q15                                         */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Puts one block into the delay line of the filter in use    */
+/*                without adaptation, so the next LMSSparse_q15() sees the   */
+/*                newest samples. The sparse filter keeps its state only by  */
+/*                filtering (circular buffer), its few taps are run and the  */
+/*                output dropped.                                            */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Input (reference) samples [blockSize]           */
+/*                blockSize  Number of samples                               */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC void LMSSparse_skip_q15(LMSSparseInstanceQ15 *S, q15_t *pSrc,
+		uint32_t blockSize) {
+
+	/* procedure data */
+	uint32_t HistoryLength = S->pLms->numTaps - 1u;
+	q15_t Out[BLOCK_SIZE];
+
+	/* procedure code */
+	if (S->Mode == LMS_SPARSE_SPARSE) {
+		arm_fir_sparse_q15(&S->Fir, pSrc, Out, S->ScratchIn, S->ScratchOut,
+				blockSize);
+		return;
+	}
+	memcpy(&S->pLms->pState[HistoryLength], pSrc, blockSize * sizeof(q15_t));
+	memmove(S->pLms->pState, &S->pLms->pState[blockSize],
+			HistoryLength * sizeof(q15_t));
+}
+/*****************************************************************************/
+/*  End         : LMSSparse_skip_q15                                         */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSSparse_idle_q15                                         */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Is called from IdleFunction(). Builds the tap list out of  */
+/*                the converged coefficients when requested by the           */
+/*                processing, outside of the interrupt.                      */
+/*                The threshold is doubled until at most                     */
+/*                LMS_SPARSE_MAX_TAPS coefficients remain.                   */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void LMSSparse_idle_q15(LMSSparseInstanceQ15 *S) {
+
+	/* procedure data */
+	uint32_t numTaps = S->pLms->numTaps;
+	q15_t *pCoeffs = S->pLms->pCoeffs;
+	q15_t Threshold = LMS_SPARSE_THRESHOLD;
+	uint32_t Count;
+	uint32_t k;
+	q15_t c;
+
+	/* procedure code */
+
+	if (S->Mode != LMS_SPARSE_EXTRACT) {
+		return;
+	}
+
+	/* Coefficients keep adapting meanwhile, the snapshot is good enough */
+	do {
+		Count = 0;
+		for (k = 0; k < numTaps; k++) {
+			c = pCoeffs[k];
+			if ((c >= Threshold) || (c <= -Threshold)) {
+				if (Count < LMS_SPARSE_MAX_TAPS) {
+					/* pCoeffs[0] weights the oldest sample */
+					S->SparseCoeffs[Count] = c;
+					S->TapDelay[Count] = numTaps - 1u - k;
+				}
+				Count++;
+			}
+		}
+		Threshold = (Threshold < 16384) ? 2 * Threshold : 32767;
+	} while ((Count > LMS_SPARSE_MAX_TAPS) && (Threshold < 32767));
+
+	if ((Count == 0) || (Count > LMS_SPARSE_MAX_TAPS)) {
+		/* Nothing sensible to extract, keep adapting */
+		S->BlockCount = 0;
+		S->Mode = LMS_SPARSE_ADAPT;
+		return;
+	}
+
+	arm_fir_sparse_init_q15(&S->Fir, Count, S->SparseCoeffs, S->pSparseState,
+			S->TapDelay, numTaps - 1u, BLOCK_SIZE);
+
+	S->Mode = LMS_SPARSE_READY;
+}
+/*****************************************************************************/
+/*  End         : LMSSparse_idle_q15                                         */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : UpdatePowers                                               */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Recursive (first order) power estimates of desired and     */
+/*                error signal, in Q30                                       */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pRef       Desired samples [blockSize]                     */
+/*                pErr       Error samples [blockSize]                       */
+/*                blockSize  Number of samples                               */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void UpdatePowers(LMSSparseInstanceQ15 *S, q15_t *pRef, q15_t *pErr,
+		uint32_t blockSize) {
+
+	/* procedure data */
+	uint32_t i;
+
+	/* procedure code */
+	for (i = 0; i < blockSize; i++) {
+		/* Kept scaled, (Power - Estimate) >> SHIFT would drop the small */
+		/* steps at converged error levels                               */
+		S->DesPower += (q31_t) pRef[i] * pRef[i] -
+				(S->DesPower >> LMS_SPARSE_POWER_SHIFT);
+		S->ErrPower += (q31_t) pErr[i] * pErr[i] -
+				(S->ErrPower >> LMS_SPARSE_POWER_SHIFT);
+	}
+}
+/*****************************************************************************/
+/*  End         : UpdatePowers                                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : LMSSparse                                                  */
+/*****************************************************************************/
@@ -0,0 +1,95 @@
+#ifndef LMSSPARSE_H
+#define LMSSPARSE_H
+/*****************************************************************************/
+/*  Header     : LMSSparse                                      Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Post convergence sparse execution of a Q15 LMS.             */
+/*               After the LMS has converged, the significant coefficients   */
+/*               are extracted into a tap list and the echo is filtered with */
+/*               arm_fir_sparse_q15() only. Full adaptation is resumed on a  */
+/*               schedule or when the error energy rises.                    */
+/*                                                                           */
+/*  Procedures : LMSSparse_init_q15()                                        */
+/*               LMSSparse_q15()                                             */
+/*               LMSSparse_skip_q15()                                        */
+/*               LMSSparse_idle_q15()                                        */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSSparse.h                                                 */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "config.h"
+#include "arm_math.h"
+
+/* module constant declaration  */
+
+/* Maximum number of taps of the sparse filter */
+#define LMS_SPARSE_MAX_TAPS 64
+
+/* Initial threshold for significant coefficients (Q15, ~0.01), will be  */
+/* doubled until no more than LMS_SPARSE_MAX_TAPS taps remain            */
+#define LMS_SPARSE_THRESHOLD 328
+
+/* Minimum number of blocks to adapt before going sparse (1s) */
+#define LMS_SPARSE_ADAPT_BLOCKS (FS / BLOCK_SIZE)
+
+/* Required error attenuation before going sparse (power ratio, 12dB) */
+#define LMS_SPARSE_MIN_ERLE 16
+
+/* Re-adapt if the error power rises by this factor (6dB) ... */
+#define LMS_SPARSE_ERR_RISE 4
+
+/* ... or at least after this many blocks in sparse mode (10s) */
+#define LMS_SPARSE_READAPT_BLOCKS (10 * FS / BLOCK_SIZE)
+
+/* Time constant of the power estimates, 2^-LMS_SPARSE_POWER_SHIFT */
+#define LMS_SPARSE_POWER_SHIFT 8
+
+/* States */
+#define LMS_SPARSE_ADAPT   0   /* Full LMS                                */
+#define LMS_SPARSE_EXTRACT 1   /* Full LMS, IdleFunction extracts taps    */
+#define LMS_SPARSE_READY   2   /* Full LMS, tap list ready for switching  */
+#define LMS_SPARSE_SPARSE  3   /* Sparse filter, no adaptation            */
+
+/* module type declaration      */
+
+typedef struct
+{
+	arm_lms_instance_q15 *pLms;
+	arm_fir_sparse_instance_q15 Fir;
+	q15_t *pSparseState;
+	q15_t SparseCoeffs[LMS_SPARSE_MAX_TAPS];
+	int32_t TapDelay[LMS_SPARSE_MAX_TAPS];
+	q15_t ScratchIn[BLOCK_SIZE];
+	q31_t ScratchOut[BLOCK_SIZE];
+	volatile uint16_t Mode;
+	uint32_t BlockCount;
+	q63_t DesPower;            /* Q30, scaled by 2^LMS_SPARSE_POWER_SHIFT */
+	q63_t ErrPower;
+	q63_t ErrPowerConverged;
+} LMSSparseInstanceQ15;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+void LMSSparse_init_q15(LMSSparseInstanceQ15 *S, arm_lms_instance_q15 *pLms,
+		q15_t *pSparseState);
+RAMFUNC void LMSSparse_q15(LMSSparseInstanceQ15 *S, q15_t *pSrc, q15_t *pRef,
+		q15_t *pOut, q15_t *pErr, uint32_t blockSize);
+RAMFUNC void LMSSparse_skip_q15(LMSSparseInstanceQ15 *S, q15_t *pSrc,
+		uint32_t blockSize);
+void LMSSparse_idle_q15(LMSSparseInstanceQ15 *S);
+
+/*****************************************************************************/
+/*  End Header  : LMSSparse                                                  */
+/*****************************************************************************/
+#endif
@@ -0,0 +1,201 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : LMSStep                                        Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Variable step size controller, shared by all Q15 LMS        */
+/*               variants (full LMS, sparse, hybrid and sign-error).         */
+/*                                                                           */
+/*               Recursive power estimates of reference, microphone and      */
+/*               error signal are updated for every sample. Every            */
+/*               LMS_STEP_INTERVAL samples the step is recomputed:           */
+/*                                                                           */
+/*                 MuNorm = MU_MAX * min(1, GAIN * Perr / Pdes), >= MU_MIN   */
+/*                 Mu     = MuNorm / (numTaps * Pref)                        */
+/*                                                                           */
+/*               The first line is a Kwong-Johnston type control on the      */
+/*               error power, relative to the microphone power so it does    */
+/*               not depend on the signal level: full steps until the ERLE   */
+/*               reaches GAIN, then steps shrinking with the remaining       */
+/*               error for a low misadjustment. When the echo path changes,  */
+/*               the error and thus the step rise again by themselves.       */
+/*               The second line is the NLMS normalization, so the same      */
+/*               limits fit any filter length. Pref follows rising input     */
+/*               power fast, so the step is never too large at the onset of  */
+/*               far end speech. While the far end is silent, Mu becomes 0   */
+/*               (no adaptation), else it is at least 1 so a loud reference  */
+/*               does not stop the adaptation.                               */
+/*                                                                           */
+/*               The estimates are kept scaled by 2^LMS_STEP_POWER_SHIFT in  */
+/*               64 bit, so the small steps of the recursions at converged   */
+/*               error levels are not truncated away.                        */
+/*                                                                           */
+/*               Like any error driven control, near end speech raises the   */
+/*               step as well; freezing the adaptation then is the job of a  */
+/*               double talk detector.                                       */
+/*                                                                           */
+/*               The sign-error update x * sign(e) corresponds to an LMS     */
+/*               update with Mu * |e|, so its step is MuShift with           */
+/*               2^-MuShift <= Mu * rms(e).                                  */
+/*                                                                           */
+/*  Procedures : LMSStep_init_q15()                                          */
+/*               LMSStep_q15()                                               */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSStep.c                                                   */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "LMSStep.h"
+
+/* module constant declaration */
+
+/* Scaled estimate: S += Power - S / 2^LMS_STEP_POWER_SHIFT */
+#define STEP_UPDATE(S, Power) ((S) += (q63_t) (Power) - ((S) >> LMS_STEP_POWER_SHIFT))
+
+#if LMS_STEP_ATTACK_SHIFT > LMS_STEP_POWER_SHIFT
+#error "LMS_STEP_ATTACK_SHIFT must not be longer than LMS_STEP_POWER_SHIFT"
+#endif
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+
+/*****************************************************************************/
+/*  Procedure   : LMSStep_init_q15                                           */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Initializes the controller, starts with the largest step   */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance to initialize                          */
+/*                numTaps    Length of the controlled filter                 */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void LMSStep_init_q15(LMSStepInstanceQ15 *S, uint32_t numTaps) {
+
+	/* procedure code */
+	S->numTaps = numTaps;
+	S->RefPower = 0;
+	S->DesPower = 0;
+	S->ErrPower = 0;
+	S->Count = 0;
+	S->MuNorm = LMS_STEP_MU_MAX;
+	S->Mu = 0;
+	S->MuShift = 15;
+}
+/*****************************************************************************/
+/*  End         : LMSStep_init_q15                                           */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : LMSStep_q15                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Updates the power estimates with one block and returns the */
+/*                step for the next block. Is called after the LMS.          */
+/*                S->MuShift is updated as well, for the sign-error LMS.     */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Input (reference) samples [blockSize]           */
+/*                pRef       Desired samples [blockSize]                     */
+/*                pErr       Error samples [blockSize]                       */
+/*                blockSize  Number of samples                               */
+/*                                                                           */
+/*  Output Para : Return     Step size (Q15) for arm_lms_q15()               */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC q15_t LMSStep_q15(LMSStepInstanceQ15 *S, q15_t *pSrc, q15_t *pRef,
+		q15_t *pErr, uint32_t blockSize) {
+
+	/* procedure data */
+	q63_t Norm;
+	q63_t Mu;
+	q31_t MuNorm;
+	q31_t Rms;
+	q31_t Power;
+	q63_t Scaled;
+	uint32_t i;
+
+	/* procedure code */
+	for (i = 0; i < blockSize; i++) {
+
+		/* Fast attack, an underestimated input power (onset of far end */
+		/* speech) would give a too large step                          */
+		Power = (q31_t) pSrc[i] * pSrc[i];
+		Scaled = (q63_t) Power << LMS_STEP_POWER_SHIFT;
+		if (Scaled > S->RefPower) {
+			S->RefPower += (Scaled - S->RefPower) >> LMS_STEP_ATTACK_SHIFT;
+		} else {
+			STEP_UPDATE(S->RefPower, Power);
+		}
+		STEP_UPDATE(S->DesPower, (q31_t) pRef[i] * pRef[i]);
+		STEP_UPDATE(S->ErrPower, (q31_t) pErr[i] * pErr[i]);
+	}
+
+	S->Count += blockSize;
+	if (S->Count < LMS_STEP_INTERVAL) {
+		return S->Mu;
+	}
+	S->Count = 0;
+
+	/* Normalized step from the error to microphone power ratio (the */
+	/* product stays below 2^42 * 2^15 in this branch)               */
+	if (S->ErrPower * LMS_STEP_GAIN >= S->DesPower) {
+		MuNorm = LMS_STEP_MU_MAX;
+	} else {
+		MuNorm = (q31_t) ((S->ErrPower * LMS_STEP_GAIN * LMS_STEP_MU_MAX) /
+				S->DesPower);
+		if (MuNorm < LMS_STEP_MU_MIN) {
+			MuNorm = LMS_STEP_MU_MIN;
+		}
+	}
+	S->MuNorm = (q15_t) MuNorm;
+
+	/* Normalization to the input power of the whole filter (Q30, scaled) */
+	Norm = (q63_t) S->numTaps * S->RefPower;
+	if (Norm == 0) {
+		S->Mu = 0;
+	} else {
+		Mu = ((q63_t) MuNorm << (30 + LMS_STEP_POWER_SHIFT)) / Norm;
+		S->Mu = (q15_t) ((Mu > 32767) ? 32767 : ((Mu < 1) ? 1 : Mu));
+	}
+
+	/* Step of the sign-error LMS, Mu * rms(e) rounded down to 2^-MuShift */
+	Scaled = S->ErrPower >> (LMS_STEP_POWER_SHIFT - 1);
+	arm_sqrt_q31((Scaled > 0x7FFFFFFF) ? 0x7FFFFFFF : (q31_t) Scaled, &Rms);
+	Mu = ((q63_t) S->Mu * (Rms >> 16)) >> 15;
+	S->MuShift = (Mu > 0) ? (uint16_t) (__CLZ((uint32_t) Mu) - 16u) : 15;
+
+	return S->Mu;
+}
+/*****************************************************************************/
+/*  End         : LMSStep_q15                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : LMSStep                                                    */
+/*****************************************************************************/
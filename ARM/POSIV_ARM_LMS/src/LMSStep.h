@@ -0,0 +1,73 @@
+#ifndef LMSSTEP_H
+#define LMSSTEP_H
+/*****************************************************************************/
+/*  Header     : LMSStep                                        Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Variable step size controller for the Q15 LMS variants      */
+/*               (Kwong-Johnston type, NLMS normalized). Large steps while   */
+/*               the error is large compared to the microphone signal,       */
+/*               small ones in steady state                                  */
+/*                                                                           */
+/*  Procedures : LMSStep_init_q15()                                          */
+/*               LMSStep_q15()                                               */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : LMSStep.h                                                   */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "config.h"
+#include "arm_math.h"
+
+/* module constant declaration  */
+
+/* Normalized step size limits (Q15), the normalized step of an NLMS */
+/* must stay below 2 for stability, 1 converges fastest             */
+#define LMS_STEP_MU_MAX 32767
+#define LMS_STEP_MU_MIN 328
+
+/* Time constant of the power estimates, 2^-LMS_STEP_POWER_SHIFT (0.5s) */
+#define LMS_STEP_POWER_SHIFT 12
+
+/* Time constant of the reference power for rising power (4ms) */
+#define LMS_STEP_ATTACK_SHIFT 5
+
+/* Full step until the ERLE reaches LMS_STEP_GAIN (power ratio, 18dB) */
+#define LMS_STEP_GAIN 64
+
+/* The step is recomputed every LMS_STEP_INTERVAL samples (2ms) */
+#define LMS_STEP_INTERVAL 16
+
+/* module type declaration      */
+
+typedef struct
+{
+	uint32_t numTaps;
+	q63_t RefPower;   /* Q30, scaled by 2^LMS_STEP_POWER_SHIFT */
+	q63_t DesPower;   /* Q30, scaled by 2^LMS_STEP_POWER_SHIFT */
+	q63_t ErrPower;   /* Q30, scaled by 2^LMS_STEP_POWER_SHIFT */
+	uint32_t Count;
+	q15_t MuNorm;     /* Normalized step (Q15)                */
+	q15_t Mu;         /* Step for arm_lms_q15() (Q15)         */
+	uint16_t MuShift; /* Step for LMSSign_q15(), sign-error   */
+} LMSStepInstanceQ15;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+void LMSStep_init_q15(LMSStepInstanceQ15 *S, uint32_t numTaps);
+RAMFUNC q15_t LMSStep_q15(LMSStepInstanceQ15 *S, q15_t *pSrc, q15_t *pRef,
+		q15_t *pErr, uint32_t blockSize);
+
+/*****************************************************************************/
+/*  End Header  : LMSStep                                                    */
+/*****************************************************************************/
+#endif
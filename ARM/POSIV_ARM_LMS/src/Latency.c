@@ -0,0 +1,220 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : Latency                                        Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Measures the latency from an output back to an input, for   */
+/*               a cable from that output to that input.                     */
+/*                                                                           */
+/*               Every LATENCY_INTERVAL samples a pseudo random marker       */
+/*               replaces the output, silence in between. From the first     */
+/*               marker sample on, LATENCY_WINDOW input samples are          */
+/*               recorded. The idle loop correlates the record with the      */
+/*               marker (arm_correlate_fast_q15()), the lag of the largest   */
+/*               magnitude is the latency: DMA double buffering, block size, */
+/*               DAC and ADC. An inverting loopback is found as well.        */
+/*                                                                           */
+/*               The matched filter is the marker scaled down so the 32 bit  */
+/*               accumulator of the fast correlation cannot overflow.        */
+/*                                                                           */
+/*  Procedures : Latency_init()                                              */
+/*               Latency_q15()                                               */
+/*               Latency_idle()                                              */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : Latency.c                                                   */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "Latency.h"
+#include <string.h>
+
+/* module constant declaration */
+
+/* Matched filter amplitude: 32768 * LATENCY_REFERENCE * LATENCY_MARKER_LENGTH */
+/* stays below 2^31                                                            */
+#define LATENCY_REFERENCE 512
+
+#if LATENCY_REFERENCE * LATENCY_MARKER_LENGTH > 32768
+#error "LATENCY_REFERENCE too large for LATENCY_MARKER_LENGTH"
+#endif
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+
+/*****************************************************************************/
+/*  Procedure   : Latency_init                                               */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Builds the marker and clears the report                    */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance to initialize                          */
+/*                                                                           */
+/*  Output Para : pReport    Cleared report                                  */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void Latency_init(LatencyInstance *S, LatencyReport *pReport) {
+
+	/* procedure data */
+	uint16_t Lfsr = 0xACE1u;
+	uint16_t Bit;
+	uint32_t i;
+
+	/* procedure code */
+	memset(S, 0, sizeof(*S));
+	memset(pReport, 0, sizeof(*pReport));
+	pReport->SamplesMin = UINT32_MAX;
+
+	/* Maximum length sequence, x^16 + x^14 + x^13 + x^11 + 1 */
+	for (i = 0; i < LATENCY_MARKER_LENGTH; i++) {
+		Bit = (uint16_t) ((Lfsr ^ (Lfsr >> 2) ^ (Lfsr >> 3) ^ (Lfsr >> 5)) & 1u);
+		Lfsr = (uint16_t) ((Lfsr >> 1) | (Bit << 15));
+		S->Marker[i] = Bit ? LATENCY_AMPLITUDE : -LATENCY_AMPLITUDE;
+		S->Reference[i] = Bit ? LATENCY_REFERENCE : -LATENCY_REFERENCE;
+	}
+}
+/*****************************************************************************/
+/*  End         : Latency_init                                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Latency_q15                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Replaces one block of the output with the marker or        */
+/*                silence and records the looped back input                  */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pIn        Looped back input [blockSize]                   */
+/*                blockSize  Number of samples                               */
+/*                                                                           */
+/*  Output Para : pOut       Output to loop back [blockSize]                 */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC void Latency_q15(LatencyInstance *S, q15_t *pIn, q15_t *pOut,
+		uint32_t blockSize) {
+
+	/* procedure data */
+	uint32_t Position = S->Position;
+	uint32_t i;
+
+	/* procedure code */
+	for (i = 0; i < blockSize; i++) {
+
+		/* A new record only when the last one is evaluated */
+		if ((Position == 0) && !S->Full) {
+			S->Recording = 1;
+		}
+
+		pOut[i] = (Position < LATENCY_MARKER_LENGTH) ? S->Marker[Position] : 0;
+		if (S->Recording) {
+			S->Record[Position] = pIn[i];
+			if (Position == LATENCY_WINDOW - 1u) {
+				S->Recording = 0;
+				S->Full = 1;
+			}
+		}
+
+		if (++Position >= LATENCY_INTERVAL) {
+			Position = 0;
+		}
+	}
+	S->Position = Position;
+}
+/*****************************************************************************/
+/*  End         : Latency_q15                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Latency_idle                                               */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Evaluates a complete record, call from the idle loop       */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                                                                           */
+/*  Output Para : pReport    Updated with a found marker                     */
+/*                Return     1 if a marker was found                         */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+uint8_t Latency_idle(LatencyInstance *S, LatencyReport *pReport) {
+
+	/* procedure data */
+	q15_t *pLag = &S->Correlation[LATENCY_WINDOW - 1u];
+	uint32_t Count = LATENCY_WINDOW - LATENCY_MARKER_LENGTH + 1u;
+	uint32_t Sum = 0;
+	uint32_t Peak = 0;
+	uint32_t Lag = 0;
+	uint32_t Value;
+	uint32_t i;
+
+	/* procedure code */
+	if (!S->Full) {
+		return 0;
+	}
+	arm_correlate_fast_q15(S->Record, LATENCY_WINDOW, S->Reference,
+			LATENCY_MARKER_LENGTH, S->Correlation);
+	S->Full = 0;
+
+	/* Lag 0 is in the middle, the marker can only come back later */
+	for (i = 0; i < Count; i++) {
+		Value = (uint32_t) ((pLag[i] < 0) ? -pLag[i] : pLag[i]);
+		Sum += Value;
+		if (Value > Peak) {
+			Peak = Value;
+			Lag = i;
+		}
+	}
+
+	pReport->Ratio = (Sum != 0) ? (float32_t) Peak * Count / Sum : 0.0f;
+	if (pReport->Ratio < LATENCY_PEAK_RATIO) {
+		pReport->Failures++;
+		return 0;
+	}
+	pReport->Samples = Lag;
+	pReport->Microseconds = (float32_t) Lag * 1000000.0f / FS;
+	if (Lag < pReport->SamplesMin) {
+		pReport->SamplesMin = Lag;
+	}
+	if (Lag > pReport->SamplesMax) {
+		pReport->SamplesMax = Lag;
+	}
+	pReport->Measurements++;
+	return 1;
+}
+/*****************************************************************************/
+/*  End         : Latency_idle                                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : Latency                                                    */
+/*****************************************************************************/
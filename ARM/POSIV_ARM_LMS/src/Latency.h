@@ -0,0 +1,92 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+/*****************************************************************************/
+/*  Header     : Latency                                        Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : End to end latency measurement: a marker sent on one        */
+/*               output is found again on a looped back input with a         */
+/*               matched filter                                              */
+/*                                                                           */
+/*  Procedures : Latency_init()                                              */
+/*               Latency_q15()                                               */
+/*               Latency_idle()                                              */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : Latency.h                                                   */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "config.h"
+#include "arm_math.h"
+
+/* module constant declaration  */
+
+/* Marker: pseudo random sequence of LATENCY_MARKER_LENGTH samples */
+/* with the amplitude LATENCY_AMPLITUDE (-12dBFS)                  */
+#define LATENCY_MARKER_LENGTH 64
+#define LATENCY_AMPLITUDE 8192
+
+/* Input samples recorded from the start of the marker, the longest */
+/* latency found is LATENCY_WINDOW - LATENCY_MARKER_LENGTH          */
+#define LATENCY_WINDOW 1024
+
+/* Samples from one marker to the next (0.5s) */
+#define LATENCY_INTERVAL (FS / 2)
+
+/* Correlation peak over its mean magnitude needed for a valid result */
+#define LATENCY_PEAK_RATIO 8
+
+#if LATENCY_WINDOW < 2 * BLOCK_SIZE + 2 * LATENCY_MARKER_LENGTH
+#error "LATENCY_WINDOW is too short for the buffering of BLOCK_SIZE"
+#endif
+
+#if LATENCY_INTERVAL < LATENCY_WINDOW
+#error "LATENCY_INTERVAL must be at least LATENCY_WINDOW"
+#endif
+
+/* module type declaration      */
+
+/* Results (watch them with the debugger) */
+typedef struct
+{
+	uint32_t Samples;          /* Latency of the last marker [samples]    */
+	float32_t Microseconds;    /* Same at FS                              */
+	uint32_t SamplesMin;       /* Range over all valid markers            */
+	uint32_t SamplesMax;
+	float32_t Ratio;           /* Peak over mean of the last correlation  */
+	uint32_t Measurements;     /* Markers found                           */
+	uint32_t Failures;         /* Markers not found (no loopback?)        */
+} LatencyReport;
+
+/* Instance */
+typedef struct
+{
+	q15_t Marker[LATENCY_MARKER_LENGTH];    /* Sent                       */
+	q15_t Reference[LATENCY_MARKER_LENGTH]; /* Matched filter, scaled     */
+	q15_t Record[LATENCY_WINDOW];           /* Looped back input          */
+	q15_t Correlation[2 * LATENCY_WINDOW - 1];
+	uint32_t Position;         /* Sample within LATENCY_INTERVAL          */
+	uint8_t Recording;         /* Record of this marker running           */
+	volatile uint8_t Full;     /* Record complete, for Latency_idle()     */
+} LatencyInstance;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+void Latency_init(LatencyInstance *S, LatencyReport *pReport);
+RAMFUNC void Latency_q15(LatencyInstance *S, q15_t *pIn, q15_t *pOut,
+		uint32_t blockSize);
+uint8_t Latency_idle(LatencyInstance *S, LatencyReport *pReport);
+
+/*****************************************************************************/
+/*  End Header  : Latency                                                    */
+/*****************************************************************************/
+#endif
@@ -0,0 +1,294 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : ProcessorRegistry                              Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Selects one of several signal processors at runtime.        */
+/*                                                                           */
+/*               The processors are entries of a constant table (name and    */
+/*               function pointers), all linked into the image. Two memory   */
+/*               slots hold the active processor and the one switched to.    */
+/*                                                                           */
+/*               A switch is requested from the idle loop: the new           */
+/*               processor is built in the free slot there, so the           */
+/*               interrupt never waits for an init. For the next             */
+/*               PROCESSOR_FADE_LENGTH samples both processors run on the    */
+/*               same input and the output fades linearly from the old to    */
+/*               the new one, then the old slot is free again.               */
+/*                                                                           */
+/*               A rebuild of the active processor (other settings, same     */
+/*               entry) is not faded: the new slot takes over at the next    */
+/*               block boundary, so only one processor runs per block.       */
+/*                                                                           */
+/*               The interrupt only uses the active slot while no fade or    */
+/*               swap is pending, and the idle loop only writes the free     */
+/*               slot while none is pending, so no lock is needed.           */
+/*                                                                           */
+/*  Procedures : ProcessorRegistry_init()                                    */
+/*               ProcessorRegistry_select()                                  */
+/*               ProcessorRegistry_rebuild()                                 */
+/*               ProcessorRegistry_q15()                                     */
+/*               ProcessorRegistry_idle()                                    */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : ProcessorRegistry.c                                         */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "ProcessorRegistry.h"
+
+/* module constant declaration */
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+
+/*****************************************************************************/
+/*  Procedure   : ProcessorRegistry_init                                     */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Initializes the registry and builds the first processor    */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Registry to initialize                          */
+/*                pEntries   Table of the processors                         */
+/*                numEntries Number of entries                               */
+/*                pSlotA     Memory for one processor (largest of the table) */
+/*                pSlotB     Memory for one processor (largest of the table) */
+/*                First      Entry active after init                         */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void ProcessorRegistry_init(ProcessorRegistryInstance *S,
+		const ProcessorEntry *pEntries, uint16_t numEntries, void *pSlotA,
+		void *pSlotB, uint16_t First) {
+
+	/* procedure code */
+	S->pEntries = pEntries;
+	S->numEntries = numEntries;
+	S->pSlot[0] = pSlotA;
+	S->pSlot[1] = pSlotB;
+	S->Active = 0;
+	S->Current = First;
+	S->Next = First;
+	S->Fade = 0;
+	S->Swap = 0;
+
+	pEntries[First].Init(pSlotA, pEntries[First].Param);
+}
+/*****************************************************************************/
+/*  End         : ProcessorRegistry_init                                     */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : ProcessorRegistry_select                                   */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Builds the processor Index in the free slot and starts     */
+/*                the crossfade to it. Call from the idle loop only.         */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Registry                                        */
+/*                Index      Entry to switch to                              */
+/*                                                                           */
+/*  Output Para : Return     1 if the switch was started, 0 if Index is      */
+/*                           invalid or already active, or a fade or swap is */
+/*                           still pending                                   */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+uint8_t ProcessorRegistry_select(ProcessorRegistryInstance *S, uint16_t Index) {
+
+	/* procedure data */
+	void *pFree;
+
+	/* procedure code */
+	if ((Index >= S->numEntries) || (Index == S->Current) || (S->Fade != 0) ||
+			S->Swap) {
+		return 0;
+	}
+
+	pFree = S->pSlot[1u - S->Active];
+	S->pEntries[Index].Init(pFree, S->pEntries[Index].Param);
+
+	/* Hand over to the interrupt, Fade last */
+	S->Next = Index;
+	S->Fade = PROCESSOR_FADE_LENGTH;
+	return 1;
+}
+/*****************************************************************************/
+/*  End         : ProcessorRegistry_select                                   */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : ProcessorRegistry_rebuild                                  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Builds the active processor again in the free slot (with   */
+/*                its current settings), to change a setting only read by    */
+/*                Init. The interrupt swaps to it at the next block boundary */
+/*                without a crossfade, the new processor takes over the      */
+/*                state of the old one in its first Process call (the old    */
+/*                slot is not run any more by then). Call from the idle loop */
+/*                only, Init may read the active slot.                       */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Registry                                        */
+/*                                                                           */
+/*  Output Para : Return     1 if the swap was started, 0 if a fade or swap  */
+/*                           is still pending                                */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+uint8_t ProcessorRegistry_rebuild(ProcessorRegistryInstance *S) {
+
+	/* procedure data */
+	uint16_t Index = S->Current;
+	void *pFree;
+
+	/* procedure code */
+	if ((S->Fade != 0) || S->Swap) {
+		return 0;
+	}
+
+	pFree = S->pSlot[1u - S->Active];
+	S->pEntries[Index].Init(pFree, S->pEntries[Index].Param);
+
+	/* Hand over to the interrupt */
+	S->Swap = 1;
+	return 1;
+}
+/*****************************************************************************/
+/*  End         : ProcessorRegistry_rebuild                                  */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : ProcessorRegistry_q15                                      */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Runs the active processor on one block, during a switch    */
+/*                both and crossfades their outputs. A rebuilt processor     */
+/*                becomes active before the block.                           */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Registry                                        */
+/*                pSrc       Far end (reference) samples [blockSize]         */
+/*                pMic       Microphone samples [blockSize]                  */
+/*                blockSize  Number of samples (at most BLOCK_SIZE)          */
+/*                                                                           */
+/*  Output Para : pOut       Output samples [blockSize]                      */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC void ProcessorRegistry_q15(ProcessorRegistryInstance *S, q15_t *pSrc,
+		q15_t *pMic, q15_t *pOut, uint32_t blockSize) {
+
+	/* procedure data */
+	const ProcessorEntry *pOld = &S->pEntries[S->Current];
+	const ProcessorEntry *pNew;
+	q15_t NewOut[BLOCK_SIZE];
+	uint32_t Fade = S->Fade;
+	q31_t Gain;
+	uint32_t i;
+
+	/* procedure code */
+	if (S->Swap) {
+		S->Active = (uint8_t) (1u - S->Active);
+		S->Swap = 0;
+	}
+	pOld->Process(S->pSlot[S->Active], pSrc, pMic, pOut, blockSize);
+	if (Fade == 0) {
+		return;
+	}
+
+	pNew = &S->pEntries[S->Next];
+	pNew->Process(S->pSlot[1u - S->Active], pSrc, pMic, NewOut, blockSize);
+
+	/* Linear fade, gain of the new output rises to 1 */
+	for (i = 0; i < blockSize; i++) {
+		if (Fade > 0) {
+			Fade--;
+		}
+		Gain = (q31_t) (((PROCESSOR_FADE_LENGTH - Fade) << 15) / PROCESSOR_FADE_LENGTH);
+		pOut[i] = (q15_t) ((pOut[i] * (32768 - Gain) + NewOut[i] * Gain) >> 15);
+	}
+
+	if (Fade == 0) {
+		S->Active = (uint8_t) (1u - S->Active);
+		S->Current = S->Next;
+	}
+	S->Fade = (uint16_t) Fade;
+}
+/*****************************************************************************/
+/*  End         : ProcessorRegistry_q15                                      */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : ProcessorRegistry_idle                                     */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Background work of the active processor, call from the     */
+/*                idle loop                                                  */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Registry                                        */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void ProcessorRegistry_idle(ProcessorRegistryInstance *S) {
+
+	/* procedure data */
+	const ProcessorEntry *pEntry;
+
+	/* procedure code */
+
+	/* Not during a fade or before a swap, the interrupt swaps the slots */
+	if ((S->Fade != 0) || S->Swap) {
+		return;
+	}
+	pEntry = &S->pEntries[S->Current];
+	if (pEntry->Idle != 0) {
+		pEntry->Idle(S->pSlot[S->Active]);
+	}
+}
+/*****************************************************************************/
+/*  End         : ProcessorRegistry_idle                                     */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : ProcessorRegistry                                          */
+/*****************************************************************************/
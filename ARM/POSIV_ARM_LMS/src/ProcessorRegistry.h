@@ -0,0 +1,83 @@
+#ifndef PROCESSORREGISTRY_H
+#define PROCESSORREGISTRY_H
+/*****************************************************************************/
+/*  Header     : ProcessorRegistry                              Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Table of signal processors linked into one image, one of    */
+/*               them active, switched at runtime with a crossfade           */
+/*                                                                           */
+/*  Procedures : ProcessorRegistry_init()                                    */
+/*               ProcessorRegistry_select()                                  */
+/*               ProcessorRegistry_rebuild()                                 */
+/*               ProcessorRegistry_q15()                                     */
+/*               ProcessorRegistry_idle()                                    */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : ProcessorRegistry.h                                         */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "config.h"
+#include "arm_math.h"
+
+/* module constant declaration  */
+
+/* Length of the crossfade between two processors in samples */
+/* (64 = 8ms at 8kHz, at least BLOCK_SIZE)                   */
+#define PROCESSOR_FADE_LENGTH 64
+
+#if PROCESSOR_FADE_LENGTH < BLOCK_SIZE
+#error "PROCESSOR_FADE_LENGTH must be at least BLOCK_SIZE"
+#endif
+
+/* module type declaration      */
+
+/* One processor. Init builds the processor in the memory of a slot,   */
+/* Process and Idle run it from there (Idle may be 0 if not needed)    */
+typedef struct
+{
+	const char *pName;
+	void (*Init)(void *pSlot, uint32_t Param);
+	void (*Process)(void *pSlot, q15_t *pSrc, q15_t *pMic, q15_t *pOut,
+			uint32_t blockSize);
+	void (*Idle)(void *pSlot);
+	uint32_t Param;
+} ProcessorEntry;
+
+/* Registry, only to be accessed through the procedures below */
+typedef struct
+{
+	const ProcessorEntry *pEntries;
+	uint16_t numEntries;
+	void *pSlot[2];               /* Memory of the active and the next one */
+	volatile uint8_t Active;      /* Slot of the active processor          */
+	volatile uint16_t Current;    /* Entry of the active processor         */
+	volatile uint16_t Next;       /* Entry faded in                        */
+	volatile uint16_t Fade;       /* Samples of the crossfade left         */
+	volatile uint8_t Swap;        /* Rebuilt slot active with next block   */
+} ProcessorRegistryInstance;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+void ProcessorRegistry_init(ProcessorRegistryInstance *S,
+		const ProcessorEntry *pEntries, uint16_t numEntries, void *pSlotA,
+		void *pSlotB, uint16_t First);
+uint8_t ProcessorRegistry_select(ProcessorRegistryInstance *S, uint16_t Index);
+uint8_t ProcessorRegistry_rebuild(ProcessorRegistryInstance *S);
+RAMFUNC void ProcessorRegistry_q15(ProcessorRegistryInstance *S, q15_t *pSrc,
+		q15_t *pMic, q15_t *pOut, uint32_t blockSize);
+void ProcessorRegistry_idle(ProcessorRegistryInstance *S);
+
+/*****************************************************************************/
+/*  End Header  : ProcessorRegistry                                          */
+/*****************************************************************************/
+#endif
@@ -34,13 +34,26 @@
 
 /* module data declaration      */
 
+/* CPU cycles of the last and of the longest ProcessBlock() call, */
+/* conversion of the samples included (DSPMain.c)                 */
+extern volatile uint32_t ProcessCycles;
+extern volatile uint32_t ProcessCyclesMax;
+
 /* module procedure declaration */
 void InitProcessing(void);
 void IdleFunction(void);
+#if IO_Q15
+#if NUMBER_OF_CHANNELS == 2
+RAMFUNC void ProcessBlock(q15_t *Channel1_in, q15_t *Channel2_in, q15_t *Channel1_out, q15_t *Channel2_out);
+#else
+RAMFUNC void ProcessBlock(q15_t *Channel1_in, q15_t *Channel1_out);
+#endif
+#else
 #if NUMBER_OF_CHANNELS == 2
-void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel2_in, uint16_t *Channel1_out, uint16_t *Channel2_out);
+RAMFUNC void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel2_in, uint16_t *Channel1_out, uint16_t *Channel2_out);
 #else
-void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel1_out);
+RAMFUNC void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel1_out);
+#endif
 #endif
 
 /*****************************************************************************/
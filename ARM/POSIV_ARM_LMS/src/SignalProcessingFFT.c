@@ -39,6 +39,10 @@
 
 /* module constant declaration */
 
+#if IO_Q15
+#error "SignalProcessingFFT.c expects unsigned ADC/DAC samples (IO_Q15 0)"
+#endif
+
 /* Select the number format */
 //#define MAKEFFT_FLOAT
 #define MAKEFFT_Q31
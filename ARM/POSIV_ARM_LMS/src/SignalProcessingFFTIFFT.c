@@ -38,6 +38,10 @@
 
 /* module constant declaration */
 
+#if IO_Q15
+#error "SignalProcessingFFTIFFT.c expects unsigned ADC/DAC samples (IO_Q15 0)"
+#endif
+
 /* Select the number format */
 //#define MAKEFFT_FLOAT
 #define MAKEFFT_Q31
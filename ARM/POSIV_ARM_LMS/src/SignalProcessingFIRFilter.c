@@ -32,6 +32,10 @@
 
 /* module constant declaration */
 
+#if IO_Q15
+#error "SignalProcessingFIRFilter.c expects unsigned ADC/DAC samples (IO_Q15 0)"
+#endif
+
 /* Select the number format */
 //#define MAKEFIR_FLOAT
 #define MAKEFIR_Q31
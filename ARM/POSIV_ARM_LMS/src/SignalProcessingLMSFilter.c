@@ -28,10 +28,21 @@
 /* imports */
 #include "SignalProcessing.h"
 #include "stm32f4_discovery.h"
+#include "EchoCancellerFormat.h"
+#include "ProcessorRegistry.h"
+#include "Arena.h"
+#include "CoeffStore.h"
+#include "Deadline.h"
+#include "Latency.h"
+#include "Vad.h"
 #include <math.h>
 
 /* module constant declaration */
 
+#if !IO_Q15
+#error "SignalProcessingLMSFilter.c expects Q15 samples (IO_Q15 1)"
+#endif
+
 /* Select the number format */
 //#define MAKEFIR_FLOAT
 //#define MAKEFIR_Q31
@@ -135,24 +146,180 @@ q31_t CoeffsQ31[FILTER_LENGTH] =
 
 #elif defined(MAKEFIR_Q15)
 
-/* Buffers for q15 variant */
-q15_t OutBufferQ15[BLOCK_SIZE];
-q15_t xQ15[BLOCK_SIZE];
-q15_t yQ15[BLOCK_SIZE];
+#if LMS_HYBRID
+/* Early reflections only, the tail is modelled by LMSHybrid */
+#define FILTER_LENGTH 512
+#else
+#define FILTER_LENGTH 1700
+#endif
+#define MU 1
 
+/* Processor after reset (index into Processors[]) */
+#define PROCESSOR_FIRST 3
+
+/* Coefficient snapshots for a warm start: long term ERLE [dB] for a  */
+/* converged filter, runtime [s] before the first and between further */
+/* snapshots                                                          */
+#define WARM_START_ERLE 15.0f
+#define WARM_START_FIRST 60.0f
+#define WARM_START_INTERVAL 600.0f
+
+/* Snapshot of a canceller (CancellerSlot.Snapshot): requested by the idle */
+/* loop, copied at the start of a block, the block after it (with the     */
+/* cycles of the copy) is not measured, then it is stored                 */
+#define SNAPSHOT_NONE 0
+#define SNAPSHOT_REQUESTED 1
+#define SNAPSHOT_COPIED 2
+#define SNAPSHOT_READY 3
+
+/* Complexity governor: sizes the filter of the active canceller to the */
+/* measured cycles, once per GOVERNOR_INTERVAL [s]. The filter uses at  */
+/* most GOVERNOR_BUDGET [%] of the block period at full level, between  */
+/* GOVERNOR_MIN_TAPS and FILTER_LENGTH taps in steps of GOVERNOR_STEP.  */
+/* It only grows with a long term ERLE of GOVERNOR_ERLE [dB], so a      */
+/* filter still converging is not disturbed.                            */
+#define GOVERNOR 1
+#define GOVERNOR_INTERVAL 1.0f
+#define GOVERNOR_BUDGET 75
+#define GOVERNOR_MIN_TAPS 256
+#define GOVERNOR_STEP 128
+#define GOVERNOR_ERLE 10.0f
+
+#if GOVERNOR && !LMS_METRICS
+#error "GOVERNOR requires LMS_METRICS (runtime and ERLE)"
+#endif
 
+/* Latency measurement linked in (1), switched on with LatencyMode. */
+/* Needs a cable from output 2 to input 1                           */
+#define LATENCY_MEASURE 1
 
+/* Far end gating (1): once the reference has been silent (Vad.c) for */
+/* longer than the taps of the canceller, its delay line holds only   */
+/* silence, the echo estimate is zero and neither filtering nor       */
+/* adaptation is done, the microphone goes straight to the output.    */
+/* The reference is still put into the delay line, so the filter has  */
+/* the newest samples when the far end starts again                   */
+#define FAR_END_GATING 1
 
-#define FILTER_LENGTH 1700
-#define MU 1
+#if FAR_END_GATING && LMS_HYBRID
+#error "FAR_END_GATING requires the whole echo tail in the FIR (no LMS_HYBRID)"
+#endif
+
+/* Sleep (__WFI()) at the end of IdleFunction() until the next interrupt */
+/* (1), or busy loop (0)                                                 */
+#define IDLE_SLEEP 1
+
+/* One processor slot: canceller of any format, with at most FILTER_LENGTH */
+/* taps in memory from the arena                                           */
+typedef struct CancellerSlot
+{
+	EchoCancellerFormatInstance Canceller;
+	uint32_t *pMemory;
+	float32_t SaveTime;       /* Runtime of the next snapshot [s] */
+	DeadlineMonitor Monitor;  /* Degradation level under overload */
+#if LMS_METRICS
+	volatile uint8_t Snapshot; /* SNAPSHOT_NONE ... SNAPSHOT_READY */
+#endif
+#if GOVERNOR
+	float32_t GovernTime;     /* Next decision [s], < 0 before the first */
+	volatile uint32_t PeakCycles; /* Longest block at full level */
+	struct CancellerSlot *pFrom; /* Canceller replaced, taken over next */
+#endif
+#if FAR_END_GATING
+	VadInstance Vad;          /* Far end activity                 */
+	uint8_t Gated;            /* Last block skipped               */
+#endif
+} CancellerSlot;
+
+extern void FatalError(void);
+
+static void Bypass_init(void *pSlot, uint32_t Param);
+static void Bypass_q15(void *pSlot, q15_t *pSrc, q15_t *pMic, q15_t *pOut,
+		uint32_t blockSize);
+static uint32_t *Canceller_alloc(void);
+static void Canceller_init(void *pSlot, uint32_t Param);
+RAMFUNC static void Canceller_q15(void *pSlot, q15_t *pSrc, q15_t *pMic, q15_t *pOut,
+		uint32_t blockSize);
+static void Canceller_idle(void *pSlot);
+static uint8_t Canceller_load(CancellerSlot *pCanceller);
+#if LMS_METRICS
+static void Canceller_save(CancellerSlot *pCanceller);
+#endif
+#if GOVERNOR
+static void Canceller_govern(CancellerSlot *pCanceller);
+#endif
+
+/* All processors of this image, the switch is done in IdleFunction() */
+const ProcessorEntry Processors[] =
+{
+	{ "Bypass",        Bypass_init,    Bypass_q15,    0,              0               },
+	{ "LMS float32",   Canceller_init, Canceller_q15, Canceller_idle, ECHO_FORMAT_F32 },
+	{ "LMS Q31",       Canceller_init, Canceller_q15, Canceller_idle, ECHO_FORMAT_Q31 },
+	{ "LMS Q15",       Canceller_init, Canceller_q15, Canceller_idle, ECHO_FORMAT_Q15 }
+};
+
+/* Active and next processor */
+CancellerSlot SlotA;
+CancellerSlot SlotB;
+ProcessorRegistryInstance Registry;
 
-q15_t StateQ15[FILTER_LENGTH + BLOCK_SIZE - 1];
-// q16-coefficients for FIR-Filter
-q15_t CoeffsQ15[FILTER_LENGTH];
-q15_t CoeffsQ15_new[FILTER_LENGTH];
+/* Processor wanted, may be written with the debugger at runtime */
+volatile uint16_t ProcessorSelect = PROCESSOR_FIRST;
 
-// Init LMS_q15
-arm_lms_instance_q15 LMS;
+/* Taps of the next canceller built (at most FILTER_LENGTH), may be  */
+/* written with the debugger, takes effect with the next switch      */
+/* (with GOVERNOR it is set by the complexity governor, and at reset */
+/* to the length of the newest snapshot)                             */
+volatile uint16_t FilterLength = FILTER_LENGTH;
+
+/* Memory usage, updated by InitProcessing() */
+ArenaReport MemoryReport;
+
+/* 1 if the last canceller built started from a stored snapshot */
+uint8_t WarmStart;
+
+#if LMS_METRICS
+/* Coefficients of the snapshot being stored, copied in one block so */
+/* that they are all of the same state of the filter                 */
+static uint32_t *pSnapshot;
+#endif
+
+/* Cycles of ProcessBlock() per sample and tap of the active canceller, */
+/* updated by IdleFunction()                                            */
+float32_t CyclesPerTap;
+
+/* Deadline monitor of the active canceller, updated by IdleFunction() */
+DeadlineMonitor DeadlineReport;
+
+#if GOVERNOR
+/* Filter length changes of the complexity governor */
+uint32_t GovernorChanges;
+
+/* Running canceller the next one built takes its state from, only set */
+/* by the governor while it rebuilds the canceller                     */
+static CancellerSlot *pSeed;
+#endif
+
+#if FAR_END_GATING
+/* Far end activity of the active canceller, updated by IdleFunction() */
+VadInstance VadReport;
+#endif
+
+#if LATENCY_MEASURE
+/* Latency measurement: marker on output 2 instead of the error, found */
+/* on input 1. May be switched with the debugger at runtime            */
+volatile uint8_t LatencyMode = 0;
+
+/* Results of the latency measurement, updated by IdleFunction() */
+LatencyReport LatencyMeasured;
+
+static LatencyInstance Latency;
+#endif
+
+#if LMS_METRICS
+/* Results of LMSMetrics, updated by IdleFunction() */
+LMSMetricsReport MetricsReport;
+#endif
 
 #endif
 
@@ -207,10 +374,8 @@ void InitProcessing(void)
 /*                the FIR algorithm for the given block of samples           */
 /*                (For samplewise processing BLOCK_SIZE must be 1)           */
 /*                                                                           */
-/*                Input samples are in unsigned 16-Bit format, Values        */
-/*                ranging from 0 to 65535, to get signed values, 32768       */
-/*                must be subtracted (and added again before placed in       */
-/*                output buffer)                                             */
+/*                Samples are Q15 (IO_Q15), converted from and to the        */
+/*                unsigned ADC/DAC values in place by ProcessBuffer()        */
 /*                                                                           */
 /*                                                                           */
 /*  Type        : Global                                                     */
@@ -229,16 +394,16 @@ void InitProcessing(void)
 /*****************************************************************************/
 
 #if NUMBER_OF_CHANNELS == 2
-void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel2_in, uint16_t *Channel1_out, uint16_t *Channel2_out)
+void ProcessBlock(q15_t *Channel1_in, q15_t *Channel2_in, q15_t *Channel1_out, q15_t *Channel2_out)
 {
 	/* procedure data */
 	int i;
 
 	/* procedure code */
 
-	/* Copy samples into workbuffer and convert to signed */
+	/* Copy samples into workbuffer */
 	for (i = 0; i < BLOCK_SIZE; i++) {
-		InBuffer[i] = ((float32_t)(Channel1_in[i] - 32768));
+		InBuffer[i] = (float32_t) Channel1_in[i];
 	}
 
 	/* Set bit, just for time measurements */
@@ -250,11 +415,11 @@ void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel2_in, uint16_t *Channe
 	/* Reset bit, just for time measurements */
 	GPIO_ResetBits(GPIOD, GPIO_Pin_0);
 
-	/* Copy filtered samples to outputbuffer and convert to unsigned */
+	/* Copy filtered samples to outputbuffer */
 	for (i = 0; i < BLOCK_SIZE; i++) {
 
-		/* Filtered samples on output 1, make unsigned */
-		Channel1_out[i] = OutBuffer[i]+32678;
+		/* Filtered samples on output 1, saturated in the integer unit */
+		Channel1_out[i] = (q15_t) __SSAT((q31_t) OutBuffer[i], 16);
 
 		/* Unfiltered samples on output 2 */
 		Channel2_out[i] = Channel2_in[i];
@@ -262,7 +427,7 @@ void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel2_in, uint16_t *Channe
 
 }
 #else
-void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel1_out)
+void ProcessBlock(q15_t *Channel1_in, q15_t *Channel1_out)
 {
 	int i;
 	for (i = 0; i < BLOCK_SIZE; i++) {
@@ -319,10 +484,8 @@ void InitProcessing(void)
 /*                the FIR algorithm for the given block of samples           */
 /*                (For samplewise processing BLOCK_SIZE must be 1)           */
 /*                                                                           */
-/*                Input samples are in unsigned 16-Bit format, Values        */
-/*                ranging from 0 to 65535, to get signed values, 32768       */
-/*                must be subtracted (and added again before placed in       */
-/*                output buffer)                                             */
+/*                Samples are Q15 (IO_Q15), converted from and to the        */
+/*                unsigned ADC/DAC values in place by ProcessBuffer()        */
 /*                                                                           */
 /*                                                                           */
 /*  Type        : Global                                                     */
@@ -341,16 +504,16 @@ void InitProcessing(void)
 /*****************************************************************************/
 
 #if NUMBER_OF_CHANNELS == 2
-void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel2_in, uint16_t *Channel1_out, uint16_t *Channel2_out)
+void ProcessBlock(q15_t *Channel1_in, q15_t *Channel2_in, q15_t *Channel1_out, q15_t *Channel2_out)
 {
 	/* procedure data */
 	int i;
 
 	/* procedure code */
 
-	/* Copy samples into workbuffer and convert to signed */
+	/* Copy samples into workbuffer */
 	for (i = 0; i < BLOCK_SIZE; i++) {
-		InBufferQ31[i] = ((q31_t)(Channel1_in[i] - 32768))<<16;
+		InBufferQ31[i] = ((q31_t) Channel1_in[i]) << 16;
 	}
 
 	/* Set bit, just for time measurements */
@@ -362,18 +525,18 @@ void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel2_in, uint16_t *Channe
 	/* Reset bit, just for time measurements */
 	GPIO_ResetBits(GPIOD, GPIO_Pin_0);
 
-	/* Copy filtered samples to outputbuffer and convert to unsigned */
+	/* Copy filtered samples to outputbuffer */
 	for (i = 0; i < BLOCK_SIZE; i++) {
 
-		/* Filtered samples on output 1, make unsigned  */
-		Channel1_out[i] = ((OutBufferQ31[i]>>16)+32678);
+		/* Filtered samples on output 1 */
+		Channel1_out[i] = (q15_t) (OutBufferQ31[i] >> 16);
 
 		/* Unfiltered samples on output 2 */
 		Channel2_out[i] = Channel2_in[i];
 	}
 }
 #else
-void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel1_out)
+void ProcessBlock(q15_t *Channel1_in, q15_t *Channel1_out)
 {
 	int i;
 	for (i = 0; i < BLOCK_SIZE; i++) {
@@ -408,9 +571,57 @@ void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel1_out)
 /*****************************************************************************/
 void InitProcessing(void) {
 
+	/* procedure data */
+#if GOVERNOR
+	const CoeffStoreHeader *pRecord;
+#endif
+
 	/* procedure code */
-	arm_lms_init_q15(&LMS, FILTER_LENGTH, CoeffsQ15, StateQ15, MU, BLOCK_SIZE, 0);
+	/* Slot memory, in CCM RAM as long as there is room */
+	Arena_init();
+	SlotA.pMemory = Canceller_alloc();
+	SlotB.pMemory = Canceller_alloc();
+#if LMS_METRICS
+	pSnapshot = (uint32_t *) Arena_alloc(ARENA_CCM,
+			FILTER_LENGTH * sizeof(float32_t), 0);
+	if (pSnapshot == 0) {
+		pSnapshot = (uint32_t *) Arena_alloc(ARENA_SRAM,
+				FILTER_LENGTH * sizeof(float32_t), 0);
+	}
+	if (pSnapshot == 0) {
+		FatalError();
+	}
+#endif
+	Arena_report(&MemoryReport);
+	if ((SlotA.pMemory == 0) || (SlotB.pMemory == 0)) {
+		FatalError();
+	}
+
+	/* Before the DMA runs, may erase a flash sector */
+	CoeffStore_init(FILTER_LENGTH * sizeof(float32_t));
+
+#if GOVERNOR
+	/* The governor may have resized the canceller before the reset, start */
+	/* with the length of the newest snapshot so that it fits              */
+	pRecord = CoeffStore_latest();
+	if ((pRecord != 0) && (pRecord->numTaps >= GOVERNOR_MIN_TAPS) &&
+			(pRecord->numTaps <= FILTER_LENGTH)) {
+		FilterLength = pRecord->numTaps;
+	}
+#endif
+
+	ProcessorRegistry_init(&Registry, Processors,
+			sizeof(Processors) / sizeof(Processors[0]), &SlotA, &SlotB,
+			PROCESSOR_FIRST);
 
+#if LATENCY_MEASURE
+	Latency_init(&Latency, &LatencyMeasured);
+#endif
+
+#if IDLE_SLEEP
+	/* Keep the debugger connected while the core sleeps */
+	DBGMCU_Config(DBGMCU_SLEEP, ENABLE);
+#endif
 }
 /*****************************************************************************/
 /*  End         : InitProcessing                                             */
@@ -425,10 +636,8 @@ void InitProcessing(void) {
 /*                the FIR algorithm for the given block of samples           */
 /*                (For samplewise processing BLOCK_SIZE must be 1)           */
 /*                                                                           */
-/*                Input samples are in unsigned 16-Bit format, Values        */
-/*                ranging from 0 to 65535, to get signed values, 32768       */
-/*                must be subtracted (and added again before placed in       */
-/*                output buffer)                                             */
+/*                Samples are Q15 (IO_Q15), converted from and to the        */
+/*                unsigned ADC/DAC values in place by ProcessBuffer()        */
 /*                                                                           */
 /*                                                                           */
 /*  Type        : Global                                                     */
@@ -447,38 +656,31 @@ void InitProcessing(void) {
 /*****************************************************************************/
 
 #if NUMBER_OF_CHANNELS == 2
-void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel2_in,
-		uint16_t *Channel1_out, uint16_t *Channel2_out) {
+void ProcessBlock(q15_t *Channel1_in, q15_t *Channel2_in,
+		q15_t *Channel1_out, q15_t *Channel2_out) {
 
-	/* procedure data */
-	int i;
-	q15_t y_hat[BLOCK_SIZE];
-	q15_t err[BLOCK_SIZE];
-	/* updating Filter */
-    /* Copy samples into workbuffer and convert to signed */
-//    for (i = 0; i < BLOCK_SIZE; i++) {
-//        xQ15[i] = ((q15_t) (Channel1_in[i] - 32768));
-//        yQ15[i] = ((q15_t) (Channel2_in[i]- 32768));
-//    }
-	/* Channel1 = Desired Signal */
-	arm_lms_q15(&LMS, Channel2_in, Channel1_in, y_hat, err, BLOCK_SIZE);
+	/* procedure code */
+
+	/* Channel2 = Reference, Channel1 = Desired Signal, the error goes */
+	/* straight into the DAC buffer                                    */
+	ProcessorRegistry_q15(&Registry, Channel2_in, Channel1_in, Channel1_out,
+			BLOCK_SIZE);
 
 	/* Reset bit, just for time measurements */
 	GPIO_ResetBits(GPIOD, GPIO_Pin_0 );
 
-	/* Copy filtered samples to outputbuffer and convert to unsigned */
-	for (i = 0; i < BLOCK_SIZE; i++) {
+	/* Error on both outputs */
+	memcpy(Channel2_out, Channel1_out, BLOCK_SIZE * sizeof(q15_t));
 
-		/* Filtered samples on output 1, make unsigned  */
-		Channel1_out[i] = err[i] + 32678;
-		Channel2_out[i] = err[i] + 32678;
-		/* Unfiltered samples on output 2 */
-		//Channel2_out[i] = Channel2_in[i];
+#if LATENCY_MEASURE
+	/* Or the latency marker on output 2, looped back to input 1 */
+	if (LatencyMode) {
+		Latency_q15(&Latency, Channel1_in, Channel2_out, BLOCK_SIZE);
 	}
-
+#endif
 }
 #else
-void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel1_out)
+void ProcessBlock(q15_t *Channel1_in, q15_t *Channel1_out)
 {
 	int i;
 	for (i = 0; i < BLOCK_SIZE; i++) {
@@ -491,6 +693,472 @@ void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel1_out)
 /*  End         : ProcessBlock                                               */
 /*****************************************************************************/
 
+/*****************************************************************************/
+/*  Procedure   : Bypass_init                                                */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Processor without processing, nothing to initialize        */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pSlot      Memory of the processor                         */
+/*                Param      Unused                                          */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Bypass_init(void *pSlot, uint32_t Param) {
+
+	/* procedure code */
+	(void) pSlot;
+	(void) Param;
+}
+/*****************************************************************************/
+/*  End         : Bypass_init                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Bypass_q15                                                 */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Passes the microphone through unchanged                    */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pSlot      Memory of the processor                         */
+/*                pSrc       Far end (reference) samples [blockSize]         */
+/*                pMic       Microphone samples [blockSize]                  */
+/*                blockSize  Number of samples                               */
+/*                                                                           */
+/*  Output Para : pOut       Output samples [blockSize]                      */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Bypass_q15(void *pSlot, q15_t *pSrc, q15_t *pMic, q15_t *pOut,
+		uint32_t blockSize) {
+
+	/* procedure code */
+	(void) pSlot;
+	(void) pSrc;
+	memcpy(pOut, pMic, blockSize * sizeof(q15_t));
+}
+/*****************************************************************************/
+/*  End         : Bypass_q15                                                 */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Canceller_alloc                                            */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Allocates the memory of one canceller slot, CCM RAM        */
+/*                first, SRAM if the CCM RAM is full                         */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : None                                                       */
+/*                                                                           */
+/*  Output Para : Return     Memory, 0 if none left                          */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint32_t *Canceller_alloc(void) {
+
+	/* procedure data */
+	uint32_t Size = ECHO_CANCELLER_FORMAT_MEMORY(FILTER_LENGTH) * sizeof(uint32_t);
+	uint32_t *pMemory;
+
+	/* procedure code */
+	pMemory = (uint32_t *) Arena_alloc(ARENA_CCM, Size, 0);
+	if (pMemory == 0) {
+		pMemory = (uint32_t *) Arena_alloc(ARENA_SRAM, Size, 0);
+	}
+	return pMemory;
+}
+/*****************************************************************************/
+/*  End         : Canceller_alloc                                            */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Canceller_init                                             */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Builds an echo canceller in a CancellerSlot, seeded with   */
+/*                the running canceller when the governor resizes it, else   */
+/*                with the stored snapshot if there is one that fits         */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pSlot      Memory of the processor (CancellerSlot)         */
+/*                Param      Number format (ECHO_FORMAT_xxx)                 */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Canceller_init(void *pSlot, uint32_t Param) {
+
+	/* procedure data */
+	CancellerSlot *pCanceller = (CancellerSlot *) pSlot;
+
+	uint16_t numTaps = FilterLength;
+	uint32_t Cost[DEADLINE_LEVELS];
+	uint16_t Levels;
+
+	/* procedure code */
+	if (numTaps > FILTER_LENGTH) {
+		numTaps = FILTER_LENGTH;
+	}
+	EchoCancellerFormat_init(&pCanceller->Canceller, (uint8_t) Param,
+			numTaps, MU, pCanceller->pMemory);
+
+	/* Budget: core cycles of one block period */
+	Levels = EchoCancellerFormat_costs(&pCanceller->Canceller, Cost);
+	Deadline_init(&pCanceller->Monitor, SystemCoreClock / FS * BLOCK_SIZE,
+			Cost, Levels);
+	pCanceller->SaveTime = WARM_START_FIRST;
+#if LMS_METRICS
+	pCanceller->Snapshot = SNAPSHOT_NONE;
+#endif
+#if FAR_END_GATING
+	Vad_init(&pCanceller->Vad);
+	pCanceller->Gated = 0;
+#endif
+#if GOVERNOR
+	pCanceller->GovernTime = -1.0f;
+	pCanceller->PeakCycles = 0;
+	pCanceller->pFrom = 0;
+	if ((pSeed != 0) && EchoCancellerFormat_transferable(&pCanceller->Canceller,
+			&pSeed->Canceller)) {
+		pCanceller->pFrom = pSeed;
+		return;
+	}
+#endif
+	WarmStart = Canceller_load(pCanceller);
+}
+/*****************************************************************************/
+/*  End         : Canceller_init                                             */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Canceller_q15                                              */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Cancels the echo of one block, at the level the deadline   */
+/*                monitor chooses from the cycles of the last block, or      */
+/*                passes the microphone through while the far end is silent  */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pSlot      Memory of the processor                         */
+/*                pSrc       Far end (reference) samples [blockSize]         */
+/*                pMic       Microphone samples [blockSize]                  */
+/*                blockSize  Number of samples                               */
+/*                                                                           */
+/*  Output Para : pOut       Microphone without echo [blockSize]             */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC static void Canceller_q15(void *pSlot, q15_t *pSrc, q15_t *pMic, q15_t *pOut,
+		uint32_t blockSize) {
+
+	/* procedure data */
+	CancellerSlot *pCanceller = (CancellerSlot *) pSlot;
+#if GOVERNOR
+	DeadlineMonitor *pMonitor = &pCanceller->Monitor;
+	uint32_t Cycles;
+#endif
+	uint8_t Measured = 1;
+#if LMS_METRICS
+	void *pCoeffs;
+	uint32_t Size;
+#endif
+
+	/* procedure code */
+#if GOVERNOR
+	/* First block after a resize: the replaced canceller ran up to the */
+	/* last block and no longer runs, copy its state only now            */
+	if (pCanceller->pFrom != 0) {
+		EchoCancellerFormat_transfer(&pCanceller->Canceller,
+				&pCanceller->pFrom->Canceller);
+		pCanceller->pFrom = 0;
+	}
+#endif
+#if LMS_METRICS
+	/* Snapshot between two blocks, the filter does not adapt meanwhile */
+	if (pCanceller->Snapshot == SNAPSHOT_REQUESTED) {
+		Size = EchoCancellerFormat_coeffs(&pCanceller->Canceller, &pCoeffs);
+		memcpy(pSnapshot, pCoeffs, Size);
+		pCanceller->Snapshot = SNAPSHOT_COPIED;
+	} else if (pCanceller->Snapshot == SNAPSHOT_COPIED) {
+		/* The last block includes the copy */
+		Measured = 0;
+		pCanceller->Snapshot = SNAPSHOT_READY;
+	}
+#endif
+#if FAR_END_GATING
+	/* The cycles of a skipped block say nothing about the load */
+	Measured = Measured && !pCanceller->Gated;
+	pCanceller->Gated = Vad_q15(&pCanceller->Vad, pSrc, blockSize,
+			pCanceller->Canceller.numTaps);
+	if (pCanceller->Gated) {
+		EchoCancellerFormat_skip_q15(&pCanceller->Canceller, pSrc, blockSize);
+		memcpy(pOut, pMic, blockSize * sizeof(q15_t));
+		return;
+	}
+#endif
+#if GOVERNOR
+	/* Last block, run at the level of the monitor, scaled to the full level */
+	Cycles = (uint32_t) ((uint64_t) ProcessCycles * pMonitor->Cost[0] /
+			pMonitor->Cost[pMonitor->Level]);
+	if (Measured && (Cycles > pCanceller->PeakCycles)) {
+		pCanceller->PeakCycles = Cycles;
+	}
+#endif
+	if (Measured) {
+		EchoCancellerFormat_level(&pCanceller->Canceller,
+				Deadline_update(&pCanceller->Monitor, ProcessCycles));
+	}
+	EchoCancellerFormat_q15(&pCanceller->Canceller, pSrc, pMic, pOut,
+			blockSize);
+}
+/*****************************************************************************/
+/*  End         : Canceller_q15                                              */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Canceller_idle                                             */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Background work of the active canceller, update of         */
+/*                CyclesPerTap, DeadlineReport, MetricsReport, VadReport,    */
+/*                snapshots of the converged filter and the complexity       */
+/*                governor                                                   */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pSlot      Memory of the processor (CancellerSlot)         */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Canceller_idle(void *pSlot) {
+
+	/* procedure data */
+	CancellerSlot *pCanceller = (CancellerSlot *) pSlot;
+	uint8_t Measured = 1;
+
+	/* procedure code */
+	EchoCancellerFormat_idle(&pCanceller->Canceller);
+	DeadlineReport = pCanceller->Monitor;
+#if FAR_END_GATING
+	VadReport = pCanceller->Vad;
+
+	/* Not from a skipped block */
+	Measured = !pCanceller->Gated;
+#endif
+	if (Measured) {
+		CyclesPerTap = (float32_t) ProcessCycles /
+				((float32_t) BLOCK_SIZE * pCanceller->Canceller.numTaps);
+	}
+#if LMS_METRICS
+	EchoCancellerFormat_report(&pCanceller->Canceller, &MetricsReport);
+
+	if (pCanceller->Snapshot == SNAPSHOT_READY) {
+		Canceller_save(pCanceller);
+		pCanceller->Snapshot = SNAPSHOT_NONE;
+	} else if ((pCanceller->Snapshot == SNAPSHOT_NONE) &&
+			(MetricsReport.ErleLong >= WARM_START_ERLE) &&
+			(MetricsReport.Runtime >= pCanceller->SaveTime) &&
+			!CoeffStore_busy()) {
+		pCanceller->SaveTime = MetricsReport.Runtime + WARM_START_INTERVAL;
+		pCanceller->Snapshot = SNAPSHOT_REQUESTED;
+	}
+#endif
+#if GOVERNOR
+	/* The first interval starts after the first block, which also copies */
+	/* the state of the replaced canceller                                */
+	if (pCanceller->GovernTime < 0.0f) {
+		pCanceller->PeakCycles = 0;
+		pCanceller->GovernTime = MetricsReport.Runtime + GOVERNOR_INTERVAL;
+	} else if ((MetricsReport.Runtime >= pCanceller->GovernTime) &&
+			!CoeffStore_busy()) {
+		/* Not while a snapshot of this canceller is written */
+		pCanceller->GovernTime = MetricsReport.Runtime + GOVERNOR_INTERVAL;
+		Canceller_govern(pCanceller);
+	}
+#endif
+}
+/*****************************************************************************/
+/*  End         : Canceller_idle                                             */
+/*****************************************************************************/
+
+#if LMS_METRICS
+/*****************************************************************************/
+/*  Procedure   : Canceller_save                                             */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Starts storing the coefficients copied to pSnapshot by     */
+/*                Canceller_q15(), written by CoeffStore_idle()              */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pCanceller Active canceller, MetricsReport up to date      */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Canceller_save(CancellerSlot *pCanceller) {
+
+	/* procedure data */
+	CoeffStoreHeader Info;
+	void *pCoeffs;
+
+	/* procedure code */
+	Info.Size = EchoCancellerFormat_coeffs(&pCanceller->Canceller, &pCoeffs);
+	Info.Format = pCanceller->Canceller.Format;
+	Info.numTaps = pCanceller->Canceller.numTaps;
+	Info.Delay = EchoCancellerFormat_delay(&pCanceller->Canceller);
+	Info.Erle = MetricsReport.ErleLong;
+	CoeffStore_save(&Info, pSnapshot);
+}
+/*****************************************************************************/
+/*  End         : Canceller_save                                             */
+/*****************************************************************************/
+#endif
+
+#if GOVERNOR
+/*****************************************************************************/
+/*  Procedure   : Canceller_govern                                           */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Chooses the largest filter length the budget affords from  */
+/*                the longest block of the last interval, and rebuilds the   */
+/*                canceller with it. The registry swaps to it at a block     */
+/*                boundary without a crossfade, so old and new canceller     */
+/*                never run in the same block and the budget holds. The new  */
+/*                one takes over the coefficients and the delay line then.   */
+/*                                                                           */
+/*                The cycles are taken as proportional to the taps, the      */
+/*                fixed part of the processing is scaled too, so the         */
+/*                estimate errs on the safe side. The deadline monitor       */
+/*                covers the blocks in between.                              */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pCanceller Active canceller, MetricsReport up to date      */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static void Canceller_govern(CancellerSlot *pCanceller) {
+
+	/* procedure data */
+	uint32_t numTaps = pCanceller->Canceller.numTaps;
+	uint32_t Budget = pCanceller->Monitor.Budget / 100u * GOVERNOR_BUDGET;
+	uint32_t Peak = pCanceller->PeakCycles;
+	uint32_t Taps;
+
+	/* procedure code */
+	pCanceller->PeakCycles = 0;
+	if (Peak == 0) {
+		return;
+	}
+
+	/* Affordable taps, in steps and limits */
+	Taps = (uint32_t) ((uint64_t) numTaps * Budget / Peak);
+	if ((Taps >= numTaps) && ((Taps < numTaps + GOVERNOR_STEP) ||
+			(MetricsReport.ErleLong < GOVERNOR_ERLE))) {
+		return;
+	}
+	Taps -= Taps % GOVERNOR_STEP;
+	if (Taps < GOVERNOR_MIN_TAPS) {
+		Taps = GOVERNOR_MIN_TAPS;
+	} else if (Taps > FILTER_LENGTH) {
+		Taps = FILTER_LENGTH;
+	}
+	if (Taps == numTaps) {
+		return;
+	}
+
+	FilterLength = (uint16_t) Taps;
+	pSeed = pCanceller;
+	if (ProcessorRegistry_rebuild(&Registry)) {
+		GovernorChanges++;
+	}
+	pSeed = 0;
+}
+/*****************************************************************************/
+/*  End         : Canceller_govern                                           */
+/*****************************************************************************/
+#endif
+
+/*****************************************************************************/
+/*  Procedure   : Canceller_load                                             */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Copies the stored snapshot into a new canceller, if format */
+/*                and number of taps are the same                            */
+/*                                                                           */
+/*  Type        : Local                                                      */
+/*                                                                           */
+/*  Input Para  : pCanceller Canceller just initialized                      */
+/*                                                                           */
+/*  Output Para : Return     1 if the coefficients were loaded               */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+static uint8_t Canceller_load(CancellerSlot *pCanceller) {
+
+	/* procedure data */
+	const CoeffStoreHeader *pRecord = CoeffStore_latest();
+	void *pCoeffs;
+	uint32_t Size;
+
+	/* procedure code */
+	Size = EchoCancellerFormat_coeffs(&pCanceller->Canceller, &pCoeffs);
+	if ((pRecord == 0) || (pRecord->Format != pCanceller->Canceller.Format) ||
+			(pRecord->numTaps != pCanceller->Canceller.numTaps) ||
+			(pRecord->Size != Size)) {
+		return 0;
+	}
+	memcpy(pCoeffs, (const uint32_t *) pRecord + COEFF_STORE_HEADER_WORDS, Size);
+	return 1;
+}
+/*****************************************************************************/
+/*  End         : Canceller_load                                             */
+/*****************************************************************************/
+
 #else
 
 /* Just an example for Q15 math */
@@ -502,7 +1170,7 @@ void InitProcessing(void) {
 /* Just an example for Q15 math */
 
 #if NUMBER_OF_CHANNELS == 2
-void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel2_in, uint16_t *Channel1_out, uint16_t *Channel2_out)
+void ProcessBlock(q15_t *Channel1_in, q15_t *Channel2_in, q15_t *Channel1_out, q15_t *Channel2_out)
 {
 	int i;
 	q31_t mul1;
@@ -510,16 +1178,16 @@ void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel2_in, uint16_t *Channe
 	for (i = 0; i < BLOCK_SIZE; i++) {
 		//Channel1_out[i] = Channel1_in[i];
 		//Channel2_out[i] = Channel2_in[i];
-		x = Channel1_in[i] - 32768;
+		x = Channel1_in[i];
 		mul1 = (q31_t) ((q15_t) x * (q15_t) x);
 		Channel1_out[i] = (q15_t) __SSAT(mul1 >> 15, 16);
-		x = Channel2_in[i] - 32768;
+		x = Channel2_in[i];
 		mul1 = (q31_t) ((q15_t) x * (q15_t) x);
-		Channel2_out[i] = (q15_t) __SSAT(mul1 >> 15, 16) + 32768;
+		Channel2_out[i] = (q15_t) __SSAT(mul1 >> 15, 16);
 	}
 }
 #else
-void ProcessBlock(uint16_t *Channel1_in, uint16_t *Channel1_out)
+void ProcessBlock(q15_t *Channel1_in, q15_t *Channel1_out)
 {
 	int i;
 	for (i = 0; i < BLOCK_SIZE; i++) {
@@ -554,6 +1222,25 @@ void IdleFunction(void) {
 
 	/* procedure code */
 
+#if defined(MAKEFIR_Q15)
+	/* Switch the processor on request (not while a snapshot of the */
+	/* active one is written), then its background work             */
+	if ((ProcessorSelect != Registry.Current) && !CoeffStore_busy()) {
+		ProcessorRegistry_select(&Registry, ProcessorSelect);
+	}
+	ProcessorRegistry_idle(&Registry);
+	CoeffStore_idle();
+#if LATENCY_MEASURE
+	if (LatencyMode) {
+		Latency_idle(&Latency, &LatencyMeasured);
+	}
+#endif
+#if IDLE_SLEEP
+	/* Nothing left until the next block, the DMA or TIM2 interrupt wakes */
+	/* the core up again                                                  */
+	__WFI();
+#endif
+#endif
 }
 /*****************************************************************************/
 /*  End         : IdleFunction                                               */
@@ -0,0 +1,155 @@
+/* general control */
+
+/*****************************************************************************/
+/*  Module     : Vad                                            Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Voice activity detection of the far end (reference).        */
+/*                                                                           */
+/*               A frame of VAD_FRAME samples is active if its mean          */
+/*               magnitude reaches VAD_LEVEL (voiced speech), or if it       */
+/*               crosses the band +-VAD_LEVEL at least VAD_CROSSINGS times   */
+/*               (quiet fricatives, the idle noise stays inside the band).   */
+/*               A single sample above VAD_ONSET is active at once, and      */
+/*               while gated a single sample above VAD_LEVEL, so an onset    */
+/*               does not wait for the end of the frame.                     */
+/*                                                                           */
+/*               Once the far end has been silent for longer than the echo   */
+/*               tail, the delay line of the canceller holds only silence,   */
+/*               the echo estimate is zero and filtering as well as          */
+/*               adaptation can be skipped. No multiplications, only a       */
+/*               few compares per sample.                                    */
+/*                                                                           */
+/*  Procedures : Vad_init()                                                  */
+/*               Vad_q15()                                                   */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : Vad.c                                                       */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "Vad.h"
+#include <string.h>
+
+/* module constant declaration */
+
+/* module type declaration */
+
+/* module data declaration */
+
+/* module procedure declaration */
+
+/*****************************************************************************/
+/*  Procedure   : Vad_init                                                   */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Initializes a detector, the far end counts as active       */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance to initialize                          */
+/*                                                                           */
+/*  Output Para : None                                                       */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+void Vad_init(VadInstance *S) {
+
+	/* procedure code */
+	memset(S, 0, sizeof(*S));
+}
+/*****************************************************************************/
+/*  End         : Vad_init                                                   */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  Procedure   : Vad_q15                                                    */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function    : Checks one block of the far end                            */
+/*                                                                           */
+/*  Type        : Global                                                     */
+/*                                                                           */
+/*  Input Para  : S          Instance                                        */
+/*                pSrc       Far end (reference) samples [blockSize]         */
+/*                blockSize  Number of samples                               */
+/*                Tail       Length of the echo tail [samples]               */
+/*                                                                           */
+/*  Output Para : Return     1 if the far end has been silent for longer     */
+/*                           than Tail, this block included                  */
+/*                                                                           */
+/*  Author      : agent                                                      */
+/*                                                                           */
+/*  History     : 19.10.2026  AG  Created                                    */
+/*                                                                           */
+/*****************************************************************************/
+RAMFUNC uint8_t Vad_q15(VadInstance *S, q15_t *pSrc, uint32_t blockSize,
+		uint32_t Tail) {
+
+	/* procedure data */
+	int32_t Sample;
+	uint32_t i;
+
+	/* procedure code */
+	S->Blocks++;
+	for (i = 0; i < blockSize; i++) {
+		Sample = pSrc[i];
+		if (Sample > VAD_LEVEL) {
+			if (S->Side < 0) {
+				S->Crossings++;
+			}
+			S->Side = 1;
+		} else if (Sample < -VAD_LEVEL) {
+			if (S->Side > 0) {
+				S->Crossings++;
+			}
+			S->Side = -1;
+		}
+		if (Sample < 0) {
+			Sample = -Sample;
+		}
+		if ((Sample > VAD_ONSET) ||
+				((Sample > VAD_LEVEL) && (S->Silence > Tail))) {
+			S->Active = 1;
+			S->Silence = 0;
+		}
+		S->Sum += (uint32_t) Sample;
+
+		/* Decision at the end of the frame */
+		if (++S->Count >= VAD_FRAME) {
+			if (S->Active || (S->Sum >= VAD_LEVEL * VAD_FRAME) ||
+					(S->Crossings >= VAD_CROSSINGS)) {
+				S->Silence = 0;
+			} else if (S->Silence <= Tail) {
+				S->Silence += VAD_FRAME;
+			}
+			S->Sum = 0;
+			S->Count = 0;
+			S->Crossings = 0;
+			S->Active = 0;
+		}
+	}
+
+	if (S->Silence > Tail) {
+		S->Gated++;
+		return 1;
+	}
+	return 0;
+}
+/*****************************************************************************/
+/*  End         : Vad_q15                                                    */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/*  End Module  : Vad                                                        */
+/*****************************************************************************/
@@ -0,0 +1,76 @@
+#ifndef VAD_H
+#define VAD_H
+/*****************************************************************************/
+/*  Header     : Vad                                            Version 1.0  */
+/*****************************************************************************/
+/*                                                                           */
+/*  Function   : Voice activity detection of the far end (reference) from    */
+/*               level and zero crossings, decides when filtering and        */
+/*               adaptation can be skipped                                   */
+/*                                                                           */
+/*  Procedures : Vad_init()                                                  */
+/*               Vad_q15()                                                   */
+/*                                                                           */
+/*  Author     : agent                                                       */
+/*                                                                           */
+/*  History    : 19.10.2026  AG Created                                      */
+/*                                                                           */
+/*  File       : Vad.h                                                       */
+/*                                                                           */
+/*****************************************************************************/
+/*  Berner Fachhochschule   *      Fachbereich EKT                           */
+/*  TI Burgdorf             *      Digitale Signalverarbeitung               */
+/*****************************************************************************/
+
+/* imports */
+#include "config.h"
+#include "arm_math.h"
+
+/* module constant declaration  */
+
+/* Samples of one decision (8ms at 8kHz) */
+#define VAD_FRAME 64
+
+/* Mean magnitude of an active frame (Q15, -54dBFS, about 4 LSB of the */
+/* 12 bit ADC). Must be above the idle noise of the reference input    */
+#define VAD_LEVEL 64
+
+/* Crossings of the band +-VAD_LEVEL in a frame that make a quiet frame */
+/* active as well (fricatives)                                          */
+#define VAD_CROSSINGS 8
+
+/* A single sample above this magnitude (Q15, -30dBFS) ends the silence */
+/* at once, without waiting for the end of the frame (while gated any   */
+/* sample above VAD_LEVEL does)                                         */
+#define VAD_ONSET 1024
+
+#if VAD_ONSET <= VAD_LEVEL
+#error "VAD_ONSET must be above VAD_LEVEL"
+#endif
+
+/* module type declaration      */
+
+/* Instance, also the report (watch it with the debugger) */
+typedef struct
+{
+	uint32_t Sum;              /* Magnitudes of the running frame         */
+	uint16_t Count;            /* Samples of the running frame            */
+	uint16_t Crossings;        /* Band crossings of the running frame     */
+	int8_t Side;               /* Last side outside the band (+1, -1, 0)  */
+	uint8_t Active;            /* Onset in the running frame              */
+	uint32_t Silence;          /* Samples since the last active frame     */
+	uint32_t Blocks;           /* Blocks checked                          */
+	uint32_t Gated;            /* Blocks with the far end silent          */
+} VadInstance;
+
+/* module data declaration      */
+
+/* module procedure declaration */
+void Vad_init(VadInstance *S);
+RAMFUNC uint8_t Vad_q15(VadInstance *S, q15_t *pSrc, uint32_t blockSize,
+		uint32_t Tail);
+
+/*****************************************************************************/
+/*  End Header  : Vad                                                        */
+/*****************************************************************************/
+#endif
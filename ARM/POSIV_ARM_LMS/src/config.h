@@ -40,6 +40,49 @@
 /* System clock, normally 84000000 */
 #define SYSCLK 84000000
 
+/* Samples of ProcessBlock(): signed Q15 (1) or the raw unsigned ADC/DAC */
+/* values (0, for the FIR and FFT demos). ADCs and DACs are left aligned */
+/* (12 bit in the upper bits), so Q15 only needs the sign bit flipped,   */
+/* done in place by ProcessBuffer()                                      */
+#define IO_Q15 1
+
+/* DMA buffering: one circular buffer of 2 * BLOCK_SIZE per channel,   */
+/* processed at half and full transfer (1), or double buffer mode with */
+/* two buffers of BLOCK_SIZE (0). Latency is 2 * BLOCK_SIZE samples in */
+/* both modes (Host/LatencySim.c -half 1: 32 samples at 16)            */
+#define DMA_HALF_BUFFER 0
+
+/* Execution of ProcessBlock(): deferred to PendSV at the lowest        */
+/* priority (1), so the DMA interrupts only select the buffers and stay */
+/* short, or directly in the DMA interrupt (0)                          */
+#define PROCESS_DEFERRED 1
+
+/* Hot kernels and the processing path (marked RAMFUNC) executed from */
+/* SRAM (1) or from flash (0). They are copied with .data at startup  */
+/* (.ramfunc in stm32f4_flash.ld, where the used CMSIS kernels are    */
+/* placed by file). With 0 the linker script of the project has to be */
+/* stm32f4_flash_rom.ld, which keeps all code in flash. CCM RAM is    */
+/* not connected to the instruction bus                               */
+#define RAM_FUNCTIONS 1
+
+/* Flash accelerator: prefetch on (1) in addition to the instruction */
+/* and data cache, or caches only (0)                                */
+#define FLASH_PREFETCH 1
+
+/* FPU context on exception entry: lazy stacking (1, the reset value),  */
+/* the registers are only saved when the handler executes its first FP  */
+/* instruction, or saved on every entry (0, for comparison). The DMA    */
+/* handlers are integer only, so with lazy stacking only the processing */
+/* pays for it                                                          */
+#define FPU_LAZY_STACKING 1
+
+#if RAM_FUNCTIONS && defined(__arm__)
+/* Function in SRAM, called with a long branch from flash */
+#define RAMFUNC __attribute__((section(".ramfunc"), long_call))
+#else
+#define RAMFUNC
+#endif
+
 
 /* module type declaration      */
 
@@ -39,9 +39,19 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+
+#if DMA_HALF_BUFFER
+/* A block is done at half and at full transfer */
+#define BLOCK_DONE(Stream, TC, HT) \
+	((DMA_GetITStatus(Stream, TC) == SET) || (DMA_GetITStatus(Stream, HT) == SET))
+#else
+/* A block is done at full transfer */
+#define BLOCK_DONE(Stream, TC, HT) (DMA_GetITStatus(Stream, TC) == SET)
+#endif
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
+extern RAMFUNC void ProcessDeferred(void);
 /* Private functions ---------------------------------------------------------*/
 
 /******************************************************************************/
@@ -132,8 +142,11 @@ void DebugMon_Handler(void)
   * @param  None
   * @retval None
   */
-void PendSV_Handler(void)
+RAMFUNC void PendSV_Handler(void)
 {
+#if PROCESS_DEFERRED
+  ProcessDeferred();
+#endif
 }
 
 /**
@@ -206,7 +219,7 @@ volatile int TransferCompleteADC2 = 0;
 volatile int TransferCompleteDAC1 = 0;
 volatile int TransferCompleteDAC2 = 0;
 
-extern void ProcessBuffer(void);
+extern RAMFUNC void ProcessBuffer(void);
 
 
 
@@ -218,14 +231,17 @@ void DMA1_Stream5_IRQHandler(void)
 
 	//GPIO_ResetBits(GPIOD, GPIO_Pin_6);
 
-    /* Check for Transfer complete interrupt */
-	if (DMA_GetITStatus(DMA1_Stream5, DMA_IT_TCIF5) == SET ){
+    /* Check for Transfer complete (or half transfer) interrupt */
+	if (BLOCK_DONE(DMA1_Stream5, DMA_IT_TCIF5, DMA_IT_HTIF5)) {
 
 	   /* Signal interrupt (for time measurement) */
        GPIO_ToggleBits(GPIOD, GPIO_Pin_6);
 
        /* Clear interrupt pending flag */
        DMA_ClearITPendingBit(DMA1_Stream5, DMA_IT_TCIF5);
+#if DMA_HALF_BUFFER
+       DMA_ClearITPendingBit(DMA1_Stream5, DMA_IT_HTIF5);
+#endif
 
        /* Mark buffer 1 as ready */
        TransferCompleteDAC1 = 1;
@@ -273,14 +289,17 @@ void DMA1_Stream6_IRQHandler(void)
     /* procedure code */
 
 	//GPIO_ResetBits(GPIOD, GPIO_Pin_7);
-    /* Check for Transfer complete interrupt */
-	if (DMA_GetITStatus(DMA1_Stream6, DMA_IT_TCIF6) == SET ){
+    /* Check for Transfer complete (or half transfer) interrupt */
+	if (BLOCK_DONE(DMA1_Stream6, DMA_IT_TCIF6, DMA_IT_HTIF6)) {
 
 	   /* Signal interrupt (for time measurement) */
    	   GPIO_ToggleBits(GPIOD, GPIO_Pin_7);
 
        /* Clear interrupt pending flag */
        DMA_ClearITPendingBit(DMA1_Stream6, DMA_IT_TCIF6);
+#if DMA_HALF_BUFFER
+       DMA_ClearITPendingBit(DMA1_Stream6, DMA_IT_HTIF6);
+#endif
 
        /* Mark buffer 2 as ready */
        TransferCompleteDAC2 = 1;
@@ -324,14 +343,17 @@ void DMA2_Stream0_IRQHandler(void)
     /* procedure code */
 
 	//GPIO_ResetBits(GPIOD, GPIO_Pin_8);
-    /* Check for Transfer complete interrupt */
-	if (DMA_GetITStatus(DMA2_Stream0, DMA_IT_TCIF0) == SET ){
+    /* Check for Transfer complete (or half transfer) interrupt */
+	if (BLOCK_DONE(DMA2_Stream0, DMA_IT_TCIF0, DMA_IT_HTIF0)) {
 
 	   /* Signal interrupt (for time measurement) */
        GPIO_ToggleBits(GPIOD, GPIO_Pin_8);
 
        /* Clear interrupt pending flag */
        DMA_ClearITPendingBit(DMA2_Stream0, DMA_IT_TCIF0);
+#if DMA_HALF_BUFFER
+       DMA_ClearITPendingBit(DMA2_Stream0, DMA_IT_HTIF0);
+#endif
 
        /* Mark buffer 3 as ready */
        TransferCompleteADC1 = 1;
@@ -379,14 +401,17 @@ void DMA2_Stream2_IRQHandler(void)
     /* procedure code */
 
 	//GPIO_ResetBits(GPIOD, GPIO_Pin_9);
-    /* Check for Transfer complete interrupt */
-	if (DMA_GetITStatus(DMA2_Stream2, DMA_IT_TCIF2) == SET ){
+    /* Check for Transfer complete (or half transfer) interrupt */
+	if (BLOCK_DONE(DMA2_Stream2, DMA_IT_TCIF2, DMA_IT_HTIF2)) {
 
 	   /* Signal interrupt (for time measurement) */
        GPIO_ToggleBits(GPIOD, GPIO_Pin_9);
 
        /* Clear interrupt pending flag */
        DMA_ClearITPendingBit(DMA2_Stream2, DMA_IT_TCIF2);
+#if DMA_HALF_BUFFER
+       DMA_ClearITPendingBit(DMA2_Stream2, DMA_IT_HTIF2);
+#endif
 
        /* Mark buffer 4 as ready */
        TransferCompleteADC2 = 1;
@@ -0,0 +1,56 @@
+%% ECHO Cancellation Project: LMS vs. sign-error vs. sign-sign LMS
+% Compares the ERLE of the three update rules (as implemented in
+% arm_lms_q15 and LMSSign.c) on the recorded scenarios, in floating point.
+% The Q15 arithmetic of the kernels (flooring shifts, saturation) and their
+% run time are compared by ARM/POSIV_ARM_LMS/Host/SignBench.c
+clear all
+close all;
+% Parameter
+fs = 8000;          % Sampling frequency (as config.h)
+NFIR = 1700;        % Filterlenght (as FILTER_LENGTH)
+u = 2^-12;          % Step for LMS and sign-error (LMS_MU_SHIFT = 12)
+delta = 2^-15;      % Step for sign-sign (LMS_DELTA = 1)
+
+files = {'Lorem_ipsum_delay_3500.wav', 'Lorem_ipsum_verb_3500.wav'};
+rules = {'LMS', 'sign-error', 'sign-sign'};
+
+for f = 1:length(files)
+    % Load Signals, reference x and microphone y (reference + echo)
+    [sound, fswav, nbit]= wavread('Lorem_ipsum_3500.wav');
+    x = sound(round(1:fswav/fs:end));  % Undersampling
+    [sound, fswav, nbit]= wavread(files{f});
+    y = sound(round(1:fswav/fs:end));  % Undersampling
+    clearvars sound;
+    x = x(1:min(length(x), length(y)));
+    y = y(1:length(x));
+
+    figure;
+    for r = 1:length(rules)
+        w = zeros(NFIR, 1);
+        err = zeros(size(x));
+        for k = NFIR:length(x);
+            xk = x(k:-1:k-NFIR+1);
+            err(k) = y(k) - w'*xk;
+            switch r
+                case 1
+                    w = w + u*xk*err(k);
+                case 2
+                    w = w + u*xk*sign(err(k));
+                case 3
+                    w = w + delta*sign(xk)*sign(err(k));
+            end
+        end
+        % Same metrics as on the board (LMSMetrics.c)
+        [d, name] = fileparts(files{f});
+        m = lms_metrics(x, y, err, fs, [name, '_', rules{r}, '.csv']);
+        plot((0:length(err)-1)/fs, m.erle_long, 'linewidth', 2);
+        hold all;
+        fprintf('%s, %s: final ERLE %.1f dB, 20 dB after %.2f s\n', ...
+                files{f}, rules{r}, m.final_erle, m.convergence_time);
+    end
+    title(['ERLE ', files{f}], 'Interpreter', 'none');
+    legend(rules);
+    xlabel('Time [s]');
+    ylabel('ERLE [dB]');
+    grid on
+end
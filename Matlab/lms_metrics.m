@@ -0,0 +1,65 @@
+function m = lms_metrics(x, y, err, fs, csvfile)
+%% ECHO Cancellation Project: online metrics (as LMSMetrics.c)
+% m = lms_metrics(x, y, err, fs) computes the same short/long term power
+% estimates, ERLE, echo path change events and convergence time as
+% LMSMetrics.c on the board, for reference x, microphone y and error err
+% (all scaled to +-1).
+% lms_metrics(..., csvfile) additionally writes the per sample ERLE to
+% csvfile (time, short term ERLE, long term ERLE, path change) and the
+% summary to csvfile with '_summary' appended.
+
+% Parameter (as LMSMetrics.h)
+short = 2^-7;       % LMS_METRICS_SHORT_SHIFT
+long = 2^-12;       % LMS_METRICS_LONG_SHIFT
+active = 1e-5;      % LMS_METRICS_ACTIVE (-50dBFS)
+target = 100;       % LMS_METRICS_TARGET (20dB)
+rise = 4;           % LMS_METRICS_CHANGE_RISE
+
+N = length(x);
+p = zeros(6, 1);    % ref short/long, mic short/long, err short/long
+erle = zeros(N, 2);
+change = zeros(N, 1);
+activecount = 0;
+convergence = 0;
+changes = 0;
+changing = 0;
+
+for k = 1:N
+    p(1:2) = p(1:2) + [short; long] .* (x(k)^2 - p(1:2));
+    if p(2) >= active
+        p(3:4) = p(3:4) + [short; long] .* (y(k)^2 - p(3:4));
+        p(5:6) = p(5:6) + [short; long] .* (err(k)^2 - p(5:6));
+        activecount = activecount + 1;
+        if convergence == 0 && p(4) / target > p(6)
+            convergence = activecount;
+        end
+        c = p(5) / rise > p(6) && p(3) / rise <= p(4);
+        if c && ~changing && convergence ~= 0
+            changes = changes + 1;
+            change(k) = 1;
+            activecount = 0;
+            convergence = 0;
+            p(6) = p(4);    % restart long term error at 0 dB ERLE
+        end
+        changing = c;
+    end
+    erle(k, :) = 10*log10([p(3) p(4)] ./ ([p(5) p(6)] + eps) + eps);
+end
+
+m.erle_short = erle(:, 1);
+m.erle_long = erle(:, 2);
+m.path_changes = changes;
+m.convergence_time = convergence / fs;
+if convergence == 0
+    m.convergence_time = -1;
+end
+m.final_erle = erle(end, 2);
+
+if nargin > 4
+    csvwrite(csvfile, [(0:N-1)'/fs, erle, change]);
+    [d, name, ext] = fileparts(csvfile);
+    f = fopen(fullfile(d, [name, '_summary', ext]), 'w');
+    fprintf(f, 'final_erle_db,convergence_time_s,path_changes\n');
+    fprintf(f, '%.2f,%.4f,%d\n', m.final_erle, m.convergence_time, changes);
+    fclose(f);
+end